@@ -0,0 +1,9 @@
+// Per-frame camera data, uploaded once per frame by the renderer (FrameData in FrameData.h)
+layout(std140, binding = 0) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    vec3 viewPos;
+    float time;
+    vec3 uAmbientLight;
+};
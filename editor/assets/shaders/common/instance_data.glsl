@@ -0,0 +1,13 @@
+// Per-draw data for batched draws (GPUInstanceData in FrameData.h).
+// The geometry arena sources aInstanceIndex from an identity buffer with divisor 1, so with the
+// indirect command's baseInstance it equals baseInstance + gl_InstanceID: the record of this draw.
+struct InstanceRecord {
+    mat4 model;
+    uint objectID;
+};
+
+layout(std430, binding = 2) readonly buffer InstanceData {
+    InstanceRecord instances[];
+};
+
+layout(location = 6) in uint aInstanceIndex;
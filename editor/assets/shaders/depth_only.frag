@@ -0,0 +1,5 @@
+#version 430 core
+
+// Depth pre-pass: paired with a material's vertex shader, only the depth buffer is written
+void main() {
+}
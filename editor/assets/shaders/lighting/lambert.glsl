@@ -23,9 +23,10 @@ vec3 calculateLambertLighting(vec3 normal, vec3 baseColor, vec3 fragPos) {
         result += calcDirectionalLight(directionalLights[i], normal, baseColor);
     }
 
-    // Add point lights
-    for (int i = 0; i < min(numPointLights, MAX_POINT_LIGHTS); i++) {
-        result += calcPointLight(pointLights[i], normal, fragPos, baseColor);
+    // Add the point lights that reach this fragment's cluster
+    LightCluster cluster = getLightCluster(gl_FragCoord.xy, -(view * vec4(fragPos, 1.0)).z);
+    for (uint i = 0u; i < cluster.count; i++) {
+        result += calcPointLight(pointLights[lightIndices[cluster.offset + i]], normal, fragPos, baseColor);
     }
 
     return result;
@@ -0,0 +1,23 @@
+#version 430 core
+
+// Resolves the weighted blended transparency targets over the opaque image,
+// blended with (GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA)
+layout(binding=0) uniform sampler2D uAccumulation;
+layout(binding=1) uniform sampler2D uRevealage;
+
+layout(location=0) out vec4 fragColor;
+
+void main() {
+    ivec2 texel = ivec2(gl_FragCoord.xy);
+    float revealage = texelFetch(uRevealage, texel, 0).r;
+    if (revealage >= 1.0) discard; // No transparent surface covers this pixel
+
+    vec4 accumulation = texelFetch(uAccumulation, texel, 0);
+    // Sums that overflowed the half floats would turn into NaN below
+    if (isinf(max(max(abs(accumulation.r), abs(accumulation.g)), abs(accumulation.b)))) {
+        accumulation.rgb = vec3(accumulation.a);
+    }
+
+    vec3 average_color = accumulation.rgb / max(accumulation.a, 1e-5);
+    fragColor = vec4(average_color, 1.0 - revealage);
+}
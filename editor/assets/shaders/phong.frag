@@ -1,19 +1,40 @@
 #version 430 core
 
+#include "common/frame_data.glsl"
 #include "common/vertex_inputs.glsl"
 #include "common/material_uniforms.glsl"
 #include "common/light_uniforms.glsl"
 #include "common/texture_utils.glsl"
 #include "lighting/blinn_phong.glsl"
 
+#ifdef OIT
+#include "common/oit_output.glsl"
+#else
 layout(location=0) out vec4 fragColor;
+#endif
 layout(location=1) out uint objectID;
 
+#ifdef INSTANCED
+flat in uint vObjectID; // Written per instance by standard.vert
+#else
 uniform uint uObjectID;
-uniform float uShadowBias;
+#endif
 
 float calculate_shadow(int light_index, vec3 frag_pos, vec3 normal, vec3 light_dir) {
-    vec4 frag_pos_light_space = uLightSpaceMatrix[light_index] * vec4(frag_pos, 1.0);
+    // Pick the first cascade whose slice contains the fragment
+    float view_depth = -(view * vec4(frag_pos, 1.0)).z;
+    if (uNumCascades == 0 || view_depth >= uCascadeSplits[uNumCascades - 1]) return 0.0;
+
+    int cascade = 0;
+    while (cascade < uNumCascades - 1 && view_depth >= uCascadeSplits[cascade]) {
+        cascade++;
+    }
+
+    int shadow_index = light_index * MAX_SHADOW_CASCADES + cascade;
+    vec4 tile = uShadowTiles[shadow_index];
+    if (tile.z == 0.0) return 0.0; // No room in the atlas for this light
+
+    vec4 frag_pos_light_space = uShadowMatrices[shadow_index] * vec4(frag_pos, 1.0);
     vec3 proj_coords = frag_pos_light_space.xyz / frag_pos_light_space.w;
     // project coords into a [0, 1] space
     proj_coords = proj_coords * 0.5 + 0.5;
@@ -22,13 +43,18 @@ float calculate_shadow(int light_index, vec3 frag_pos, vec3 normal, vec3 light_d
 
     float current_depth = proj_coords.z;
 
+    // Map into the cascade's tile, PCF taps must not bleed into the neighbouring tiles
+    vec2 texel_size = 1.0 / textureSize(uShadowAtlas, 0);
+    vec2 tile_min = tile.xy + texel_size * 0.5;
+    vec2 tile_max = tile.xy + tile.zw - texel_size * 0.5;
+    vec2 tile_coords = tile.xy + proj_coords.xy * tile.zw;
+
     // PCF: sample a 3x3 area
     float shadow = 0.0;
-    vec2 texel_size = 1.0 / textureSize(uShadowMap[light_index], 0);
-
     for (int x = -1; x <= 1; ++x) {
         for (int y = -1; y <= 1; ++y) {
-            float pcf_depth = texture(uShadowMap[light_index], proj_coords.xy + vec2(x, y) * texel_size).r;
+            vec2 sample_coords = clamp(tile_coords + vec2(x, y) * texel_size, tile_min, tile_max);
+            float pcf_depth = texture(uShadowAtlas, sample_coords).r;
             shadow += current_depth - uShadowBias > pcf_depth ? 1.0 : 0.0;
         }
     }
@@ -52,6 +78,14 @@ void main() {
 
     vec3 result = ambient + direct * (1.0 - shadow_factor);
 
+#ifdef OIT
+    writeOITOutput(result, uOpacity);
+#else
     fragColor = vec4(result, uOpacity);
+#endif
+#ifdef INSTANCED
+    objectID = vObjectID;
+#else
     objectID = uObjectID;
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,10 @@
+#version 430 core
+
+// Full screen triangle made from gl_VertexID, drawn without vertex buffers
+out vec2 vUV;
+
+void main() {
+    vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    vUV = position;
+    gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+}
@@ -10,6 +10,7 @@
 #include "ImGuizmo.h"
 #include "../ui/Panels/EditorPanel.h"
 #include "hellfire/core/Application.h"
+#include "hellfire/graphics/renderer/Renderer.h"
 #include "hellfire/platform/IWindow.h"
 #include "hellfire/utilities/ServiceLocator.h"
 #include "hellfire/platform/windows_linux/GLFWWindow.h"
@@ -162,7 +163,10 @@ namespace hellfire::editor {
         if (!imgui_initialized_) return;
 
         ImGui::Render();
+        auto *renderer = ServiceLocator::get_service<Renderer>();
+        if (renderer) renderer->get_gpu_timer().begin("Editor UI");
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        if (renderer) renderer->get_gpu_timer().end();
 
         // Handle multi-viewport
         if (const ImGuiIO &io = ImGui::GetIO(); io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) {
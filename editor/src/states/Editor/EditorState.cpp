@@ -10,6 +10,7 @@
 #include "ui/Panels/AssetExplorer/AssetExplorer.h"
 #include "ui/Panels/Inspector/InspectorPanel.h"
 #include "ui/Panels/MenuBar/MenuBarComponent.h"
+#include "ui/Panels/Profiler/ProfilerPanel.h"
 #include "ui/Panels/SceneHierarchy/SceneHierarchyPanel.h"
 #include "ui/Panels/Settings/Renderer/RendererSettingsPanel.h"
 #include "ui/Panels/Viewport/SceneCameraScript.h"
@@ -25,6 +26,7 @@ namespace hellfire::editor {
         panel_manager_.add_panel<SceneHierarchyPanel>();
         panel_manager_.add_panel<InspectorPanel>();
         panel_manager_.add_panel<RendererSettingsPanel>();
+        panel_manager_.add_panel<ProfilerPanel>();
         panel_manager_.add_panel<AssetExplorer>();
         viewport_panel_ = panel_manager_.add_panel<ViewportPanel>();
         
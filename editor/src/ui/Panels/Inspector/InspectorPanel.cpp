@@ -155,6 +155,11 @@ namespace hellfire::editor {
         }
 
         ImGui::Indent();
+        int occluder_mode = static_cast<int>(renderable->occluder_mode);
+        if (ui::combo_box_int("Occluder", "Auto\0" "Always\0" "Never\0", &occluder_mode)) {
+            renderable->occluder_mode = static_cast<RenderableComponent::OccluderMode>(occluder_mode);
+        }
+
         std::shared_ptr<Material> material = renderable->get_material();
         // TODO: When serialization is implemented, handle this with being able to load materials from files
         if (!material) {
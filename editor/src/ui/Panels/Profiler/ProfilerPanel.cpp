@@ -0,0 +1,122 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include "ProfilerPanel.h"
+
+#include <algorithm>
+#include <string_view>
+
+#include "imgui.h"
+#include "hellfire/utilities/FileDialog.h"
+#include "ui/ui.h"
+
+namespace hellfire::editor {
+    namespace {
+        constexpr uint64_t CAPTURE_WINDOW_NS = 1000000000; // The flame view only needs the last frame or so
+
+        ImU32 get_scope_color(const char *name) {
+            const size_t hash = std::hash<std::string_view>{}(name);
+            return ImColor::HSV(static_cast<float>(hash % 360) / 360.0f, 0.45f, 0.75f);
+        }
+    }
+
+    void ProfilerPanel::render() {
+        if (ui::Window window{"Profiler"}) {
+#ifndef HELLFIRE_PROFILING
+            ImGui::TextDisabled("Scopes are compiled out, configure with -DHELLFIRE_PROFILING=ON to record them");
+#endif
+            bool recording = Profiler::is_enabled();
+            if (ui::bool_input("Record", &recording)) {
+                Profiler::set_enabled(recording);
+            }
+            ui::bool_input("Pause View", &paused_);
+            if (ImGui::Button("Export Chrome Trace...")) {
+                export_chrome_trace();
+            }
+
+            if (!paused_) {
+                const uint64_t now = Profiler::now_ns();
+                capture_ = Profiler::capture(now > CAPTURE_WINDOW_NS ? now - CAPTURE_WINDOW_NS : 0);
+            }
+            if (capture_.frames.empty()) {
+                ImGui::TextDisabled("No frames recorded");
+                return;
+            }
+
+            const ProfileFrame &frame = capture_.frames.back();
+            ImGui::SeparatorText("Last Frame");
+            ImGui::Text("Frame %llu: %.2f ms", static_cast<unsigned long long>(frame.index),
+                        static_cast<double>(frame.end_ns - frame.start_ns) / 1.0e6);
+            draw_flame_view(frame);
+        }
+    }
+
+    void ProfilerPanel::draw_flame_view(const ProfileFrame &frame) const {
+        const double frame_duration = static_cast<double>(std::max<uint64_t>(frame.end_ns - frame.start_ns, 1));
+        const float row_height = ImGui::GetTextLineHeightWithSpacing();
+        ImDrawList *draw_list = ImGui::GetWindowDrawList();
+
+        // Events are grouped per thread, each thread gets a lane as deep as its deepest scope
+        size_t lane_begin = 0;
+        while (lane_begin < capture_.events.size()) {
+            const uint32_t thread = capture_.events[lane_begin].thread;
+            size_t lane_end = lane_begin;
+            uint32_t max_depth = 0;
+            bool visible = false;
+            for (; lane_end < capture_.events.size() && capture_.events[lane_end].thread == thread; lane_end++) {
+                const ProfileEvent &event = capture_.events[lane_end];
+                if (event.end_ns < frame.start_ns || event.start_ns > frame.end_ns) continue;
+                max_depth = std::max(max_depth, event.depth);
+                visible = true;
+            }
+            if (!visible) {
+                lane_begin = lane_end;
+                continue;
+            }
+
+            ImGui::TextUnformatted(thread < capture_.thread_names.size() ? capture_.thread_names[thread].c_str() : "?");
+            const ImVec2 origin = ImGui::GetCursorScreenPos();
+            const float width = std::max(ImGui::GetContentRegionAvail().x, 1.0f);
+            const float lane_height = static_cast<float>(max_depth + 1) * row_height;
+            draw_list->PushClipRect(origin, ImVec2(origin.x + width, origin.y + lane_height), true);
+
+            for (size_t i = lane_begin; i < lane_end; i++) {
+                const ProfileEvent &event = capture_.events[i];
+                if (event.end_ns < frame.start_ns || event.start_ns > frame.end_ns) continue;
+
+                // Scopes crossing the frame boundary (worker threads) are cut at the edges
+                const uint64_t start = std::max(event.start_ns, frame.start_ns);
+                const uint64_t end = std::min(event.end_ns, frame.end_ns);
+                const ImVec2 min(origin.x + static_cast<float>(static_cast<double>(start - frame.start_ns) /
+                                                               frame_duration * width),
+                                 origin.y + static_cast<float>(event.depth) * row_height);
+                const ImVec2 max(std::max(origin.x + static_cast<float>(static_cast<double>(end - frame.start_ns) /
+                                                                        frame_duration * width), min.x + 1.0f),
+                                 min.y + row_height - 1.0f);
+
+                draw_list->AddRectFilled(min, max, get_scope_color(event.name));
+                if (max.x - min.x > ImGui::CalcTextSize(event.name).x + 4.0f) {
+                    draw_list->AddText(ImVec2(min.x + 2.0f, min.y), IM_COL32(20, 20, 20, 255), event.name);
+                }
+                if (ImGui::IsMouseHoveringRect(min, max)) {
+                    ImGui::SetTooltip("%s\n%.3f ms", event.name,
+                                      static_cast<double>(event.end_ns - event.start_ns) / 1.0e6);
+                }
+            }
+
+            draw_list->PopClipRect();
+            ImGui::Dummy(ImVec2(width, lane_height));
+            lane_begin = lane_end;
+        }
+    }
+
+    void ProfilerPanel::export_chrome_trace() const {
+        std::string file_name;
+        const std::string path = Utility::FileDialog::save_file(file_name, "capture.json",
+                                                                {{"Chrome Trace", "*.json"}});
+        if (path.empty()) return;
+
+        // Everything still in the buffers, not just what the flame view shows
+        Profiler::capture().save_chrome_trace(path);
+    }
+}
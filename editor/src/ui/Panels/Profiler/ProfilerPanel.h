@@ -0,0 +1,23 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#pragma once
+
+#include "hellfire/core/Profiler.h"
+#include "ui/Panels/EditorPanel.h"
+
+namespace hellfire::editor {
+    /// Flame view of the CPU scopes of the last frame, with Chrome trace export
+    class ProfilerPanel : public EditorPanel {
+    public:
+        void render() override;
+
+    private:
+        ProfileCapture capture_;
+        bool paused_ = false;
+
+        void draw_flame_view(const ProfileFrame &frame) const;
+
+        void export_chrome_trace() const;
+    };
+}
@@ -6,13 +6,192 @@
 
 #include "imgui.h"
 #include "hellfire/graphics/renderer/Renderer.h"
+#include "hellfire/utilities/FileDialog.h"
 #include "ui/ui.h"
 
 namespace hellfire::editor {
     void RendererSettingsPanel::render() {
         if (ui::Window window{"Renderer Settings"}) {
             if (const auto renderer = ServiceLocator::get_service<Renderer>()) {
-                ui::float_input("Shadow Bias", &renderer->get_shadow_settings().bias, 0.001);
+                ImGui::SeparatorText("Shadows");
+                auto &shadows = renderer->get_shadow_settings();
+                ui::float_input("Shadow Bias", &shadows.bias, 0.001);
+
+                // Index 0 is two cascades
+                int cascade_option = shadows.cascade_count - 2;
+                if (ui::combo_box_int("Cascades", "2\0" "3\0" "4\0", &cascade_option)) {
+                    shadows.cascade_count = cascade_option + 2;
+                }
+
+                constexpr uint32_t resolutions[] = {512, 1024, 2048, 4096, 8192};
+                int resolution_option = 0;
+                int atlas_option = 0;
+                for (int i = 0; i < 5; i++) {
+                    if (resolutions[i] == shadows.cascade_resolution) resolution_option = i;
+                    if (resolutions[i] == shadows.atlas_size) atlas_option = i;
+                }
+                if (ui::combo_box_int("Cascade Resolution", "512\0" "1024\0" "2048\0" "4096\0", &resolution_option)) {
+                    shadows.cascade_resolution = resolutions[resolution_option];
+                }
+                if (ui::combo_box_int("Shadow Atlas Size", "512\0" "1024\0" "2048\0" "4096\0" "8192\0", &atlas_option)) {
+                    shadows.atlas_size = resolutions[atlas_option];
+                }
+
+                ui::float_input("Split Lambda", &shadows.split_lambda, 0.01f, 0.0f, 1.0f);
+                ui::float_input("Shadow Distance", &shadows.max_distance, 1.0f, 1.0f);
+                ui::bool_input("Cache Static Shadows", &shadows.caching_enabled);
+                const auto &shadow_stats = renderer->get_shadow_stats();
+                ImGui::Text("Shadow layers: %u static, %u dynamic, %u lights skipped", shadow_stats.static_layers_rendered,
+                            shadow_stats.dynamic_layers_rendered, shadow_stats.lights_skipped);
+                const double atlas_use = shadow_stats.atlas_texels > 0
+                                             ? 100.0 * static_cast<double>(shadow_stats.atlas_texels_used) /
+                                               static_cast<double>(shadow_stats.atlas_texels)
+                                             : 0.0;
+                ImGui::Text("Shadow atlas: %.0f%% used, %u lights without room", atlas_use,
+                            shadow_stats.lights_without_tiles);
+
+                ImGui::SeparatorText("Resolution");
+                auto &render_scale = renderer->get_render_scale_settings();
+                ui::bool_input("Dynamic Resolution", &render_scale.dynamic);
+                if (render_scale.dynamic) {
+                    ui::float_input("Target Frame Time (ms)", &render_scale.target_frame_ms, 0.1f, 1.0f, 100.0f);
+                    ui::float_input("Min Render Scale", &render_scale.min_scale, 0.01f, RenderScaleController::MIN_SCALE,
+                                    RenderScaleController::MAX_SCALE);
+                    ui::float_input("Max Render Scale", &render_scale.max_scale, 0.01f, RenderScaleController::MIN_SCALE,
+                                    RenderScaleController::MAX_SCALE);
+                } else {
+                    ui::float_input("Render Scale", &render_scale.scale, 0.01f, RenderScaleController::MIN_SCALE,
+                                    RenderScaleController::MAX_SCALE);
+                }
+                int filter_option = static_cast<int>(render_scale.filter);
+                if (ui::combo_box_int("Upscale Filter", "Bilinear\0" "Sharpen\0", &filter_option)) {
+                    render_scale.filter = static_cast<UpscaleFilter>(filter_option);
+                }
+                if (render_scale.filter == UpscaleFilter::SHARPEN) {
+                    ui::float_input("Sharpness", &render_scale.sharpness, 0.01f, 0.0f, 1.0f);
+                }
+                ImGui::Text("Rendering at %ux%u (%.0f%%)", renderer->get_render_width(), renderer->get_render_height(),
+                            renderer->get_render_scale() * 100.0f);
+
+                ImGui::SeparatorText("Lighting");
+                const auto &cluster_stats = renderer->get_light_cluster_stats();
+                ImGui::Text("Point lights: %u visible of %u", cluster_stats.visible_lights, cluster_stats.lights);
+                ImGui::Text("Light clusters: %u occupied, at most %u lights, %u list entries",
+                            cluster_stats.occupied_clusters, cluster_stats.max_lights_per_cluster,
+                            cluster_stats.light_indices);
+
+                ImGui::SeparatorText("Draw Submission");
+                const auto &stats = renderer->get_state_change_stats();
+                ImGui::Text("Draw calls: %u", stats.draw_calls);
+                ImGui::Text("Binds: %u shader, %u material, %u mesh", stats.shader_binds, stats.material_binds,
+                            stats.mesh_binds);
+                ImGui::Text("State changes saved: %u", stats.get_state_changes_saved());
+                const auto &gl_stats = renderer->get_gl_state_stats();
+                ImGui::Text("GL state calls: %u emitted, %u skipped", gl_stats.emitted, gl_stats.skipped);
+                const auto &object_stats = renderer->get_render_object_stats();
+                ImGui::Text("Render objects: %u (%u synced)", object_stats.object_count, object_stats.objects_synced);
+
+                auto &batching = renderer->get_draw_batching_settings();
+                ui::bool_input("Multi-Draw Batching", &batching.enabled);
+                ImGui::Text("Batched: %u objects in %u multi-draws", stats.batched_objects, stats.multi_draw_calls);
+                if (const auto arena = ServiceLocator::get_service<GeometryArena>()) {
+                    ImGui::Text("Geometry arena: %u / %u vertices, %u / %u indices", arena->get_used_vertices(),
+                                arena->get_vertex_capacity(), arena->get_used_indices(), arena->get_index_capacity());
+                    ImGui::Text("Vertex memory: %llu KB in %u layouts",
+                                static_cast<unsigned long long>(arena->get_used_vertex_bytes() / 1024),
+                                arena->get_pool_count());
+                    ImGui::Text("Index memory: %llu KB",
+                                static_cast<unsigned long long>(arena->get_used_index_bytes() / 1024));
+                }
+
+                ImGui::SeparatorText("Overdraw");
+                bool depth_prepass = renderer->is_depth_prepass_enabled();
+                if (ui::bool_input("Depth Pre-Pass", &depth_prepass)) {
+                    renderer->set_depth_prepass(depth_prepass);
+                }
+                bool overdraw_view = renderer->is_overdraw_view_enabled();
+                if (ui::bool_input("Overdraw View", &overdraw_view)) {
+                    renderer->set_overdraw_view(overdraw_view);
+                }
+                ImGui::Text("Pre-pass draws: %u", stats.prepass_draw_calls);
+
+                ImGui::SeparatorText("Transparency");
+                bool weighted_blended_oit = renderer->is_weighted_blended_oit_enabled();
+                if (ui::bool_input("Order-Independent Transparency", &weighted_blended_oit)) {
+                    renderer->set_weighted_blended_oit(weighted_blended_oit);
+                }
+
+                ImGui::SeparatorText("Culling");
+                bool frustum_culling = renderer->is_frustum_culling_enabled();
+                if (ui::bool_input("Frustum Culling", &frustum_culling)) {
+                    renderer->set_frustum_culling(frustum_culling);
+                }
+                const auto &culling = renderer->get_culling_stats();
+                ImGui::Text("Camera: %u / %u culled", culling.objects_culled, culling.objects_tested);
+                ImGui::Text("Shadow casters: %u / %u culled", culling.shadow_casters_culled,
+                            culling.shadow_casters_tested);
+
+                auto &occlusion = renderer->get_occlusion_culling_settings();
+                ui::bool_input("Occlusion Culling", &occlusion.enabled);
+                ui::float_input("Auto Occluder Size", &occlusion.auto_occluder_size, 0.01f, 0.0f, 2.0f);
+                constexpr uint32_t worker_counts[] = {1, 2, 4, 8};
+                int worker_option = 0;
+                for (int i = 0; i < 4; i++) {
+                    if (worker_counts[i] == occlusion.worker_count) worker_option = i;
+                }
+                if (ui::combo_box_int("Occlusion Threads", "1\0" "2\0" "4\0" "8\0", &worker_option)) {
+                    occlusion.worker_count = worker_counts[worker_option];
+                }
+                ImGui::Text("Occluders: %u, %u triangles", culling.occluders_rendered, culling.occluder_triangles);
+                ImGui::Text("Occlusion: %u / %u culled", culling.occlusion_culled, culling.occlusion_tested);
+
+                ImGui::SeparatorText("Level of Detail");
+                auto &lod = renderer->get_lod_settings();
+                ui::bool_input("Mesh LODs", &lod.enabled);
+                ui::float_input("LOD Error (px)", &lod.error_pixels, 0.1f, 0.1f, 16.0f);
+                ui::float_input("LOD Hysteresis", &lod.hysteresis, 0.05f, 0.0f, 0.9f);
+                const auto &lod_stats = renderer->get_lod_stats();
+                ImGui::Text("Triangles: %llu / %llu at full detail", static_cast<unsigned long long>(lod_stats.triangles),
+                            static_cast<unsigned long long>(lod_stats.full_detail_triangles));
+                ImGui::Text("Per LOD: %u %u %u %u", lod_stats.draws_per_lod[0], lod_stats.draws_per_lod[1],
+                            lod_stats.draws_per_lod[2], lod_stats.draws_per_lod[3]);
+
+                ImGui::SeparatorText("Render Stats");
+                const RenderStats &render_stats = renderer->get_render_stats();
+                ImGui::Text("Binds: %u program, %u VAO, %u texture, %u material", render_stats.program_binds,
+                            render_stats.vertex_array_binds, render_stats.texture_binds, render_stats.material_binds);
+                ImGui::Text("Uniform uploads: %u", render_stats.uniform_uploads);
+                ImGui::Text("Buffer uploads: %.1f KB", static_cast<double>(render_stats.buffer_bytes_uploaded) / 1024.0);
+                if (renderer->is_writing_render_stats_csv()) {
+                    if (ImGui::Button("Stop CSV")) renderer->stop_render_stats_csv();
+                } else if (ImGui::Button("Write CSV...")) {
+                    std::string file_name;
+                    const std::string path = Utility::FileDialog::save_file(file_name, "render_stats.csv",
+                                                                            {{"CSV", "*.csv"}});
+                    if (!path.empty()) renderer->start_render_stats_csv(path);
+                }
+
+                ImGui::SeparatorText("GPU Timings");
+                auto &gpu_timer = renderer->get_gpu_timer();
+                bool gpu_timing = gpu_timer.is_enabled();
+                if (ui::bool_input("GPU Pass Timers", &gpu_timing)) {
+                    gpu_timer.set_enabled(gpu_timing);
+                }
+                for (const GPUPassTiming &pass: gpu_timer.get_passes()) {
+                    const TimingHistory &history = pass.history;
+                    if (history.get_count() == 0) continue;
+                    ImGui::Text("%*s%s: %.2f ms (min %.2f, avg %.2f, p99 %.2f)", static_cast<int>(pass.depth * 2), "",
+                                pass.name.c_str(), history.get_latest(), history.get_min(), history.get_average(),
+                                history.get_percentile(0.99f));
+                    // Graph the top level passes, nested ones (shadow per light) are part of their parent's
+                    if (pass.depth == 0) {
+                        ImGui::PlotLines(("##" + pass.name).c_str(), history.get_samples().data(),
+                                         static_cast<int>(history.get_count()), static_cast<int>(history.get_offset()),
+                                         nullptr, 0.0f, FLT_MAX, ImVec2(-1.0f, 32.0f));
+                    }
+                }
+                ImGui::Text("GPU frame: %.2f ms, frames dropped: %u", gpu_timer.get_frame_history().get_latest(),
+                            gpu_timer.get_frames_dropped());
             }
         }
     }
@@ -21,13 +21,6 @@ namespace hellfire::editor {
         create_editor_camera();
     }
 
-    Framebuffer* ViewportPanel::get_picking_fbo() {
-        if (!picking_fbo_) {
-            picking_fbo_ = std::make_unique<Framebuffer>();
-        }
-        return picking_fbo_.get();
-    }
-
     ViewportPanel::~ViewportPanel() {
         destroy_editor_camera();
     }
@@ -245,12 +238,14 @@ namespace hellfire::editor {
             const int mouse_x = static_cast<int>(mouse_pos.x - viewport_pos.x);
             const int mouse_y = static_cast<int>(mouse_pos.y - viewport_pos.y);
 
-            const uint32_t picked_entity_id = pick_object_at_mouse(mouse_x, mouse_y);
-            context_->selected_entity_id = picked_entity_id;
+            pick_object_at_mouse(mouse_x, mouse_y);
         }
     }
 
     void ViewportPanel::render() {
+        // Picks queued in earlier frames
+        picking_readback_.poll();
+
         const ImGuiViewport *main_viewport = ImGui::GetMainViewport();
         const ImVec2 default_size = ImVec2(main_viewport->Size.x / 1.5f, main_viewport->Size.y / 1.5f);
         const ImVec2 default_pos = ImVec2(
@@ -306,6 +301,18 @@ namespace hellfire::editor {
                 ImGui::Text("Entities: %zu", context_->active_scene->get_entity_count());
             }
 
+            if (engine_renderer_) {
+                const RenderStats &stats = engine_renderer_->get_render_stats();
+                ImGui::Separator();
+                ImGui::Text("Draws: %u (%u instanced, %u shadow)", stats.draw_calls, stats.instanced_draw_calls,
+                            stats.shadow_draw_calls);
+                ImGui::Text("Triangles: %llu, instances: %llu", static_cast<unsigned long long>(stats.triangles),
+                            static_cast<unsigned long long>(stats.instances));
+                ImGui::Text("Binds: %u program, %u VAO, %u texture", stats.program_binds, stats.vertex_array_binds,
+                            stats.texture_binds);
+                ImGui::Text("Culled: %u objects, %u casters", stats.objects_culled, stats.shadow_casters_culled);
+            }
+
             if (editor_camera_) {
                 ImGui::Separator();
                 const glm::vec3 pos = editor_camera_->transform()->get_position();
@@ -315,11 +322,11 @@ namespace hellfire::editor {
         ImGui::End();
     }
 
-    uint32_t ViewportPanel::pick_object_at_mouse(const int mouse_x, const int mouse_y) {
-        if (!engine_renderer_) return 0;
+    bool ViewportPanel::pick_object_at_mouse(const int mouse_x, const int mouse_y) {
+        if (!engine_renderer_) return false;
         
         const uint32_t object_id_texture = engine_renderer_->get_object_id_texture();
-        if (object_id_texture == 0) return 0;
+        if (object_id_texture == 0) return false;
 
         // Get viewport dimensions
         const ImVec2 viewport_size = viewport_size_;
@@ -330,11 +337,16 @@ namespace hellfire::editor {
         // Bounds check
         if (tex_x < 0 || tex_x >= static_cast<int>(viewport_size.x) ||
             tex_y < 0 || tex_y >= static_cast<int>(viewport_size.y)) {
-            return 0;
+            return false;
         }
 
-        const uint32_t pixel_data = get_picking_fbo()->read_pixel_from_texture(object_id_texture, tex_x, tex_y);
-
-        return pixel_data;
+        // Clicks still in flight are superseded by newer ones
+        const uint32_t generation = ++pick_generation_;
+        return picking_readback_.request(object_id_texture, {tex_x, tex_y, 1, 1},
+                                         [this, generation](const PixelRegion &, const std::vector<uint32_t> &pixels) {
+                                             if (generation == pick_generation_) {
+                                                 context_->selected_entity_id = pixels[0];
+                                             }
+                                         });
     }
 };
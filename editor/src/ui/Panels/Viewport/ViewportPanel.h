@@ -6,7 +6,7 @@
 #include <imgui.h>
 
 #include "ImGuizmo.h"
-#include "hellfire/graphics/backends/opengl/Framebuffer.h"
+#include "hellfire/graphics/backends/opengl/PixelReadback.h"
 #include "ui/Panels/EditorPanel.h"
 
 namespace hellfire::editor {
@@ -17,8 +17,6 @@ namespace hellfire::editor {
     public:
         ViewportPanel();
 
-        Framebuffer *get_picking_fbo();
-
         ~ViewportPanel() override;
 
         /**
@@ -33,12 +31,13 @@ namespace hellfire::editor {
         void render_viewport_stats_overlay() const;
 
         /**
-         * @brief Picks an entity at the given screen-space coordinates
-         * @param mouse_x X coordinate in screen space
-         * @param mouse_y Y coordinate in screen space
-         * @return EntityID at the given postion, or 0 if none
+         * @brief Queues a read of the entity id under the given viewport coordinates
+         * The selection changes a frame or two later, once the GPU has written the id back
+         * @param mouse_x X coordinate relative to the viewport
+         * @param mouse_y Y coordinate relative to the viewport
+         * @return false if the position is outside the viewport or the read couldn't be queued
          */
-        uint32_t pick_object_at_mouse(int mouse_x, int mouse_y);
+        bool pick_object_at_mouse(int mouse_x, int mouse_y);
 
         /**
          * @brief Handles mouse-based entity selection using the picking framebuffer
@@ -101,6 +100,7 @@ namespace hellfire::editor {
         Renderer *engine_renderer_ = nullptr;
 
         // Entity picking
-        std::unique_ptr<Framebuffer> picking_fbo_; // Renders entity IDs for mouse picking
+        PixelReadback picking_readback_; // Reads the renderer's object id texture back without stalling
+        uint32_t pick_generation_ = 0; // Only the latest click's result changes the selection
     };
 }
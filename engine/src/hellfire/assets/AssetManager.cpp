@@ -10,9 +10,12 @@
 namespace hellfire {
     AssetManager::AssetManager(AssetRegistry &registry) : registry_(registry) {}
 
-    std::shared_ptr<Mesh> AssetManager::get_mesh(AssetID id) {
+    std::shared_ptr<Mesh> AssetManager::get_mesh(AssetID id, const Mesh::CpuResidency residency) {
         // Check cache
         if (auto it = mesh_cache_.find(id); it != mesh_cache_.end()) {
+            if (residency == Mesh::CpuResidency::KEEP) {
+                it->second->ensure_cpu_data();
+            }
             return it->second;
         }
 
@@ -23,7 +26,7 @@ namespace hellfire {
             return nullptr;
         }
 
-        auto mesh = MeshSerializer::load(registry_.get_absolute_path(id));
+        auto mesh = MeshSerializer::load(registry_.get_absolute_path(id), residency);
         if (!mesh) {
             std::cerr << "Failed to load mesh: " << std::endl;
             return nullptr;
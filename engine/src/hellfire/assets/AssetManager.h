@@ -12,7 +12,9 @@ namespace hellfire {
         explicit AssetManager(AssetRegistry& registry);
 
         // Typed asset loading with caching
-        std::shared_ptr<Mesh> get_mesh(AssetID id);
+        /// KEEP makes sure the mesh keeps its CPU side vertices and indices, even when it was already loaded
+        std::shared_ptr<Mesh> get_mesh(AssetID id,
+                                       Mesh::CpuResidency residency = Mesh::CpuResidency::RELEASE_AFTER_UPLOAD);
         std::shared_ptr<Material> get_material(AssetID id);
         std::shared_ptr<Texture> get_texture(AssetID id);
 
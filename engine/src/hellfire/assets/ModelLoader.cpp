@@ -9,7 +9,9 @@
 #include "hellfire/ecs/RenderableComponent.h"
 #include "../ecs/Entity.h"
 #include "hellfire/ecs/TransformComponent.h"
+#include "hellfire/core/Profiler.h"
 #include "hellfire/ecs/components/MeshComponent.h"
+#include "hellfire/graphics/geometry/MeshSimplifier.h"
 #include "hellfire/scene/Scene.h"
 
 namespace fs = std::filesystem;
@@ -23,6 +25,7 @@ namespace hellfire::Addons {
     std::unordered_map<std::string, std::shared_ptr<Texture> > ModelLoader::texture_cache;
 
     EntityID ModelLoader::load_model(Scene *scene, const std::filesystem::path &filepath, unsigned int import_flags) {
+        HF_PROFILE_SCOPE("ModelLoader::load_model");
         const auto start_time = std::chrono::high_resolution_clock::now();
         std::cout << "Loading model: " << filepath << std::endl;
 
@@ -307,8 +310,11 @@ namespace hellfire::Addons {
         std::vector<unsigned int> indices;
         process_mesh_vertices(mesh, vertices, indices);
 
-        // Create mesh WITHOUT material
-        auto processed_mesh = std::make_shared<Mesh>(vertices, indices);
+        // Create mesh WITHOUT material, with its LOD chain uploaded along with it
+        auto processed_mesh = std::make_shared<Mesh>(vertices, indices, true);
+        processed_mesh->lods = MeshSimplifier::build_lod_chain(vertices, indices);
+        processed_mesh->optimize();
+        processed_mesh->build();
 
         // Cache the mesh
         mesh_cache[mesh_key] = processed_mesh;
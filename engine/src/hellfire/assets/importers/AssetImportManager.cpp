@@ -5,6 +5,7 @@
 #include "AssetImportManager.h"
 
 #include "hellfire/assets/models/ModelImporter.h"
+#include "hellfire/core/Profiler.h"
 #include "hellfire/serializers/ModelSerializer.h"
 #include "hellfire/serializers/TextureSerializer.h"
 
@@ -82,6 +83,7 @@ namespace hellfire {
         std::mutex registry_mutex;
 
         auto worker = [&](const AssetMetadata& meta) {
+            HF_PROFILE_THREAD("Asset Import");
             bool success = import_model_threaded(meta, registry_mutex);
         
             std::lock_guard lock(output_mutex);
@@ -205,6 +207,7 @@ namespace hellfire {
     const AssetMetadata& meta, 
     std::mutex& registry_mutex) 
     {
+        HF_PROFILE_SCOPE("AssetImportManager::import_model_threaded");
         auto source_path = project_root_ / meta.filepath;
 
         if (!std::filesystem::exists(source_path)) {
@@ -7,6 +7,7 @@
 
 #include <fstream>
 #include <assimp/Importer.hpp>
+#include <assimp/config.h>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 
@@ -15,6 +16,7 @@
 #include "glm/gtx/matrix_decompose.hpp"
 #include "hellfire/graphics/Mesh.h"
 #include "hellfire/graphics/Vertex.h"
+#include "hellfire/graphics/geometry/MeshSimplifier.h"
 #include "hellfire/graphics/material/MaterialData.h"
 #include "hellfire/serializers/MaterialSerializer.h"
 #include "hellfire/serializers/MeshSerializer.h"
@@ -32,8 +34,10 @@ namespace hellfire {
         source_path_ = source_path;
         source_dir_ = source_path.parent_path();
         base_name_ = source_path.stem().string();
+        settings_ = settings;
 
         Assimp::Importer importer;
+        importer.SetPropertyInteger(AI_CONFIG_PP_SLM_VERTEX_LIMIT, MAX_UINT16_INDEXED_VERTICES);
         ai_scene_ = importer.ReadFile(source_path.string(), build_import_flags(settings));
 
         if (!ai_scene_ || !ai_scene_->mRootNode) {
@@ -63,6 +67,8 @@ namespace hellfire {
             flags |= aiProcess_FlipUVs;
         if (settings.optimize_meshes)
             flags |= aiProcess_OptimizeMeshes | aiProcess_OptimizeGraph;
+        if (settings.split_large_meshes)
+            flags |= aiProcess_SplitLargeMeshes;
 
         flags |= aiProcess_JoinIdenticalVertices;
         flags |= aiProcess_ImproveCacheLocality;
@@ -200,14 +206,23 @@ namespace hellfire {
 
         // Serialize to file
         Mesh mesh(vertices, indices, true); // defer building, because opengl isn't thread safe
+        if (settings_.generate_lods) {
+            mesh.lods = MeshSimplifier::build_lod_chain(vertices, indices, settings_.lod_ratios);
+        }
+        if (settings_.compress_vertices) {
+            mesh.vertex_layout = VertexLayout::compact(ai_mesh->HasVertexColors(0));
+        }
         const std::string filename = make_unique_name(base_name_, "mesh", mesh_index) + ".hfmesh";
         const auto filepath = output_dir_ / filename;
 
 
-        if (!MeshSerializer::save(filepath, mesh)) {
+        MeshOptimizationStats optimization_stats;
+        if (!MeshSerializer::save(filepath, mesh, &optimization_stats)) {
             std::cerr << "Failed to save mesh: " << filepath << std::endl;
             return INVALID_ASSET_ID;
         }
+        std::cout << "Mesh " << filename << ": ACMR " << optimization_stats.acmr_before << " -> "
+                  << optimization_stats.acmr_after << " (" << optimization_stats.clusters << " clusters)" << std::endl;
 
         return registry_.register_asset(filepath, AssetType::MESH);
     }
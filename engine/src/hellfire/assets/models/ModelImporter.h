@@ -19,6 +19,10 @@ namespace hellfire {
         bool flip_uvs = true;
         bool optimize_meshes = true;
         float scale_factor = 1.0f;
+        bool generate_lods = true;
+        std::vector<float> lod_ratios = {0.5f, 0.25f, 0.125f}; // Triangle count of each LOD relative to the full mesh
+        bool compress_vertices = true; // VertexLayout::compact(), colors only kept when the source has them
+        bool split_large_meshes = true; // Keep submeshes within 65536 vertices so they all get 16 bit indices
     };
 
     /**
@@ -37,6 +41,7 @@ namespace hellfire {
 
         // Current import state
         const aiScene* ai_scene_ = nullptr;
+        ImportSettings settings_;
         std::filesystem::path source_path_;
         std::filesystem::path source_dir_;
         std::string base_name_;
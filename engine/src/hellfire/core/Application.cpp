@@ -1,9 +1,11 @@
 #include "Application.h"
 
+#include "Profiler.h"
 #include "Time.h"
 #include "hellfire/utilities/ServiceLocator.h"
 #include "../platform/windows_linux/GLFWWindow.h"
 #include "hellfire/scene/Scene.h"
+#include "hellfire/graphics/backends/opengl/GLStateCache.h"
 
 namespace hellfire {
     Application::Application(int width, int height, std::string title) : shader_registry_(&shader_manager_) {
@@ -14,6 +16,8 @@ namespace hellfire {
     }
 
     Application::~Application() {
+        // Meshes that outlive the arena fall back to not freeing their ranges
+        ServiceLocator::unregister_service<GeometryArena>();
     }
 
     Shader *Application::ensure_fallback_shader() {
@@ -88,6 +92,10 @@ namespace hellfire {
         ServiceLocator::register_service<ShaderManager>(&shader_manager_);
         ServiceLocator::register_service<IWindow>(window_.get());
 
+        // Shared vertex/index storage, meshes built from here on sub-allocate from it
+        geometry_arena_ = std::make_unique<GeometryArena>();
+        ServiceLocator::register_service<GeometryArena>(geometry_arena_.get());
+
         // Initialize engine systems
         Time::init();
         // renderer_.init();
@@ -102,15 +110,20 @@ namespace hellfire {
     }
 
     void Application::run() {
+        HF_PROFILE_THREAD("Main");
         // while (!should_exit()) {
         while (!window_->should_close()) {
             if (window_info_.minimized) {
                 window_->wait_for_events();
                 continue;
             }
+            HF_PROFILE_FRAME();
 
             // Poll the window for events (mouse inputs, keys, window stuff, etc.)
-            window_->poll_events();
+            {
+                HF_PROFILE_SCOPE("Poll Events");
+                window_->poll_events();
+            }
             // Make sure the timer is updated
             Time::update();
 
@@ -118,6 +131,7 @@ namespace hellfire {
 
             // Update scene
             if (auto sm = ServiceLocator::get_service<SceneManager>()) {
+                HF_PROFILE_SCOPE("Scene Update");
                 sm->update(Time::delta_time);
             }
 
@@ -128,6 +142,7 @@ namespace hellfire {
 
 
     void Application::on_render() {
+        HF_PROFILE_SCOPE("Application::on_render");
         // Plugin begin_frame
         call_plugins([](IApplicationPlugin &plugin) {
             plugin.on_begin_frame();
@@ -152,9 +167,12 @@ namespace hellfire {
 
 
         // Plugin render
-        call_plugins([](IApplicationPlugin &plugin) {
-            plugin.on_render();
-        });
+        {
+            HF_PROFILE_SCOPE("Plugin Render");
+            call_plugins([](IApplicationPlugin &plugin) {
+                plugin.on_render();
+            });
+        }
 
         if (auto renderer = ServiceLocator::get_service<Renderer>()) {
             renderer->end_frame();
@@ -163,6 +181,7 @@ namespace hellfire {
         call_plugins([](IApplicationPlugin &plugin) {
             plugin.on_end_frame();
         });
+        HF_PROFILE_SCOPE("Swap Buffers");
         window_->swap_buffers();
     }
 
@@ -244,7 +263,7 @@ namespace hellfire {
         window_info_.aspect_ratio = static_cast<float>(width) / static_cast<float>(height);
 
 
-        glViewport(0, 0, width, height);
+        GLStateCache::viewport(0, 0, width, height);
 
         // Update cameras
         if (auto sm = ServiceLocator::get_service<SceneManager>()) {
@@ -99,6 +99,7 @@ namespace hellfire {
         std::unique_ptr<InputManager> input_manager_;
 
         ShaderManager shader_manager_;
+        std::unique_ptr<GeometryArena> geometry_arena_;
         ShaderRegistry shader_registry_;
 
         // Window info tracking
@@ -0,0 +1,289 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include "Profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+
+#if defined(_M_X64)
+#include <intrin.h>
+#elif defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+namespace hellfire {
+    namespace {
+        struct ThreadBuffer {
+            std::unique_ptr<ProfileEvent[]> events = std::make_unique<ProfileEvent[]>(Profiler::EVENTS_PER_THREAD);
+            std::atomic<uint64_t> write_index = 0; // Events ever written, only the owning thread advances it
+            uint32_t thread = 0; // Index in Registry::buffers, kept when the buffer moves to a new thread
+            // Guarded by the registry mutex
+            std::string name;
+            uint64_t first_event = 0; // write_index when the current thread took the buffer over
+            bool in_use = false;
+        };
+
+        struct Registry {
+            std::mutex mutex;
+            std::vector<std::unique_ptr<ThreadBuffer> > buffers;
+            std::array<ProfileFrame, Profiler::MAX_FRAMES> frames{};
+            uint64_t frame_count = 0;
+            uint64_t frame_start_ticks = 0;
+            // Ticks and steady clock read together when the profiler started, the origin of the tick mapping
+            uint64_t origin_ticks = Profiler::now_ticks();
+            uint64_t origin_ns = Profiler::now_ns();
+        };
+
+        Registry &get_registry() {
+            static Registry registry;
+            return registry;
+        }
+
+        /// Registers the thread on first use, hands its buffer back when the thread exits
+        struct ThreadState {
+            ThreadBuffer *buffer = nullptr;
+            uint32_t depth = 0;
+
+            ~ThreadState() {
+                if (!buffer) return;
+                Registry &registry = get_registry();
+                std::lock_guard lock(registry.mutex);
+                buffer->in_use = false;
+            }
+        };
+
+        thread_local ThreadState thread_state;
+
+        ThreadBuffer &acquire_thread_buffer() {
+            Registry &registry = get_registry();
+            std::lock_guard lock(registry.mutex);
+
+            ThreadBuffer *buffer = nullptr;
+            for (const auto &candidate: registry.buffers) {
+                if (!candidate->in_use) {
+                    buffer = candidate.get();
+                    break;
+                }
+            }
+            if (!buffer) {
+                registry.buffers.push_back(std::make_unique<ThreadBuffer>());
+                buffer = registry.buffers.back().get();
+                buffer->thread = static_cast<uint32_t>(registry.buffers.size() - 1);
+            }
+            // The thread index goes with the buffer, so the name table stays as long as the most threads
+            // ever alive at once. The previous owner's events would show up under the new name, drop them
+            buffer->name = "Thread " + std::to_string(buffer->thread);
+            buffer->first_event = buffer->write_index.load(std::memory_order_relaxed);
+            buffer->in_use = true;
+            return *buffer;
+        }
+
+        ThreadBuffer &get_thread_buffer() {
+            if (!thread_state.buffer) {
+                thread_state.buffer = &acquire_thread_buffer();
+            }
+            return *thread_state.buffer;
+        }
+
+        void write_json_string(std::ostream &out, const char *text) {
+            out << '"';
+            for (const char *c = text; *c; c++) {
+                switch (*c) {
+                    case '"': out << "\\\"";
+                        break;
+                    case '\\': out << "\\\\";
+                        break;
+                    case '\n': out << "\\n";
+                        break;
+                    default:
+                        if (static_cast<unsigned char>(*c) >= 0x20) out << *c;
+                }
+            }
+            out << '"';
+        }
+    }
+
+    uint64_t Profiler::now_ns() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    uint64_t Profiler::now_ticks() {
+#if defined(_M_X64) || defined(__x86_64__)
+        return __rdtsc();
+#else
+        return now_ns();
+#endif
+    }
+
+    uint64_t Profiler::begin_scope() {
+        thread_state.depth++;
+        return now_ticks();
+    }
+
+    void Profiler::end_scope(const char *name, const uint64_t start_ticks) {
+        const uint64_t end_ticks = now_ticks();
+        ThreadBuffer &buffer = get_thread_buffer();
+        thread_state.depth--;
+
+        // Stored in ticks, capture() converts them
+        const uint64_t index = buffer.write_index.load(std::memory_order_relaxed);
+        buffer.events[index & (EVENTS_PER_THREAD - 1)] = {
+            name, start_ticks, end_ticks, thread_state.depth, buffer.thread
+        };
+        buffer.write_index.store(index + 1, std::memory_order_release);
+    }
+
+    void Profiler::mark_frame() {
+        const uint64_t now = now_ticks();
+        const uint32_t thread = get_thread_buffer().thread;
+
+        Registry &registry = get_registry();
+        std::lock_guard lock(registry.mutex);
+        if (registry.frame_start_ticks != 0) {
+            registry.frames[registry.frame_count % MAX_FRAMES] = {registry.frame_count, registry.frame_start_ticks, now,
+                                                                  thread};
+            registry.frame_count++;
+        }
+        registry.frame_start_ticks = now;
+    }
+
+    void Profiler::set_thread_name(const std::string &name) {
+        ThreadBuffer &buffer = get_thread_buffer();
+
+        Registry &registry = get_registry();
+        std::lock_guard lock(registry.mutex);
+        buffer.name = name;
+    }
+
+    ProfileCapture Profiler::capture(const uint64_t since_ns) {
+        ProfileCapture capture;
+        Registry &registry = get_registry();
+        std::lock_guard lock(registry.mutex);
+
+        // Map ticks onto the steady clock with the rate measured since the profiler started
+        const uint64_t now_tick = now_ticks();
+        const uint64_t now_nanos = now_ns();
+        const double ns_per_tick = now_tick > registry.origin_ticks
+                                       ? static_cast<double>(now_nanos - registry.origin_ns) /
+                                         static_cast<double>(now_tick - registry.origin_ticks)
+                                       : 1.0;
+        const auto to_ns = [&](const uint64_t ticks) {
+            const auto offset = static_cast<double>(static_cast<int64_t>(ticks - registry.origin_ticks));
+            return static_cast<uint64_t>(static_cast<double>(registry.origin_ns) + offset * ns_per_tick);
+        };
+
+        for (const auto &buffer: registry.buffers) {
+            // Copy the ring, then drop whatever the owner overwrote while it was being copied. The
+            // oldest slot is left out as the owner may be writing the next event over it right now
+            const uint64_t end = buffer->write_index.load(std::memory_order_acquire);
+            const uint64_t begin = std::max(end > EVENTS_PER_THREAD - 1 ? end - (EVENTS_PER_THREAD - 1) : 0,
+                                            std::min(buffer->first_event, end));
+            const size_t first = capture.events.size();
+            for (uint64_t i = begin; i < end; i++) {
+                capture.events.push_back(buffer->events[i & (EVENTS_PER_THREAD - 1)]);
+            }
+            const uint64_t written = buffer->write_index.load(std::memory_order_acquire);
+            // Writing event w replaces w - EVENTS_PER_THREAD, and event `written` may be mid-write
+            const uint64_t overwritten = written + 1 > EVENTS_PER_THREAD + begin
+                                             ? written + 1 - EVENTS_PER_THREAD - begin
+                                             : 0;
+            capture.events.erase(capture.events.begin() + static_cast<std::ptrdiff_t>(first),
+                                 capture.events.begin() + static_cast<std::ptrdiff_t>(
+                                     first + std::min<uint64_t>(overwritten, end - begin)));
+        }
+        for (ProfileEvent &event: capture.events) {
+            event.start_ns = to_ns(event.start_ns);
+            event.end_ns = to_ns(event.end_ns);
+        }
+        std::erase_if(capture.events, [&](const ProfileEvent &event) { return event.end_ns < since_ns; });
+
+        // Scopes are written when they end, so parents come after their children
+        std::stable_sort(capture.events.begin(), capture.events.end(), [](const ProfileEvent &a, const ProfileEvent &b) {
+            return a.thread != b.thread ? a.thread < b.thread : a.start_ns < b.start_ns;
+        });
+
+        const uint64_t frame_count = std::min<uint64_t>(registry.frame_count, MAX_FRAMES);
+        for (uint64_t i = registry.frame_count - frame_count; i < registry.frame_count; i++) {
+            ProfileFrame frame = registry.frames[i % MAX_FRAMES];
+            frame.start_ns = to_ns(frame.start_ns);
+            frame.end_ns = to_ns(frame.end_ns);
+            if (frame.end_ns >= since_ns) capture.frames.push_back(frame);
+        }
+        capture.thread_names.reserve(registry.buffers.size());
+        for (const auto &buffer: registry.buffers) {
+            capture.thread_names.push_back(buffer->name);
+        }
+        return capture;
+    }
+
+    void Profiler::clear() {
+        Registry &registry = get_registry();
+        std::lock_guard lock(registry.mutex);
+        for (const auto &buffer: registry.buffers) {
+            buffer->write_index.store(0, std::memory_order_relaxed);
+            buffer->first_event = 0;
+        }
+        registry.frame_count = 0;
+        registry.frame_start_ticks = 0;
+    }
+
+    void ProfileCapture::write_chrome_trace(std::ostream &out) const {
+        // Timestamps are microseconds, relative to the first thing captured
+        uint64_t origin = UINT64_MAX;
+        for (const ProfileEvent &event: events) origin = std::min(origin, event.start_ns);
+        for (const ProfileFrame &frame: frames) origin = std::min(origin, frame.start_ns);
+        const auto micros = [&](const uint64_t ns) { return static_cast<double>(ns - origin) / 1000.0; };
+        const std::ios_base::fmtflags flags = out.flags();
+        const std::streamsize precision = out.precision(3);
+        out << std::fixed;
+
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool first = true;
+        const auto separator = [&]() {
+            if (!first) out << ",";
+            out << "\n";
+            first = false;
+        };
+
+        for (size_t thread = 0; thread < thread_names.size(); thread++) {
+            separator();
+            out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread << ",\"args\":{\"name\":";
+            write_json_string(out, thread_names[thread].c_str());
+            out << "}}";
+        }
+        for (const ProfileFrame &frame: frames) {
+            separator();
+            out << "{\"name\":\"Frame " << frame.index << "\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                    << frame.thread << ",\"ts\":" << micros(frame.start_ns) << ",\"dur\":"
+                    << static_cast<double>(frame.end_ns - frame.start_ns) / 1000.0 << "}";
+        }
+        for (const ProfileEvent &event: events) {
+            separator();
+            out << "{\"name\":";
+            write_json_string(out, event.name);
+            out << ",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread << ",\"ts\":"
+                    << micros(event.start_ns) << ",\"dur\":" << static_cast<double>(event.end_ns - event.start_ns) /
+                    1000.0 << "}";
+        }
+        out << "\n]}\n";
+        out.flags(flags);
+        out.precision(precision);
+    }
+
+    bool ProfileCapture::save_chrome_trace(const std::filesystem::path &path) const {
+        std::ofstream file(path);
+        if (!file) {
+            std::cerr << "Profiler: Cannot write " << path << std::endl;
+            return false;
+        }
+        write_chrome_trace(file);
+        return static_cast<bool>(file);
+    }
+}
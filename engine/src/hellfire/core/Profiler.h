@@ -0,0 +1,126 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace hellfire {
+    /// One finished CPU scope, in now_ns() time once captured
+    struct ProfileEvent {
+        const char *name; // Must outlive the profiler, scopes only keep the pointer (string literals, __func__)
+        uint64_t start_ns;
+        uint64_t end_ns;
+        uint32_t depth; // Scopes already open on the thread when it began
+        uint32_t thread; // Index into ProfileCapture::thread_names
+    };
+
+    /// Span between two frame markers
+    struct ProfileFrame {
+        uint64_t index;
+        uint64_t start_ns;
+        uint64_t end_ns;
+        uint32_t thread; // Thread that marks the frames
+    };
+
+    /// Copy of what the profiler holds at one point in time
+    struct ProfileCapture {
+        std::vector<ProfileEvent> events; // Per thread, ordered by start
+        std::vector<ProfileFrame> frames; // Oldest first
+        std::vector<std::string> thread_names;
+
+        /// Chrome trace event JSON, which chrome://tracing and Perfetto both open
+        void write_chrome_trace(std::ostream &out) const;
+
+        bool save_chrome_trace(const std::filesystem::path &path) const;
+    };
+
+    /**
+     * @brief Engine-wide CPU profiler fed by HF_PROFILE_SCOPE.
+     *
+     * Every thread records into a ring buffer of its own, so recording a scope is two timestamp
+     * reads and a store without locks; the last EVENTS_PER_THREAD - 1 scopes of each thread are kept.
+     * Timestamps are raw TSC ticks where available, which cost about half a steady_clock read,
+     * and are mapped onto the steady clock when captured.
+     * Buffers of finished threads are handed to the next new thread along with their thread index,
+     * which keeps short-lived workers from growing memory or the thread table; the finished thread's
+     * events are dropped then. capture() may run while other threads keep recording.
+     */
+    class Profiler {
+    public:
+        static constexpr uint32_t EVENTS_PER_THREAD = 1 << 14; // Power of two
+        static constexpr uint32_t MAX_FRAMES = 256;
+
+        static void set_enabled(const bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+        static bool is_enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+        /// Steady clock time, the time base of captures
+        static uint64_t now_ns();
+
+        /// Raw timestamp scopes are recorded in: the TSC on x86-64, converted to nanoseconds by capture()
+        static uint64_t now_ticks();
+
+        /// Start a scope on the calling thread, returns its start ticks
+        static uint64_t begin_scope();
+
+        static void end_scope(const char *name, uint64_t start_ticks);
+
+        /// End the current frame and start the next one, called once per frame by the main loop
+        static void mark_frame();
+
+        /// Name the calling thread in captures, threads default to "Thread N"
+        static void set_thread_name(const std::string &name);
+
+        /// Copy the recorded scopes that ended at or after since_ns (on the now_ns() clock)
+        static ProfileCapture capture(uint64_t since_ns = 0);
+
+        /// Drop everything recorded, only safe while no other thread is recording
+        static void clear();
+
+    private:
+        inline static std::atomic<bool> enabled_ = true;
+    };
+
+    /// Records the time between its construction and destruction, see HF_PROFILE_SCOPE
+    class ProfileScope {
+    public:
+        explicit ProfileScope(const char *name) {
+            if (Profiler::is_enabled()) {
+                name_ = name;
+                start_ticks_ = Profiler::begin_scope();
+            }
+        }
+
+        ~ProfileScope() {
+            if (name_) Profiler::end_scope(name_, start_ticks_);
+        }
+
+        ProfileScope(const ProfileScope &) = delete;
+
+        ProfileScope &operator=(const ProfileScope &) = delete;
+
+    private:
+        const char *name_ = nullptr; // nullptr: profiling was off when the scope began
+        uint64_t start_ticks_ = 0;
+    };
+}
+
+// Profiling builds define HELLFIRE_PROFILING (CMake option of the same name), elsewhere these compile to nothing
+#ifdef HELLFIRE_PROFILING
+#define HF_PROFILE_CONCAT_INNER(a, b) a##b
+#define HF_PROFILE_CONCAT(a, b) HF_PROFILE_CONCAT_INNER(a, b)
+#define HF_PROFILE_SCOPE(name) const ::hellfire::ProfileScope HF_PROFILE_CONCAT(hf_profile_scope_, __LINE__)(name)
+#define HF_PROFILE_FUNCTION() HF_PROFILE_SCOPE(__func__)
+#define HF_PROFILE_FRAME() ::hellfire::Profiler::mark_frame()
+#define HF_PROFILE_THREAD(name) ::hellfire::Profiler::set_thread_name(name)
+#else
+#define HF_PROFILE_SCOPE(name) ((void) 0)
+#define HF_PROFILE_FUNCTION() ((void) 0)
+#define HF_PROFILE_FRAME() ((void) 0)
+#define HF_PROFILE_THREAD(name) ((void) 0)
+#endif
@@ -0,0 +1,54 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include "TimingHistory.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace hellfire {
+    TimingHistory::TimingHistory(const uint32_t capacity) : capacity_(std::max(capacity, 1u)) {
+        samples_.reserve(capacity_);
+    }
+
+    void TimingHistory::add(const float milliseconds) {
+        if (samples_.size() < capacity_) {
+            samples_.push_back(milliseconds);
+        } else {
+            samples_[next_] = milliseconds;
+        }
+        next_ = (next_ + 1) % capacity_;
+    }
+
+    void TimingHistory::clear() {
+        samples_.clear();
+        next_ = 0;
+    }
+
+    float TimingHistory::get_latest() const {
+        if (samples_.empty()) return 0.0f;
+        return samples_[(next_ + capacity_ - 1) % capacity_];
+    }
+
+    float TimingHistory::get_min() const {
+        if (samples_.empty()) return 0.0f;
+        return *std::min_element(samples_.begin(), samples_.end());
+    }
+
+    float TimingHistory::get_average() const {
+        if (samples_.empty()) return 0.0f;
+        return std::accumulate(samples_.begin(), samples_.end(), 0.0f) / static_cast<float>(samples_.size());
+    }
+
+    float TimingHistory::get_percentile(const float percentile) const {
+        if (samples_.empty()) return 0.0f;
+
+        // Nearest rank, so p99 of a short window is its maximum rather than an interpolation
+        std::vector<float> sorted = samples_;
+        const auto rank = static_cast<size_t>(std::ceil(std::clamp(percentile, 0.0f, 1.0f) * sorted.size()));
+        const size_t index = std::clamp<size_t>(rank, 1, sorted.size()) - 1;
+        std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(index), sorted.end());
+        return sorted[index];
+    }
+}
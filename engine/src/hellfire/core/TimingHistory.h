@@ -0,0 +1,43 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace hellfire {
+    /**
+     * @brief Rolling window of the last N timings of something measured every frame, in milliseconds.
+     * Samples are kept in a ring so the window can be handed to ImGui::PlotLines with get_offset().
+     */
+    class TimingHistory {
+    public:
+        static constexpr uint32_t DEFAULT_CAPACITY = 240;
+
+        explicit TimingHistory(uint32_t capacity = DEFAULT_CAPACITY);
+
+        /// Add a sample, replacing the oldest once the window is full
+        void add(float milliseconds);
+
+        void clear();
+
+        float get_latest() const;
+        float get_min() const;
+        float get_average() const;
+
+        /// Smallest sample at least `percentile` (in [0, 1]) of the window is at or below, 0.99 for p99
+        float get_percentile(float percentile) const;
+
+        /// Ring storage, the oldest sample is at get_offset() once the window is full
+        const std::vector<float> &get_samples() const { return samples_; }
+        uint32_t get_offset() const { return static_cast<uint32_t>(samples_.size() < capacity_ ? 0 : next_); }
+        uint32_t get_count() const { return static_cast<uint32_t>(samples_.size()); }
+        uint32_t get_capacity() const { return capacity_; }
+
+    private:
+        std::vector<float> samples_;
+        uint32_t capacity_;
+        uint32_t next_ = 0; // Slot the next sample goes in
+    };
+}
@@ -15,6 +15,11 @@ namespace hellfire {
         // Lifecycle hooks
         virtual void on_added(Entity* owner) { owner_ = owner; }
         virtual void on_removed() { owner_ = nullptr; }
+
+    protected:
+        /// Let the owner's observers (e.g. the renderer) know this component's data changed
+        void notify_changed();
+
     private:
         Entity* owner_ = nullptr;
     };
@@ -50,4 +50,12 @@ namespace hellfire {
     }
 
     const TransformComponent *Entity::transform() const { return get_component<TransformComponent>(); }
+
+    void Entity::notify_component_changed(Component &component) {
+        if (observer_) observer_->on_component_changed(*this, component);
+    }
+
+    void Component::notify_changed() {
+        if (owner_) owner_->notify_component_changed(*this);
+    }
 }
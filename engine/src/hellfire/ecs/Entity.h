@@ -29,6 +29,21 @@ namespace hellfire {
 
     template<typename T>
     concept ScriptComponentType = std::derived_from<T, ScriptComponent>;
+
+    class Entity;
+
+    /// Receives the component lifecycle of the entities it observes, usually their Scene
+    class EntityObserver {
+    public:
+        virtual ~EntityObserver() = default;
+
+        virtual void on_component_added(Entity &entity, Component &component) = 0;
+
+        /// Called while the component is still attached
+        virtual void on_component_removed(Entity &entity, Component &component) = 0;
+
+        virtual void on_component_changed(Entity &entity, Component &component) = 0;
+    };
     
     class Entity {
     public:
@@ -81,9 +96,16 @@ namespace hellfire {
 
         [[nodiscard]] const TransformComponent *transform() const;
 
+        // Change notifications
+        void set_observer(EntityObserver *observer) { observer_ = observer; }
+        [[nodiscard]] EntityObserver *get_observer() const { return observer_; }
+
+        void notify_component_changed(Component &component);
+
     private:
         EntityID id_;
         std::string name_;
+        EntityObserver *observer_ = nullptr;
         std::unordered_map<std::type_index, std::unique_ptr<Component> > components_;
         std::vector<ScriptComponent *> script_components_;
     };
@@ -20,6 +20,8 @@
             component_ptr->init();
         }
 
+        if (observer_) observer_->on_component_added(*this, *component_ptr);
+
         return component_ptr;
     }
 
@@ -37,6 +39,8 @@
         if (it != components_.end()) {
             T *component_ptr = static_cast<T *>(it->second.get());
 
+            if (observer_) observer_->on_component_removed(*this, *component_ptr);
+
             // Special handling for ScriptComponents
             if constexpr (std::is_base_of_v<ScriptComponent, T>) {
                 component_ptr->remove(); // Call script cleanup
@@ -1,17 +1,30 @@
 ﻿// InstancedRenderableComponent.cpp
 #include "hellfire/ecs/InstancedRenderableComponent.h"
 #include <GL/glew.h>
+#include <iostream>
+
+#include "hellfire/graphics/backends/opengl/GLStateCache.h"
 
 namespace hellfire {
     InstancedRenderableComponent::InstancedRenderableComponent(
         std::shared_ptr<Mesh> mesh, size_t max_instances)
-        : mesh_(std::move(mesh)), max_instances_(max_instances),
+        : max_instances_(max_instances),
           needs_gpu_update_(false), instance_vbo_(0),
           transform_buffer_(0), color_buffer_(0), scale_buffer_(0) {
         instances_.reserve(max_instances_);
+        take_mesh(std::move(mesh));
         setup_instance_buffers();
     }
 
+    void InstancedRenderableComponent::take_mesh(std::shared_ptr<Mesh> mesh) {
+        if (mesh && !mesh->use_dedicated_buffers()) {
+            std::cerr << "InstancedRenderableComponent: Mesh cannot leave the geometry arena, not drawing it"
+                    << std::endl;
+            mesh.reset();
+        }
+        mesh_ = std::move(mesh);
+    }
+
     InstancedRenderableComponent::~InstancedRenderableComponent() {
         cleanup_buffers();
     }
@@ -53,6 +66,46 @@ namespace hellfire {
         }
     }
 
+    void InstancedRenderableComponent::select_lods(const glm::vec3 &camera_pos, const float pixel_scale,
+                                                   const float error_pixels, const float hysteresis) {
+        instance_lods_.resize(instances_.size(), 0);
+        if (!mesh_) return;
+
+        const float mesh_radius = mesh_->get_bounds().sphere.radius;
+        for (size_t i = 0; i < instances_.size(); i++) {
+            uint32_t lod = 0;
+            if (pixel_scale > 0.0f && !mesh_->lods.empty()) {
+                const glm::mat4 &transform = instances_[i].transform;
+                const float scale = (std::max)({
+                    glm::length(glm::vec3(transform[0])), glm::length(glm::vec3(transform[1])),
+                    glm::length(glm::vec3(transform[2]))
+                });
+                const float distance = (std::max)(
+                    glm::length(glm::vec3(transform[3]) - camera_pos) - mesh_radius * scale, 0.01f);
+                lod = select_mesh_lod(mesh_->lods, pixel_scale * scale / distance, instance_lods_[i], error_pixels,
+                                      hysteresis);
+            }
+            if (lod != instance_lods_[i]) {
+                instance_lods_[i] = static_cast<uint8_t>(lod);
+                needs_gpu_update_ = true;
+            }
+        }
+        count_lod_instances();
+    }
+
+    void InstancedRenderableComponent::count_lod_instances() {
+        instance_lods_.resize(instances_.size(), 0);
+        lod_instance_counts_.fill(0);
+        for (const uint8_t lod: instance_lods_) {
+            lod_instance_counts_[lod]++;
+        }
+        uint32_t first_instance = 0;
+        for (uint32_t lod = 0; lod < MAX_MESH_LODS; lod++) {
+            lod_first_instances_[lod] = first_instance;
+            first_instance += lod_instance_counts_[lod];
+        }
+    }
+
     void InstancedRenderableComponent::prepare_for_draw() {
         if (needs_gpu_update_) {
             update_gpu_buffer();
@@ -60,9 +113,13 @@ namespace hellfire {
         }
     }
 
-    void InstancedRenderableComponent::bind_instance_buffers() {
+    bool InstancedRenderableComponent::bind_instance_buffers() {
+        // The arena VAO is shared by every mesh in its pool, instance attributes would overwrite theirs
+        if (!mesh_ || mesh_->is_in_geometry_arena()) return false;
+
         setup_instanced_vertex_attributes();
         enable_instance_attributes();
+        return true;
     }
 
     void InstancedRenderableComponent::unbind_instance_buffers() {
@@ -77,10 +134,10 @@ namespace hellfire {
     }
 
     void InstancedRenderableComponent::cleanup_buffers() {
-        if (instance_vbo_) glDeleteBuffers(1, &instance_vbo_);
-        if (transform_buffer_) glDeleteBuffers(1, &transform_buffer_);
-        if (color_buffer_) glDeleteBuffers(1, &color_buffer_);
-        if (scale_buffer_) glDeleteBuffers(1, &scale_buffer_);
+        if (instance_vbo_) GLStateCache::delete_buffers(1, &instance_vbo_);
+        if (transform_buffer_) GLStateCache::delete_buffers(1, &transform_buffer_);
+        if (color_buffer_) GLStateCache::delete_buffers(1, &color_buffer_);
+        if (scale_buffer_) GLStateCache::delete_buffers(1, &scale_buffer_);
         
         instance_vbo_ = 0;
         transform_buffer_ = 0;
@@ -88,46 +145,49 @@ namespace hellfire {
         scale_buffer_ = 0;
     }
 
-    void InstancedRenderableComponent::update_gpu_buffer() const {
+    void InstancedRenderableComponent::update_gpu_buffer() {
+        count_lod_instances();
         if (instances_.empty()) return;
 
-        std::vector<glm::mat4> transforms;
-        std::vector<glm::vec3> colors;
-        std::vector<float> scales;
-
-        transforms.reserve(instances_.size());
-        colors.reserve(instances_.size());
-        scales.reserve(instances_.size());
-
-        for (const auto& instance : instances_) {
-            transforms.push_back(instance.transform);
-            colors.push_back(instance.color);
-            scales.push_back(instance.scale);
+        std::vector<glm::mat4> transforms(instances_.size());
+        std::vector<glm::vec3> colors(instances_.size());
+        std::vector<float> scales(instances_.size());
+
+        // Grouped by LOD so every LOD is a single draw over a contiguous instance range
+        const glm::mat4 position_decode = mesh_ ? mesh_->get_position_decode() : glm::mat4(1.0f);
+        std::array<uint32_t, MAX_MESH_LODS> next_instance = lod_first_instances_;
+        for (size_t i = 0; i < instances_.size(); i++) {
+            const uint32_t slot = next_instance[instance_lods_[i]]++;
+            transforms[slot] = instances_[i].transform * position_decode;
+            colors[slot] = instances_[i].color;
+            scales[slot] = instances_[i].scale;
         }
 
         // Upload transforms (layout 4-7)
-        glBindBuffer(GL_ARRAY_BUFFER, transform_buffer_);
+        GLStateCache::bind_buffer(GL_ARRAY_BUFFER, transform_buffer_);
         glBufferData(GL_ARRAY_BUFFER, transforms.size() * sizeof(glm::mat4),
                      transforms.data(), GL_DYNAMIC_DRAW);
 
         // Upload colors (layout 8)
-        glBindBuffer(GL_ARRAY_BUFFER, color_buffer_);
+        GLStateCache::bind_buffer(GL_ARRAY_BUFFER, color_buffer_);
         glBufferData(GL_ARRAY_BUFFER, colors.size() * sizeof(glm::vec3),
                      colors.data(), GL_DYNAMIC_DRAW);
 
         // Upload scales (layout 9)
-        glBindBuffer(GL_ARRAY_BUFFER, scale_buffer_);
+        GLStateCache::bind_buffer(GL_ARRAY_BUFFER, scale_buffer_);
         glBufferData(GL_ARRAY_BUFFER, scales.size() * sizeof(float),
                      scales.data(), GL_DYNAMIC_DRAW);
 
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        GLStateCache::bind_buffer(GL_ARRAY_BUFFER, 0);
+        GLStateCache::record_buffer_upload(transforms.size() * sizeof(glm::mat4) + colors.size() * sizeof(glm::vec3) +
+                                           scales.size() * sizeof(float));
     }
 
     void InstancedRenderableComponent::setup_instanced_vertex_attributes() {
         if (vertex_attributes_setup_) return;
 
         // Transform matrix (layouts 4-7)
-        glBindBuffer(GL_ARRAY_BUFFER, transform_buffer_);
+        GLStateCache::bind_buffer(GL_ARRAY_BUFFER, transform_buffer_);
         for (int i = 0; i < 4; i++) {
             glVertexAttribPointer(4 + i, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4),
                                 (void*)(sizeof(glm::vec4) * i));
@@ -135,12 +195,12 @@ namespace hellfire {
         }
 
         // Color (layout 8)
-        glBindBuffer(GL_ARRAY_BUFFER, color_buffer_);
+        GLStateCache::bind_buffer(GL_ARRAY_BUFFER, color_buffer_);
         glVertexAttribPointer(8, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
         glVertexAttribDivisor(8, 1);
 
         // Scale (layout 9)
-        glBindBuffer(GL_ARRAY_BUFFER, scale_buffer_);
+        GLStateCache::bind_buffer(GL_ARRAY_BUFFER, scale_buffer_);
         glVertexAttribPointer(9, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)0);
         glVertexAttribDivisor(9, 1);
 
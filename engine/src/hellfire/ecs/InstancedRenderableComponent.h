@@ -2,6 +2,7 @@
 // Created by denzel on 14/08/2025.
 //
 #pragma once
+#include <array>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -39,13 +40,19 @@ namespace hellfire {
         ~InstancedRenderableComponent() override;
 
         // Mesh management (kept for now, but prefer using MeshComponent)
-        void set_mesh(std::shared_ptr<Mesh> mesh) { mesh_ = mesh; }
-        [[nodiscard]] std::shared_ptr<Mesh> get_mesh() const { return mesh_; }
+        void set_mesh(std::shared_ptr<Mesh> mesh) {
+            take_mesh(std::move(mesh));
+            notify_changed();
+        }
+        [[nodiscard]] const std::shared_ptr<Mesh> &get_mesh() const { return mesh_; }
         [[nodiscard]] bool has_mesh() const { return mesh_ != nullptr; }
 
         // Material management - NO LONGER stores on mesh
-        void set_material(std::shared_ptr<Material> material) { material_ = material; }
-        [[nodiscard]] std::shared_ptr<Material> get_material() const { return material_; }
+        void set_material(std::shared_ptr<Material> material) {
+            material_ = std::move(material);
+            notify_changed();
+        }
+        [[nodiscard]] const std::shared_ptr<Material> &get_material() const { return material_; }
 
         // Instance management
         void add_instance(const InstanceData& instance);
@@ -60,15 +67,28 @@ namespace hellfire {
         size_t get_max_instances() const { return max_instances_; }
         const std::vector<InstanceData>& get_instances() const { return instances_; }
 
+        /**
+         * @brief Pick every instance's LOD from its distance to the camera, see select_mesh_lod().
+         * @param pixel_scale Pixels one world unit covers at distance 1, 0 puts every instance back on LOD 0
+         */
+        void select_lods(const glm::vec3 &camera_pos, float pixel_scale, float error_pixels, float hysteresis);
+        /// Instances drawn at lod; after prepare_for_draw() they are uploaded grouped by LOD
+        uint32_t get_lod_instance_count(uint32_t lod) const { return lod_instance_counts_[lod]; }
+        uint32_t get_lod_first_instance(uint32_t lod) const { return lod_first_instances_[lod]; }
+
         // Rendering - called by Renderer, not by component itself
         void prepare_for_draw();
-        void bind_instance_buffers();
+        /// Expects the mesh's VAO to be bound, false (and nothing set up) when there is nothing to draw
+        bool bind_instance_buffers();
         void unbind_instance_buffers();
 
     private:
         std::shared_ptr<Mesh> mesh_;
         std::shared_ptr<Material> material_;  // Store material here, not on mesh
         std::vector<InstanceData> instances_;
+        std::vector<uint8_t> instance_lods_; // Parallel to instances_
+        std::array<uint32_t, MAX_MESH_LODS> lod_instance_counts_ = {};
+        std::array<uint32_t, MAX_MESH_LODS> lod_first_instances_ = {};
         size_t max_instances_;
         bool needs_gpu_update_;
         bool vertex_attributes_setup_ = false;
@@ -79,9 +99,13 @@ namespace hellfire {
         GLuint color_buffer_;
         GLuint scale_buffer_;
 
+        /// Instance attributes are added to the mesh's VAO, which must not be the shared arena one.
+        /// Meshes that can't leave the arena are refused
+        void take_mesh(std::shared_ptr<Mesh> mesh);
         void setup_instance_buffers();
         void cleanup_buffers();
-        void update_gpu_buffer() const;
+        void count_lod_instances();
+        void update_gpu_buffer();
         void setup_instanced_vertex_attributes();
         void enable_instance_attributes();
         void disable_instance_attributes();
@@ -9,18 +9,31 @@ namespace hellfire {
     /// Renderable Component used for single mesh rendering
     class RenderableComponent final : public Component {
     public:
+        /// Whether the mesh is rasterized into the software occlusion buffer to hide what's behind it
+        enum class OccluderMode : int {
+            AUTO = 0, // When it covers enough of the screen and is cheap enough
+            ALWAYS = 1,
+            NEVER = 2
+        };
+
         RenderableComponent() = default;
 
         // Material management
-        void set_material(const std::shared_ptr<Material>& material) { material_ = material; }
+        void set_material(const std::shared_ptr<Material>& material) {
+            material_ = material;
+            notify_changed();
+        }
         void set_material_asset(AssetID id) { material_asset_id_ = id; }
         
-        [[nodiscard]] std::shared_ptr<Material> get_material() const { return material_; }
+        [[nodiscard]] const std::shared_ptr<Material> &get_material() const { return material_; }
         AssetID get_material_asset() const { return material_asset_id_; }
         [[nodiscard]] bool has_material() const { return material_ != nullptr; }
 
         // Rendering settings
-        void set_cast_shadows(bool cast) { cast_shadows = cast; }
+        void set_cast_shadows(bool cast) {
+            cast_shadows = cast;
+            notify_changed();
+        }
         void set_receive_shadows(bool receive) { receive_shadows = receive; }
         [[nodiscard]] bool get_cast_shadows() const { return cast_shadows; }
         [[nodiscard]] bool get_receive_shadows() const { return receive_shadows; }
@@ -30,6 +43,7 @@ namespace hellfire {
         bool receive_shadows = true;
         bool visible = true;
         uint32_t render_layer = 0;
+        OccluderMode occluder_mode = OccluderMode::AUTO;
     private:
         std::shared_ptr<Material> material_;
         AssetID material_asset_id_ = INVALID_ASSET_ID;
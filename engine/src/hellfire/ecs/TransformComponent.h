@@ -34,6 +34,7 @@ namespace hellfire {
     
         const glm::mat4& get_local_matrix() const { return transform_.get_local_matrix(); }
         const glm::mat4& get_world_matrix() const { return transform_.get_world_matrix(); }
+        uint32_t get_world_version() const { return transform_.get_world_version(); }
 
         glm::mat4 get_rotation_matrix() const { return transform_.get_rotation_matrix(); }
         glm::mat4 get_translation_matrix() const { return transform_.get_translation_matrix(); }
@@ -4,6 +4,7 @@
 
 #pragma once
 #include "hellfire/ecs/Component.h"
+#include "hellfire/ecs/TransformComponent.h"
 #include "hellfire/graphics/Mesh.h"
 #include "hellfire/assets/AssetRegistry.h"
 
@@ -25,8 +26,11 @@ namespace hellfire {
         MeshComponent() = default;
         explicit MeshComponent(std::shared_ptr<Mesh> mesh) : mesh_(std::move(mesh)) {}
 
-        void set_mesh(std::shared_ptr<Mesh> mesh) { mesh_ = std::move(mesh); }
-        [[nodiscard]] std::shared_ptr<Mesh> get_mesh() const { return mesh_; }
+        void set_mesh(std::shared_ptr<Mesh> mesh) {
+            mesh_ = std::move(mesh);
+            notify_changed();
+        }
+        [[nodiscard]] const std::shared_ptr<Mesh> &get_mesh() const { return mesh_; }
         [[nodiscard]] bool has_mesh() const { return mesh_ != nullptr; }
 
         void set_mesh_asset(AssetID id) { mesh_asset_id_ = id; }
@@ -39,11 +43,29 @@ namespace hellfire {
         }
         MeshSource get_source() const { return source_;}
 
+        /// World space bounds of the mesh, only recomputed when the transform or mesh changed
+        const AABB &get_world_bounds(const TransformComponent &transform) {
+            const uint32_t mesh_version = mesh_ ? mesh_->get_bounds_version() : 0;
+            if (bounds_mesh_ != mesh_.get() || bounds_mesh_version_ != mesh_version ||
+                bounds_transform_version_ != transform.get_world_version()) {
+                world_bounds_ = mesh_ ? mesh_->get_bounds().aabb.transformed(transform.get_world_matrix()) : AABB{};
+                bounds_mesh_ = mesh_.get();
+                bounds_mesh_version_ = mesh_version;
+                bounds_transform_version_ = transform.get_world_version();
+            }
+            return world_bounds_;
+        }
+
         bool is_wireframe = false;
     private:
         std::shared_ptr<Mesh> mesh_;
         MeshSource source_ = MeshSource::EXTERNAL;
         MeshInternalType internal_type = MeshInternalType::NONE;
         AssetID mesh_asset_id_ = INVALID_ASSET_ID; 
+
+        AABB world_bounds_;
+        const Mesh *bounds_mesh_ = nullptr;
+        uint32_t bounds_mesh_version_ = 0;
+        uint32_t bounds_transform_version_ = 0;
     };
 }
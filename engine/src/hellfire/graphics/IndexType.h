@@ -0,0 +1,42 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace hellfire {
+    /// Width of a mesh's indices on the GPU, the CPU side always keeps 32 bit indices
+    enum class IndexType : uint8_t {
+        UINT32,
+        UINT16
+    };
+
+    /// Vertices a 16 bit index can address
+    inline constexpr uint32_t MAX_UINT16_INDEXED_VERTICES = 1 << 16;
+
+    inline uint32_t get_index_size(const IndexType type) {
+        return type == IndexType::UINT16 ? sizeof(uint16_t) : sizeof(uint32_t);
+    }
+
+    /// Narrowest index type that can address vertex_count vertices
+    inline IndexType select_index_type(const size_t vertex_count) {
+        return vertex_count <= MAX_UINT16_INDEXED_VERTICES ? IndexType::UINT16 : IndexType::UINT32;
+    }
+
+    /// Indices as get_index_size(type) bytes each, they must fit the type
+    inline std::vector<uint8_t> pack_indices(const std::vector<unsigned int> &indices, const IndexType type) {
+        std::vector<uint8_t> data(indices.size() * get_index_size(type));
+        if (type == IndexType::UINT16) {
+            auto *out = reinterpret_cast<uint16_t *>(data.data());
+            for (size_t i = 0; i < indices.size(); i++) {
+                out[i] = static_cast<uint16_t>(indices[i]);
+            }
+        } else if (!indices.empty()) {
+            std::memcpy(data.data(), indices.data(), data.size());
+        }
+        return data;
+    }
+}
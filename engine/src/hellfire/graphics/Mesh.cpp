@@ -1,8 +1,13 @@
 #include "hellfire/graphics/Mesh.h"
+#include <atomic>
 #include <unordered_map>
 #include "hellfire/core/Application.h"
 #include "hellfire/graphics/Vertex.h"
+#include "hellfire/graphics/backends/opengl/GLStateCache.h"
+#include "hellfire/graphics/backends/opengl/VertexFormat.h"
 #include "hellfire/graphics/material/Material.h"
+#include "hellfire/serializers/MeshSerializer.h"
+#include "hellfire/utilities/ServiceLocator.h"
 
 namespace hellfire {
     Mesh::Mesh() : vao_(nullptr), vbo_(nullptr), ibo_(nullptr), index_count_(0) {
@@ -19,19 +24,179 @@ namespace hellfire {
         }
     }
 
+    Mesh::~Mesh() {
+        release_arena_allocation();
+    }
+
     void Mesh::bind() const {
-        vao_->bind();
+        if (arena_) {
+            arena_->bind(arena_allocation_.pool, arena_allocation_.index_type);
+        } else {
+            vao_->bind();
+        }
     }
 
     void Mesh::unbind() const {
-        vao_->unbind();
+        if (arena_) {
+            arena_->unbind();
+        } else {
+            vao_->unbind();
+        }
+    }
+
+    bool Mesh::use_dedicated_buffers() {
+        if (dedicated_buffers_) return true;
+
+        dedicated_buffers_ = true;
+        if (arena_) {
+            create_mesh();
+            // The CPU data couldn't be read back, keep drawing from the arena
+            if (arena_) {
+                dedicated_buffers_ = false;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    uint32_t Mesh::get_vertex_array_id() const {
+        if (arena_) return arena_->get_vertex_array_id(arena_allocation_.pool, arena_allocation_.index_type);
+        return vao_ ? vao_->get_id() : 0;
+    }
+
+    void Mesh::release_arena_allocation() {
+        // The arena may already be gone when meshes outlive the application
+        if (arena_ && ServiceLocator::get_service<GeometryArena>() == arena_) {
+            arena_->free(arena_allocation_);
+        }
+        arena_ = nullptr;
+        arena_allocation_ = {};
+    }
+
+    const void *Mesh::get_index_offset(const uint32_t lod) const {
+        const uint32_t first_index = (arena_ ? arena_allocation_.first_index : 0) + get_lod_first_index(lod);
+        return reinterpret_cast<const void *>(static_cast<uintptr_t>(first_index) * get_index_size(index_type_));
+    }
+
+    GLint Mesh::get_base_vertex() const {
+        return arena_ ? static_cast<GLint>(arena_allocation_.base_vertex) : 0;
     }
 
     void Mesh::build() {
         create_mesh();
     }
 
+    void Mesh::recalculate_bounds() {
+        // The bounds of released vertices were computed before they went
+        if (cpu_data_released_) return;
+        set_bounds(MeshBounds::from_vertices(vertices));
+    }
+
+    bool Mesh::ensure_cpu_data() {
+        cpu_residency = CpuResidency::KEEP;
+        return reload_cpu_data();
+    }
+
+    bool Mesh::reload_cpu_data() {
+        if (!cpu_data_released_) return true;
+        if (source_path_.empty()) return false;
+
+        const std::shared_ptr<Mesh> source = MeshSerializer::load_cpu_data(source_path_);
+        // The file may have been reimported since, only take it if it still matches the uploaded data
+        if (!source || !matches_uploaded_data(*source)) {
+            std::cerr << "Mesh: Cannot read CPU data back from " << source_path_ << std::endl;
+            source_path_.clear(); // Don't try again every time it's needed
+            return false;
+        }
+
+        vertices = std::move(source->vertices);
+        indices = std::move(source->indices);
+        for (size_t lod = 0; lod < lods.size(); lod++) {
+            lods[lod].indices = std::move(source->lods[lod].indices);
+        }
+        cpu_data_released_ = false;
+        return true;
+    }
+
+    bool Mesh::matches_uploaded_data(const Mesh &source) const {
+        if (source.vertices.size() != uploaded_vertex_count_ || source.lods.size() != lods.size()) return false;
+        for (uint32_t lod = 0; lod < get_lod_count(); lod++) {
+            if (source.get_lod_index_count(lod) != lod_index_counts_[lod]) return false;
+        }
+        return true;
+    }
+
+    void Mesh::release_cpu_data() {
+        std::vector<Vertex>().swap(vertices);
+        std::vector<unsigned int>().swap(indices);
+        for (MeshLod &lod: lods) {
+            std::vector<unsigned int>().swap(lod.indices);
+        }
+        cpu_data_released_ = true;
+    }
+
     void Mesh::create_mesh() {
+        // Rebuilding, e.g. to move into dedicated buffers, needs the data again
+        if (!reload_cpu_data()) return;
+
+        if (!bounds_.is_valid()) {
+            recalculate_bounds();
+        }
+
+        // The LODs' indices follow the full mesh in the same index buffer
+        std::vector<unsigned int> lod_indices;
+        if (!lods.empty()) {
+            lod_indices.insert(lod_indices.end(), indices.begin(), indices.end());
+            for (uint32_t lod = 1; lod < get_lod_count(); lod++) {
+                lod_indices.insert(lod_indices.end(), lods[lod - 1].indices.begin(), lods[lod - 1].indices.end());
+            }
+        }
+        const std::vector<unsigned int> &gpu_indices = lods.empty() ? indices : lod_indices;
+
+        const std::vector<uint8_t> vertex_data = vertex_layout.encode(vertices, bounds_.aabb);
+        position_decode_ = vertex_layout.get_position_decode(bounds_.aabb);
+        index_type_ = select_index_type(vertices.size());
+
+        // Sub-allocate from the shared arena when the application provides one
+        GeometryArena *new_arena = nullptr;
+        GeometryAllocation new_allocation;
+        if (!dedicated_buffers_) {
+            if (auto *arena = ServiceLocator::get_service<GeometryArena>()) {
+                new_allocation = arena->allocate(vertex_layout, vertex_data, static_cast<uint32_t>(vertices.size()),
+                                                 gpu_indices, index_type_);
+                if (new_allocation.is_valid()) new_arena = arena;
+            }
+        }
+
+        if (!new_arena) {
+            create_dedicated_buffers(vertex_data, gpu_indices);
+        }
+
+        // The old allocation only goes once its replacement is built
+        release_arena_allocation();
+        if (new_arena) {
+            arena_ = new_arena;
+            arena_allocation_ = new_allocation;
+            vao_.reset();
+            vbo_.reset();
+            ibo_.reset();
+        }
+
+        uploaded_vertex_count_ = static_cast<uint32_t>(vertices.size());
+        lod_index_counts_.fill(0);
+        lod_index_counts_[0] = static_cast<uint32_t>(indices.size());
+        for (uint32_t lod = 1; lod < get_lod_count(); lod++) {
+            lod_index_counts_[lod] = static_cast<uint32_t>(lods[lod - 1].indices.size());
+        }
+
+        // Without a source file there is nothing to read the data back from
+        if (cpu_residency == CpuResidency::RELEASE_AFTER_UPLOAD && !source_path_.empty()) {
+            release_cpu_data();
+        }
+    }
+
+    void Mesh::create_dedicated_buffers(const std::vector<uint8_t> &vertex_data,
+                                        const std::vector<unsigned int> &gpu_indices) {
         vao_ = std::make_unique<VA>();
         vbo_ = std::make_unique<VB>();
         ibo_ = std::make_unique<IB>();
@@ -39,40 +204,16 @@ namespace hellfire {
         vao_->bind();
 
         vbo_->bind();
-        vbo_->pass_data(vertices);
+        vbo_->pass_data(vertex_data);
 
         ibo_->bind();
-        ibo_->pass_data(indices);
-
-        // Layout 0: Position
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                              reinterpret_cast<void *>(offsetof(Vertex, position)));
-
-        // Layout 1: Normal
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                              reinterpret_cast<void *>(offsetof(Vertex, normal)));
-
-        // Layout 2: Color 
-        glEnableVertexAttribArray(2);
-        glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                              reinterpret_cast<void *>(offsetof(Vertex, color)));
-
-        // Layout 3: texCoords (Uv's) 
-        glEnableVertexAttribArray(3);
-        glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                              reinterpret_cast<void *>(offsetof(Vertex, texCoords)));
-
-        // Layout 4: Tangent
-        glEnableVertexAttribArray(4);
-        glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                              reinterpret_cast<void *>(offsetof(Vertex, tangent)));
-
-        // Layout 5: Bi Tangent
-        glEnableVertexAttribArray(5);
-        glVertexAttribPointer(5, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                              reinterpret_cast<void *>(offsetof(Vertex, bitangent)));
+        const std::vector<uint8_t> index_data = pack_indices(gpu_indices, index_type_);
+        ibo_->pass_data(index_data);
+        GLStateCache::record_buffer_upload(vertex_data.size() + index_data.size());
+
+        // Layouts 0-5: position, normal, color, uv, tangent, bitangent in vertex_layout's formats
+        set_vertex_format(vertex_layout, 0);
+        glBindVertexBuffer(0, vbo_->get_id(), 0, vertex_layout.get_stride());
 
         // Unbind the buffers
         vao_->unbind();
@@ -81,19 +222,53 @@ namespace hellfire {
     }
 
     void Mesh::draw() const {
-        vao_->bind();
-        glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, nullptr);
-        vao_->unbind();
+        // The VAO stays bound, the state cache drops the rebind when the next draw uses it too
+        bind();
+        draw_elements();
+    }
+
+    void Mesh::draw_elements(const uint32_t lod) const {
+        glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(get_lod_index_count(lod)),
+                                 get_gl_index_type(index_type_), get_index_offset(lod), get_base_vertex());
     }
 
     void Mesh::draw_instanced(const size_t amount) const {
-        vao_->bind();
-        glDrawElementsInstanced(GL_TRIANGLES, get_index_count(),
-                                GL_UNSIGNED_INT, nullptr, amount);
-        vao_->unbind();
+        bind();
+        glDrawElementsInstancedBaseVertex(GL_TRIANGLES, get_index_count(), get_gl_index_type(index_type_),
+                                          get_index_offset(), static_cast<GLsizei>(amount), get_base_vertex());
+    }
+
+    void Mesh::draw_elements_instanced(const uint32_t amount, const uint32_t lod, const uint32_t base_instance) const {
+        glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES, static_cast<GLsizei>(get_lod_index_count(lod)),
+                                                      get_gl_index_type(index_type_), get_index_offset(lod),
+                                                      static_cast<GLsizei>(amount), get_base_vertex(), base_instance);
+    }
+
+    uint32_t Mesh::next_render_id() {
+        static std::atomic<uint32_t> counter{1};
+        return counter++;
     }
 
     int Mesh::get_index_count() const {
-        return indices.size();
+        return static_cast<int>(get_lod_index_count(0));
+    }
+
+    MeshOptimizationStats Mesh::optimize() {
+        return MeshOptimizer::optimize(vertices, indices, lods);
+    }
+
+    uint32_t Mesh::get_lod_index_count(const uint32_t lod) const {
+        if (lod >= get_lod_count()) return get_lod_index_count(0);
+        if (cpu_data_released_) return lod_index_counts_[lod];
+        return static_cast<uint32_t>(lod == 0 ? indices.size() : lods[lod - 1].indices.size());
+    }
+
+    uint32_t Mesh::get_lod_first_index(const uint32_t lod) const {
+        if (lod >= get_lod_count()) return 0;
+        uint32_t first_index = 0;
+        for (uint32_t i = 0; i < lod; i++) {
+            first_index += get_lod_index_count(i);
+        }
+        return first_index;
     }
 }
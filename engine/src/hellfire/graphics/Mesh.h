@@ -1,13 +1,26 @@
 #pragma once
+#include <array>
+#include <filesystem>
+#include "IndexType.h"
 #include "Vertex.h"
+#include "VertexLayout.h"
+#include "backends/opengl/GeometryArena.h"
 #include "backends/opengl/IB.h"
 #include "backends/opengl/VA.h"
 #include "backends/opengl/VB.h"
+#include "culling/BoundingVolume.h"
+#include "geometry/MeshOptimizer.h"
 #include "material/Material.h"
 
 namespace hellfire {
     class Mesh {
     public:
+        /// What build() does with vertices, indices and LOD indices once they are uploaded
+        enum class CpuResidency : uint8_t {
+            RELEASE_AFTER_UPLOAD, // Only for meshes with a source file, ensure_cpu_data() reads them back
+            KEEP // For CPU side users such as picking or collision
+        };
+
         Mesh();
 
         Mesh(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices);
@@ -16,6 +29,8 @@ namespace hellfire {
              const std::vector<unsigned int> &indices,
              bool defer_build);
 
+        ~Mesh();
+
         void cleanup();
 
         void bind() const;
@@ -23,27 +38,136 @@ namespace hellfire {
         void unbind() const;
 
         void build();
-        bool is_built() const { return  vao_ != nullptr; }
+        bool is_built() const { return  vao_ != nullptr || arena_ != nullptr; }
+
+        /**
+         * @brief Keep this mesh in its own VAO/VB/IB instead of the shared GeometryArena.
+         * Needed by callers that attach extra per-mesh vertex attributes to the VAO.
+         * @return false when the mesh stays in the arena, its released CPU data couldn't be read back
+         */
+        bool use_dedicated_buffers();
+
+        bool is_in_geometry_arena() const { return arena_ != nullptr; }
+        const GeometryAllocation &get_geometry_allocation() const { return arena_allocation_; }
 
-        // mesh data
+        /// VAO to bind for this mesh, shared by every mesh in the geometry arena
+        uint32_t get_vertex_array_id() const;
+
+        // mesh data, emptied by build() depending on cpu_residency
         std::vector<Vertex> vertices;
         std::vector<unsigned int> indices;
+        /// Simplified versions sharing the vertices, LOD 1 first; indices is LOD 0. Uploaded by build()
+        std::vector<MeshLod> lods;
+
+        /// GPU storage of vertices, applied by build(). Quantized positions need get_position_decode() in the model matrix
+        VertexLayout vertex_layout;
 
         bool is_wireframe = false;
 
+        CpuResidency cpu_residency = CpuResidency::RELEASE_AFTER_UPLOAD;
+
+        /// False once build() released the CPU copy, the GPU data and all counts stay valid
+        bool has_cpu_data() const { return !cpu_data_released_; }
+
+        /**
+         * @brief Read the CPU copy back from the source file if build() released it, and keep it from then on.
+         * @return False when the data is gone and can't be read back
+         */
+        bool ensure_cpu_data();
+
+        /// .hfmesh the mesh was loaded from, without one the CPU copy is never released
+        const std::filesystem::path &get_source_path() const { return source_path_; }
+        void set_source_path(const std::filesystem::path &path) { source_path_ = path; }
+
         void draw() const;
 
+        /// Issue the draw call only, the caller is responsible for binding this mesh's VAO.
+        void draw_elements(uint32_t lod = 0) const;
+
         void draw_instanced(size_t amount) const;
 
+        /**
+         * @brief Instanced draw call only, the caller is responsible for binding this mesh's VAO.
+         * @param base_instance First instance of the per-instance attributes to read
+         */
+        void draw_elements_instanced(uint32_t amount, uint32_t lod = 0, uint32_t base_instance = 0) const;
+
         int get_index_count() const;
 
+        uint32_t get_lod_count() const {
+            return 1 + static_cast<uint32_t>(std::min<size_t>(lods.size(), MAX_MESH_LODS - 1));
+        }
+        uint32_t get_lod_index_count(uint32_t lod) const;
+        /// Where a LOD's indices start within this mesh's index data, LOD 0 comes first
+        uint32_t get_lod_first_index(uint32_t lod) const;
+
+        /// Id used to group draws by mesh in render sort keys
+        uint32_t get_render_id() const { return render_id_; }
+
+        /// Local space bounds, computed by build() unless they were already set (e.g. loaded from .hfmesh)
+        const MeshBounds &get_bounds() const { return bounds_; }
+        void set_bounds(const MeshBounds &bounds) {
+            bounds_ = bounds;
+            ++bounds_version_;
+        }
+
+        /// GPU index width, picked by build() from the vertex count
+        IndexType get_index_type() const { return index_type_; }
+
+        /// Multiply onto the model matrix of every draw, maps the uploaded positions into mesh space
+        const glm::mat4 &get_position_decode() const { return position_decode_; }
+
+        /// Incremented whenever the bounds change
+        uint32_t get_bounds_version() const { return bounds_version_; }
+
+        /// Recompute the bounds from the current vertices, call after editing them
+        void recalculate_bounds();
+
+        /**
+         * @brief Reorder vertices and indices, LODs included, for the vertex cache, overdraw and vertex fetch.
+         * Only touches the CPU side data, so call it before build() or build() again afterwards.
+         */
+        MeshOptimizationStats optimize();
+
     private:
         std::unique_ptr<VA> vao_ = nullptr;
         std::unique_ptr<VB> vbo_ = nullptr;
         std::unique_ptr<IB> ibo_ = nullptr;
 
+        GeometryArena *arena_ = nullptr;
+        GeometryAllocation arena_allocation_;
+        bool dedicated_buffers_ = false;
+
         int index_count_;
+        uint32_t render_id_ = next_render_id();
+        MeshBounds bounds_;
+        uint32_t bounds_version_ = 0;
+        glm::mat4 position_decode_ = glm::mat4(1.0f);
+        IndexType index_type_ = IndexType::UINT32;
+        std::filesystem::path source_path_;
+        bool cpu_data_released_ = false;
+        std::array<uint32_t, MAX_MESH_LODS> lod_index_counts_{}; // Per LOD, kept for when the indices are released
+        uint32_t uploaded_vertex_count_ = 0; // Vertices in the GPU copy, data read back has to match it
+
+        /// Whether a mesh loaded from source_path_ holds the same data as the GPU copy
+        bool matches_uploaded_data(const Mesh &source) const;
+
+        static uint32_t next_render_id();
 
         void create_mesh();
+
+        void create_dedicated_buffers(const std::vector<uint8_t> &vertex_data,
+                                      const std::vector<unsigned int> &gpu_indices);
+
+        void release_cpu_data();
+
+        /// Read the released CPU copy back from source_path_
+        bool reload_cpu_data();
+
+        void release_arena_allocation();
+
+        /// Byte offset of a LOD's first index, and the base vertex to draw with (0 outside the arena)
+        const void *get_index_offset(uint32_t lod = 0) const;
+        GLint get_base_vertex() const;
     };
 }
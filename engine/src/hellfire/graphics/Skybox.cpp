@@ -8,14 +8,16 @@
 
 #include <stb_image.h>
 
+#include "hellfire/graphics/backends/opengl/GLStateCache.h"
+
 namespace hellfire {
     Skybox::~Skybox() {
-        if (cubemap_texture_ != 0) glDeleteTextures(1, &cubemap_texture_);
+        if (cubemap_texture_ != 0) GLStateCache::delete_textures(1, &cubemap_texture_);
     }
 
     void Skybox::set_cubemap_faces(const std::array<std::string, 6> &faces) {
         if (cubemap_texture_ != 0) {
-            glDeleteTextures(1, &cubemap_texture_);
+            GLStateCache::delete_textures(1, &cubemap_texture_);
         }
         cubemap_texture_ = load_cubemap(faces);
     }
@@ -23,7 +25,7 @@ namespace hellfire {
     uint32_t Skybox::load_cubemap(const std::array<std::string, 6> &faces) {
         uint32_t textureID;
         glGenTextures(1, &textureID);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+        GLStateCache::bind_texture(GL_TEXTURE_CUBE_MAP, textureID);
 
         stbi_set_flip_vertically_on_load(false);
         int width, height, nrChannels;
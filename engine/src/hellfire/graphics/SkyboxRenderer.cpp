@@ -9,9 +9,25 @@
 #include "../core/Application.h"
 #include <GL/glew.h>
 #include "Skybox.h"
+#include "hellfire/graphics/backends/opengl/GLStateCache.h"
 #include "hellfire/utilities/ServiceLocator.h"
 
 namespace hellfire {
+    namespace {
+        struct SkyboxUniformIds {
+            UniformID view = UniformTable::intern("view");
+            UniformID projection = UniformTable::intern("projection");
+            UniformID tint = UniformTable::intern("tint");
+            UniformID exposure = UniformTable::intern("exposure");
+            UniformID cubemap = UniformTable::intern("skyboxes");
+        };
+
+        const SkyboxUniformIds &skybox_uniform_ids() {
+            static const SkyboxUniformIds ids;
+            return ids;
+        }
+    }
+
     // skyboxes cube vertices
     float skyboxVertices[] = {
         // positions          
@@ -60,11 +76,11 @@ namespace hellfire {
 
     SkyboxRenderer::~SkyboxRenderer() {
         if (skybox_vao_ != 0)
-            glDeleteVertexArrays(1, &skybox_vao_);
+            GLStateCache::delete_vertex_arrays(1, &skybox_vao_);
         if (skybox_vbo_ != 0)
-            glDeleteBuffers(1, &skybox_vbo_);
-        if (skybox_shader_ != 0)
-            glDeleteProgram(skybox_shader_);
+            GLStateCache::delete_buffers(1, &skybox_vbo_);
+        if (skybox_program_ != 0)
+            GLStateCache::delete_program(skybox_program_);
     }
 
     void SkyboxRenderer::initialize() {
@@ -78,51 +94,49 @@ namespace hellfire {
         glGenVertexArrays(1, &skybox_vao_);
         glGenBuffers(1, &skybox_vbo_);
 
-        glBindVertexArray(skybox_vao_);
-        glBindBuffer(GL_ARRAY_BUFFER, skybox_vbo_);
+        GLStateCache::bind_vertex_array(skybox_vao_);
+        GLStateCache::bind_buffer(GL_ARRAY_BUFFER, skybox_vbo_);
         glBufferData(GL_ARRAY_BUFFER, sizeof(skyboxVertices), &skyboxVertices, GL_STATIC_DRAW);
 
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), static_cast<void *>(nullptr));
 
-        glBindVertexArray(0);
+        GLStateCache::bind_vertex_array(0);
     }
 
     void SkyboxRenderer::load_skybox_shader() {
-        skybox_shader_ = ServiceLocator::get_service<ShaderManager>()->load_shader_from_files(
-            "assets/shaders/skybox.vert", "assets/shaders/skybox.frag");
+        auto *shader_manager = ServiceLocator::get_service<ShaderManager>();
+        skybox_program_ = shader_manager->load_shader_from_files("assets/shaders/skybox.vert",
+                                                                 "assets/shaders/skybox.frag");
+        skybox_shader_ = Shader(skybox_program_, shader_manager->get_uniform_table(skybox_program_));
     }
 
     void SkyboxRenderer::render(const Skybox &skybox, const CameraComponent *camera) const {
         if (!skybox.is_loaded()) return;
 
-        // Save current depth state
-        glDepthFunc(GL_LEQUAL);
+        // Skybox sits at the far plane
+        GLStateCache::depth_func(GL_LEQUAL);
 
-        glUseProgram(skybox_shader_);
+        const auto &uniforms = skybox_uniform_ids();
+        skybox_shader_.use();
 
         // Remove translation from view matrix
-        glm::mat4 view = glm::mat4(glm::mat3(camera->get_view_matrix()));
-        glm::mat4 projection = camera->get_projection_matrix();
-
-        glUniformMatrix4fv(glGetUniformLocation(skybox_shader_, "view"), 1, GL_FALSE, glm::value_ptr(view));
-        glUniformMatrix4fv(glGetUniformLocation(skybox_shader_, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+        skybox_shader_.set_mat4(uniforms.view, glm::mat4(glm::mat3(camera->get_view_matrix())));
+        skybox_shader_.set_mat4(uniforms.projection, camera->get_projection_matrix());
 
         // Set tint and exposure
-        glUniform3fv(glGetUniformLocation(skybox_shader_, "tint"), 1, glm::value_ptr(skybox.get_tint()));
-        glUniform1f(glGetUniformLocation(skybox_shader_, "exposure"), skybox.get_exposure());
+        skybox_shader_.set_vec3(uniforms.tint, skybox.get_tint());
+        skybox_shader_.set_float(uniforms.exposure, skybox.get_exposure());
 
         // Bind cubemap
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, skybox.get_cubemap());
-        glUniform1i(glGetUniformLocation(skybox_shader_, "skyboxes"), 0);
+        GLStateCache::bind_texture_unit(0, GL_TEXTURE_CUBE_MAP, skybox.get_cubemap());
+        skybox_shader_.set_int(uniforms.cubemap, 0);
 
         // Draw skyboxes cube
-        glBindVertexArray(skybox_vao_);
+        GLStateCache::bind_vertex_array(skybox_vao_);
         glDrawArrays(GL_TRIANGLES, 0, 36);
-        glBindVertexArray(0);
 
         // Restore depth state
-        glDepthFunc(GL_LESS);
+        GLStateCache::depth_func(GL_LESS);
     }
 }
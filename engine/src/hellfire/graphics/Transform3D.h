@@ -130,13 +130,21 @@ namespace hellfire {
         }
 
         void update_world_matrix(const glm::mat4& parent_world_matrix) {
-                world_matrix_ = parent_world_matrix * local_matrix_;
+            const glm::mat4 world_matrix = parent_world_matrix * local_matrix_;
+            if (world_matrix != world_matrix_) {
+                world_matrix_ = world_matrix;
+                ++world_version_;
+            }
         }
 
+        /// Incremented whenever the world matrix changes, lets caches derived from it (e.g. world bounds) detect staleness
+        uint32_t get_world_version() const { return world_version_; }
+
         // Reset matrices to identity - useful for initialization
         void reset_to_identity() {
             local_matrix_ = glm::mat4(1.0f);
             world_matrix_ = glm::mat4(1.0f);
+            ++world_version_;
             // Reset transform components
             position_ = glm::vec3(0.0f);
             scale_ = glm::vec3(1.0f);
@@ -162,6 +170,7 @@ namespace hellfire {
 
         glm::mat4 local_matrix_; // Local transform matrix
         glm::mat4 world_matrix_; // World transform matrix
+        uint32_t world_version_ = 1;
 
         // Transform matrices for direct manipulation
         glm::mat4 rotation_matrix_;
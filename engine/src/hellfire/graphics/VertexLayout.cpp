@@ -0,0 +1,157 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include "VertexLayout.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
+
+namespace hellfire {
+    static_assert(sizeof(Vertex) == 68, "The full layout copies Vertex as is");
+
+    namespace {
+        uint32_t position_size(const VertexLayout &layout) {
+            return layout.has(VertexLayout::QUANTIZED_POSITIONS) ? 4 * sizeof(uint16_t) : 3 * sizeof(float);
+        }
+
+        uint32_t direction_size(const VertexLayout &layout) {
+            return layout.has(VertexLayout::PACKED_NORMALS) ? sizeof(uint32_t) : 3 * sizeof(float);
+        }
+
+        uint32_t color_size(const VertexLayout &layout) {
+            if (layout.has(VertexLayout::NO_COLORS)) return 0;
+            return layout.has(VertexLayout::PACKED_COLORS) ? 4 * sizeof(uint8_t) : 3 * sizeof(float);
+        }
+
+        uint32_t uv_size(const VertexLayout &layout) {
+            return layout.has(VertexLayout::HALF_UVS) ? 2 * sizeof(uint16_t) : 2 * sizeof(float);
+        }
+
+        /// Largest axis of the bounds, quantization uses it for all three to keep the decode a uniform scale
+        float quantization_extent(const AABB &bounds) {
+            if (!bounds.is_valid()) return 1.0f;
+            const glm::vec3 size = bounds.max - bounds.min;
+            const float extent = std::max({size.x, size.y, size.z});
+            return extent > 0.0f ? extent : 1.0f;
+        }
+
+        uint32_t pack_snorm_10_10_10_2(const glm::vec3 &v, const float w) {
+            const auto pack = [](const float value, const float max, const uint32_t mask) {
+                return static_cast<uint32_t>(static_cast<int32_t>(std::round(std::clamp(value, -1.0f, 1.0f) * max))) &
+                       mask;
+            };
+            return pack(v.x, 511.0f, 0x3FF) | pack(v.y, 511.0f, 0x3FF) << 10 | pack(v.z, 511.0f, 0x3FF) << 20 |
+                   pack(w, 1.0f, 0x3) << 30;
+        }
+
+        glm::vec3 safe_normalize(const glm::vec3 &v) {
+            const float length = glm::length(v);
+            return length > 0.0f ? v / length : v;
+        }
+
+        template<typename T>
+        void write(uint8_t *&out, const T &value) {
+            std::memcpy(out, &value, sizeof(T));
+            out += sizeof(T);
+        }
+    }
+
+    uint32_t VertexLayout::get_stride() const {
+        const uint32_t bitangent_size = has(PACKED_NORMALS) ? 0 : 3 * sizeof(float);
+        return position_size(*this) + direction_size(*this) * 2 + color_size(*this) + uv_size(*this) + bitangent_size;
+    }
+
+    uint32_t VertexLayout::get_attributes(VertexAttributeFormat (&formats)[MAX_ATTRIBUTES]) const {
+        using Type = VertexAttributeFormat::Type;
+        const bool packed_normals = has(PACKED_NORMALS);
+        const Type direction_type = packed_normals ? Type::SNORM_10_10_10_2 : Type::FLOAT;
+        const int32_t direction_components = packed_normals ? 4 : 3;
+
+        uint32_t count = 0;
+        uint32_t offset = 0;
+        const auto add = [&](const uint32_t location, const int32_t components, const Type type, const uint32_t size) {
+            formats[count++] = {location, components, type, offset};
+            offset += size;
+        };
+
+        add(0, has(QUANTIZED_POSITIONS) ? 4 : 3, has(QUANTIZED_POSITIONS) ? Type::UNORM16 : Type::FLOAT,
+            position_size(*this));
+        add(1, direction_components, direction_type, direction_size(*this));
+        if (!has(NO_COLORS)) {
+            add(2, has(PACKED_COLORS) ? 4 : 3, has(PACKED_COLORS) ? Type::UNORM8 : Type::FLOAT, color_size(*this));
+        }
+        add(3, 2, has(HALF_UVS) ? Type::HALF_FLOAT : Type::FLOAT, uv_size(*this));
+        add(4, direction_components, direction_type, direction_size(*this));
+        if (!packed_normals) {
+            add(5, 3, Type::FLOAT, 3 * sizeof(float));
+        }
+        return count;
+    }
+
+    glm::mat4 VertexLayout::get_position_decode(const AABB &bounds) const {
+        if (!has(QUANTIZED_POSITIONS) || !bounds.is_valid()) return glm::mat4(1.0f);
+        return glm::scale(glm::translate(glm::mat4(1.0f), bounds.min), glm::vec3(quantization_extent(bounds)));
+    }
+
+    std::vector<uint8_t> VertexLayout::encode(const std::vector<Vertex> &vertices, const AABB &bounds) const {
+        std::vector<uint8_t> data(static_cast<size_t>(get_stride()) * vertices.size());
+        if (attributes == 0) {
+            if (!vertices.empty()) std::memcpy(data.data(), vertices.data(), data.size());
+            return data;
+        }
+
+        const glm::vec3 origin = bounds.is_valid() ? bounds.min : glm::vec3(0.0f);
+        const float inverse_extent = 1.0f / quantization_extent(bounds);
+
+        uint8_t *out = data.data();
+        for (const Vertex &vertex: vertices) {
+            if (has(QUANTIZED_POSITIONS)) {
+                const glm::vec3 unit = glm::clamp((vertex.position - origin) * inverse_extent, 0.0f, 1.0f);
+                for (int axis = 0; axis < 3; axis++) {
+                    write(out, static_cast<uint16_t>(unit[axis] * 65535.0f + 0.5f));
+                }
+                write(out, uint16_t{0});
+            } else {
+                write(out, vertex.position);
+            }
+
+            const glm::vec3 normal = safe_normalize(vertex.normal);
+            const glm::vec3 tangent = safe_normalize(vertex.tangent);
+            if (has(PACKED_NORMALS)) {
+                write(out, pack_snorm_10_10_10_2(normal, 0.0f));
+            } else {
+                write(out, vertex.normal);
+            }
+
+            if (has(PACKED_COLORS)) {
+                for (int channel = 0; channel < 3; channel++) {
+                    write(out, static_cast<uint8_t>(std::clamp(vertex.color[channel], 0.0f, 1.0f) * 255.0f + 0.5f));
+                }
+                write(out, uint8_t{255});
+            } else if (!has(NO_COLORS)) {
+                write(out, vertex.color);
+            }
+
+            if (has(HALF_UVS)) {
+                write(out, glm::packHalf1x16(vertex.texCoords.x));
+                write(out, glm::packHalf1x16(vertex.texCoords.y));
+            } else {
+                write(out, vertex.texCoords);
+            }
+
+            if (has(PACKED_NORMALS)) {
+                // Mirrored UVs flip the bitangent, the shader rebuilds it as cross(N, T) * w
+                const float sign = glm::dot(glm::cross(normal, tangent), vertex.bitangent) < 0.0f ? -1.0f : 1.0f;
+                write(out, pack_snorm_10_10_10_2(tangent, sign));
+            } else {
+                write(out, vertex.tangent);
+                write(out, vertex.bitangent);
+            }
+        }
+        return data;
+    }
+}
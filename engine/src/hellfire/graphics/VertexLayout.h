@@ -0,0 +1,74 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Vertex.h"
+#include "culling/BoundingVolume.h"
+
+namespace hellfire {
+    /// One vertex attribute as stored in a packed vertex buffer
+    struct VertexAttributeFormat {
+        enum class Type : uint8_t {
+            FLOAT,
+            HALF_FLOAT,
+            UNORM16, // Read as [0, 1]
+            UNORM8, // Read as [0, 1]
+            SNORM_10_10_10_2 // Read as [-1, 1], w only holds -1, 0 or 1
+        };
+
+        uint32_t location;
+        int32_t components;
+        Type type;
+        uint32_t offset;
+    };
+
+    /**
+     * @brief How a mesh's vertices are stored on the GPU, the CPU side always keeps full Vertex data.
+     *
+     * Every packed format is one the vertex fetch expands by itself, so shaders keep reading
+     * vec3 positions, normals and colors. Quantized positions are the exception: they come in
+     * as [0, 1] over the mesh bounds and get_position_decode() has to be folded into the
+     * model matrix. The decode scales all axes alike, so normal matrices stay valid.
+     */
+    struct VertexLayout {
+        enum Attributes : uint32_t {
+            QUANTIZED_POSITIONS = 1 << 0, // 16 bits per axis over the mesh bounds
+            PACKED_NORMALS = 1 << 1, // Normal and tangent as 10:10:10:2 snorm, bitangent sign in tangent.w
+            HALF_UVS = 1 << 2,
+            PACKED_COLORS = 1 << 3, // 8 bits per channel, clamped to [0, 1]
+            NO_COLORS = 1 << 4, // Left out, the color attribute reads white
+        };
+
+        static constexpr uint32_t MAX_ATTRIBUTES = 6;
+
+        uint32_t attributes = 0;
+
+        /// Same 68 bytes as Vertex
+        static VertexLayout full() { return {}; }
+
+        /// 24 bytes, 20 without colors
+        static VertexLayout compact(const bool colors = true) {
+            return {QUANTIZED_POSITIONS | PACKED_NORMALS | HALF_UVS | (colors ? PACKED_COLORS : NO_COLORS)};
+        }
+
+        bool has(const Attributes attribute) const { return (attributes & attribute) != 0; }
+
+        bool operator==(const VertexLayout &other) const { return attributes == other.attributes; }
+        bool operator!=(const VertexLayout &other) const { return attributes != other.attributes; }
+
+        uint32_t get_stride() const;
+
+        /// Attribute locations match Vertex: 0 position, 1 normal, 2 color, 3 uv, 4 tangent, 5 bitangent
+        uint32_t get_attributes(VertexAttributeFormat (&formats)[MAX_ATTRIBUTES]) const;
+
+        /// Maps quantized positions back into mesh space, identity for float positions
+        glm::mat4 get_position_decode(const AABB &bounds) const;
+
+        /// Pack vertices into get_stride() bytes each, positions quantized against bounds
+        std::vector<uint8_t> encode(const std::vector<Vertex> &vertices, const AABB &bounds) const;
+    };
+}
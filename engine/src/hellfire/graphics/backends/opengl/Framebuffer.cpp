@@ -6,6 +6,8 @@
 #include <iostream>
 #include <GL/glew.h>
 
+#include "GLStateCache.h"
+
 namespace hellfire {
     Framebuffer::Framebuffer() : framebuffer_id_(0), depth_attachment_(0), stencil_attachment_(0) {
         create_framebuffer();
@@ -16,11 +18,11 @@ namespace hellfire {
     }
 
     void Framebuffer::attach_color_texture(const FrameBufferAttachmentSettings &settings) {
-        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_id_);
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, framebuffer_id_);
 
         uint32_t texture;
         glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
+        GLStateCache::bind_texture(GL_TEXTURE_2D, texture);
 
         // Allocate texture storage
         glTexImage2D(GL_TEXTURE_2D, 0, settings.internal_format,
@@ -41,14 +43,14 @@ namespace hellfire {
         color_settings_.push_back(settings);
 
         // Update draw buffers
-        std::vector<GLenum> draw_buffers;
+        draw_buffers_.clear();
         for (size_t i = 0; i < color_attachments_.size(); i++) {
-            draw_buffers.push_back(GL_COLOR_ATTACHMENT0 + i);
+            draw_buffers_.push_back(GL_COLOR_ATTACHMENT0 + i);
         }
-        glDrawBuffers(draw_buffers.size(), draw_buffers.data());
+        glDrawBuffers(draw_buffers_.size(), draw_buffers_.data());
 
-        glBindTexture(GL_TEXTURE_2D, 0);
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GLStateCache::bind_texture(GL_TEXTURE_2D, 0);
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, 0);
     }
 
     void Framebuffer::attach_texture_by_id(const uint32_t texture_id, GLenum attachment = GL_COLOR_ATTACHMENT0, GLenum target = GL_FRAMEBUFFER) {
@@ -63,10 +65,10 @@ namespace hellfire {
             return;
         }
 
-        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_id_);
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, framebuffer_id_);
 
         glGenTextures(1, &depth_attachment_);
-        glBindTexture(GL_TEXTURE_2D, depth_attachment_);
+        GLStateCache::bind_texture(GL_TEXTURE_2D, depth_attachment_);
 
         // Override format settings for depth texture
         const GLenum internal_format = settings.internal_format == GL_RGBA8
@@ -90,8 +92,8 @@ namespace hellfire {
         glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depth_attachment_, 0);
 
         // Unbind texture & framebuffer
-        glBindTexture(GL_TEXTURE_2D, 0);
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GLStateCache::bind_texture(GL_TEXTURE_2D, 0);
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, 0);
 
         depth_settings_ = settings; 
         has_depth_ = true;
@@ -103,10 +105,10 @@ namespace hellfire {
             return;
         }
 
-        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_id_);
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, framebuffer_id_);
 
         glGenTextures(1, &stencil_attachment_);
-        glBindTexture(GL_TEXTURE_2D, stencil_attachment_);
+        GLStateCache::bind_texture(GL_TEXTURE_2D, stencil_attachment_);
 
         // Override format settings for stencil texture
         constexpr GLenum internal_format = GL_STENCIL_INDEX8;
@@ -124,25 +126,34 @@ namespace hellfire {
 
         glFramebufferTexture2D(GL_FRAMEBUFFER, GL_STENCIL_ATTACHMENT, GL_TEXTURE_2D, stencil_attachment_, 0);
 
-        glBindTexture(GL_TEXTURE_2D, 0);
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GLStateCache::bind_texture(GL_TEXTURE_2D, 0);
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, 0);
 
         stencil_settings_ = settings;  // Store the settings
         has_stencil_ = true;
     }
 
 
+    void Framebuffer::set_draw_buffers(const std::vector<GLenum> &draw_buffers) {
+        // Draw buffer selection is framebuffer object state, so this only has to happen on a change
+        if (draw_buffers == draw_buffers_) return;
+
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, framebuffer_id_);
+        glDrawBuffers(static_cast<GLsizei>(draw_buffers.size()), draw_buffers.data());
+        draw_buffers_ = draw_buffers;
+    }
+
     void Framebuffer::bind() const {
-        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_id_);
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, framebuffer_id_);
 
         // Set viewport based on first color attachment if it exists
         if (!color_settings_.empty()) {
-            glViewport(0, 0, color_settings_[0].width, color_settings_[0].height);
+            GLStateCache::viewport(0, 0, color_settings_[0].width, color_settings_[0].height);
         }
     }
 
     void Framebuffer::unbind() {
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, 0);
     }
 
     void Framebuffer::resize(const uint32_t width, const uint32_t height) {
@@ -151,6 +162,7 @@ namespace hellfire {
         bool had_stencil = stencil_attachment_ != 0;
         
         std::vector<FrameBufferAttachmentSettings> old_color_settings = color_settings_;
+        const std::vector<GLenum> old_draw_buffers = draw_buffers_;
         FrameBufferAttachmentSettings old_depth_settings = depth_settings_;
         FrameBufferAttachmentSettings old_stencil_settings = stencil_settings_;
 
@@ -179,6 +191,9 @@ namespace hellfire {
             attach_stencil_texture(old_stencil_settings);
         }
 
+        set_draw_buffers(old_draw_buffers);
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, 0);
+
         if (!is_complete()) {
             std::cerr << "Framebuffer incomplete after resize!" << std::endl;
         }
@@ -207,9 +222,9 @@ namespace hellfire {
     
 
     bool Framebuffer::is_complete() const {
-        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_id_);
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, framebuffer_id_);
         const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, 0);
 
         if (status != GL_FRAMEBUFFER_COMPLETE) {
             std::cerr << "Framebuffer not complete! Status: ";
@@ -253,20 +268,20 @@ namespace hellfire {
 
     void Framebuffer::cleanup() {
         if (!color_attachments_.empty()) {
-            glDeleteTextures(static_cast<GLsizei>(color_attachments_.size()), color_attachments_.data());
+            GLStateCache::delete_textures(static_cast<GLsizei>(color_attachments_.size()), color_attachments_.data());
             color_attachments_.clear();
             color_settings_.clear();
         }
         if (depth_attachment_) {
-            glDeleteTextures(1, &depth_attachment_);
+            GLStateCache::delete_textures(1, &depth_attachment_);
             depth_attachment_ = 0;
         }
         if (stencil_attachment_) {
-            glDeleteTextures(1, &stencil_attachment_);
+            GLStateCache::delete_textures(1, &stencil_attachment_);
             stencil_attachment_ = 0;
         }
         if (framebuffer_id_) {
-            glDeleteFramebuffers(1, &framebuffer_id_);
+            GLStateCache::delete_framebuffers(1, &framebuffer_id_);
             framebuffer_id_ = 0;
         }
     }
@@ -40,6 +40,11 @@ namespace hellfire {
 
         void attach_stencil_texture(const FrameBufferAttachmentSettings &settings = {});
 
+        /**
+         * @brief Select the attachments fragment outputs go to, entry i receives output location i.
+         * Attaching a color texture resets this to every color attachment; resize() keeps it.
+         */
+        void set_draw_buffers(const std::vector<GLenum> &draw_buffers);
 
         Framebuffer(const Framebuffer &) = delete;
 
@@ -53,6 +58,7 @@ namespace hellfire {
 
         /**
          * @brief Reads a pixel from an external texture using this framebuffer
+         * Waits for the GPU to finish all queued work, see PixelReadback for reads that don't stall
          * @param texture_id Texture to read from
          * @param x X coordinate
          * @param y Y coordinate
@@ -85,6 +91,7 @@ namespace hellfire {
         uint32_t depth_attachment_;
         uint32_t stencil_attachment_;
         std::vector<FrameBufferAttachmentSettings> color_settings_;
+        std::vector<GLenum> draw_buffers_;
         FrameBufferAttachmentSettings depth_settings_;
         FrameBufferAttachmentSettings stencil_settings_;
         bool has_depth_ = false;
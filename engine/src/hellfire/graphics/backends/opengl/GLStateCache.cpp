@@ -0,0 +1,423 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include "GLStateCache.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace hellfire {
+    GLStateCache::State &GLStateCache::get_state() {
+        static State state = [] {
+            State initial{};
+            forget_all(initial);
+            return initial;
+        }();
+        return state;
+    }
+
+    void GLStateCache::invalidate() {
+        forget_all(get_state());
+    }
+
+    void GLStateCache::forget_all(State &state) {
+        state.program = UNKNOWN;
+        state.vertex_array = UNKNOWN;
+        std::fill(std::begin(state.buffers), std::end(state.buffers), UNKNOWN);
+        std::fill(std::begin(state.uniform_bases), std::end(state.uniform_bases), UNKNOWN);
+        std::fill(std::begin(state.storage_bases), std::end(state.storage_bases), UNKNOWN);
+        state.draw_framebuffer = UNKNOWN;
+        state.read_framebuffer = UNKNOWN;
+
+        state.active_texture_unit = UNKNOWN;
+        for (auto &unit: state.textures) {
+            std::fill(std::begin(unit), std::end(unit), UNKNOWN);
+        }
+        std::fill(std::begin(state.samplers), std::end(state.samplers), UNKNOWN);
+
+        std::fill(std::begin(state.capabilities), std::end(state.capabilities), FLAG_UNKNOWN);
+        std::fill(std::begin(state.blend_per_buffer), std::end(state.blend_per_buffer), FLAG_UNKNOWN);
+
+        state.depth_func = UNKNOWN;
+        state.depth_mask = FLAG_UNKNOWN;
+        state.color_mask = FLAG_UNKNOWN;
+        state.cull_face = UNKNOWN;
+        state.front_face = UNKNOWN;
+        state.blend_source = UNKNOWN;
+        state.blend_destination = UNKNOWN;
+        state.has_polygon_offset = false;
+        state.stencil_func = UNKNOWN;
+        state.stencil_fail = UNKNOWN;
+        state.has_stencil_mask = false;
+        state.has_viewport = false;
+        state.has_scissor = false;
+    }
+
+    uint32_t GLStateCache::get_buffer_slot(const GLenum target) {
+        switch (target) {
+            case GL_ARRAY_BUFFER: return BUFFER_ARRAY;
+            case GL_ELEMENT_ARRAY_BUFFER: return BUFFER_ELEMENT_ARRAY;
+            case GL_UNIFORM_BUFFER: return BUFFER_UNIFORM;
+            case GL_SHADER_STORAGE_BUFFER: return BUFFER_SHADER_STORAGE;
+            case GL_DRAW_INDIRECT_BUFFER: return BUFFER_DRAW_INDIRECT;
+            case GL_COPY_READ_BUFFER: return BUFFER_COPY_READ;
+            case GL_COPY_WRITE_BUFFER: return BUFFER_COPY_WRITE;
+            case GL_PIXEL_PACK_BUFFER: return BUFFER_PIXEL_PACK;
+            case GL_PIXEL_UNPACK_BUFFER: return BUFFER_PIXEL_UNPACK;
+            default: return UNKNOWN;
+        }
+    }
+
+    uint32_t GLStateCache::get_texture_slot(const GLenum target) {
+        switch (target) {
+            case GL_TEXTURE_2D: return TEXTURE_SLOT_2D;
+            case GL_TEXTURE_CUBE_MAP: return TEXTURE_SLOT_CUBE_MAP;
+            case GL_TEXTURE_2D_ARRAY: return TEXTURE_SLOT_2D_ARRAY;
+            default: return UNKNOWN;
+        }
+    }
+
+    uint32_t GLStateCache::get_capability_slot(const GLenum capability) {
+        switch (capability) {
+            case GL_DEPTH_TEST: return CAP_DEPTH_TEST;
+            case GL_CULL_FACE: return CAP_CULL_FACE;
+            case GL_BLEND: return CAP_BLEND;
+            case GL_STENCIL_TEST: return CAP_STENCIL_TEST;
+            case GL_SCISSOR_TEST: return CAP_SCISSOR_TEST;
+            case GL_POLYGON_OFFSET_FILL: return CAP_POLYGON_OFFSET_FILL;
+            case GL_MULTISAMPLE: return CAP_MULTISAMPLE;
+            case GL_FRAMEBUFFER_SRGB: return CAP_FRAMEBUFFER_SRGB;
+            case GL_TEXTURE_CUBE_MAP_SEAMLESS: return CAP_TEXTURE_CUBE_MAP_SEAMLESS;
+            default: return UNKNOWN;
+        }
+    }
+
+    void GLStateCache::use_program(const uint32_t program) {
+        State &state = get_state();
+        if (!should_emit(state.program != program)) return;
+
+        glUseProgram(program);
+        state.program = program;
+        ++state.stats.program_binds;
+    }
+
+    void GLStateCache::bind_vertex_array(const uint32_t vertex_array) {
+        State &state = get_state();
+        if (!should_emit(state.vertex_array != vertex_array)) return;
+
+        glBindVertexArray(vertex_array);
+        state.vertex_array = vertex_array;
+        ++state.stats.vertex_array_binds;
+        // The element array binding belongs to the VAO we just switched to
+        state.buffers[BUFFER_ELEMENT_ARRAY] = UNKNOWN;
+    }
+
+    void GLStateCache::bind_buffer(const GLenum target, const uint32_t buffer) {
+        State &state = get_state();
+        const uint32_t slot = get_buffer_slot(target);
+        if (!should_emit(slot == UNKNOWN || state.buffers[slot] != buffer)) return;
+
+        glBindBuffer(target, buffer);
+        if (slot != UNKNOWN) state.buffers[slot] = buffer;
+    }
+
+    void GLStateCache::bind_buffer_base(const GLenum target, const uint32_t index, const uint32_t buffer) {
+        State &state = get_state();
+
+        uint32_t *bases = nullptr;
+        if (index < MAX_INDEXED_BUFFER_BINDINGS) {
+            if (target == GL_UNIFORM_BUFFER) bases = state.uniform_bases;
+            else if (target == GL_SHADER_STORAGE_BUFFER) bases = state.storage_bases;
+        }
+
+        if (!should_emit(!bases || bases[index] != buffer)) return;
+
+        glBindBufferBase(target, index, buffer);
+        if (bases) bases[index] = buffer;
+        if (const uint32_t slot = get_buffer_slot(target); slot != UNKNOWN) state.buffers[slot] = buffer;
+    }
+
+    void GLStateCache::bind_framebuffer(const GLenum target, const uint32_t framebuffer) {
+        State &state = get_state();
+        const bool draw = target == GL_FRAMEBUFFER || target == GL_DRAW_FRAMEBUFFER;
+        const bool read = target == GL_FRAMEBUFFER || target == GL_READ_FRAMEBUFFER;
+        const bool changed = (draw && state.draw_framebuffer != framebuffer) ||
+                             (read && state.read_framebuffer != framebuffer);
+        if (!should_emit(changed)) return;
+
+        glBindFramebuffer(target, framebuffer);
+        if (draw) state.draw_framebuffer = framebuffer;
+        if (read) state.read_framebuffer = framebuffer;
+    }
+
+    void GLStateCache::active_texture(const uint32_t unit) {
+        State &state = get_state();
+        if (!should_emit(state.active_texture_unit != unit)) return;
+
+        glActiveTexture(GL_TEXTURE0 + unit);
+        state.active_texture_unit = unit;
+    }
+
+    void GLStateCache::bind_texture(const GLenum target, const uint32_t texture) {
+        State &state = get_state();
+        // Otherwise we couldn't tell which unit's binding the call replaces
+        if (state.active_texture_unit == UNKNOWN) active_texture(0);
+
+        const uint32_t unit = state.active_texture_unit;
+        const uint32_t slot = get_texture_slot(target);
+        const bool tracked = unit < MAX_TEXTURE_UNITS && slot != UNKNOWN;
+        if (!should_emit(!tracked || state.textures[unit][slot] != texture)) return;
+
+        glBindTexture(target, texture);
+        if (tracked) state.textures[unit][slot] = texture;
+        ++state.stats.texture_binds;
+    }
+
+    void GLStateCache::bind_texture_unit(const uint32_t unit, const GLenum target, const uint32_t texture) {
+        State &state = get_state();
+        const uint32_t slot = get_texture_slot(target);
+        if (unit < MAX_TEXTURE_UNITS && slot != UNKNOWN && state.textures[unit][slot] == texture) {
+            should_emit(false);
+            return;
+        }
+
+        active_texture(unit);
+        bind_texture(target, texture);
+    }
+
+    void GLStateCache::bind_sampler(const uint32_t unit, const uint32_t sampler) {
+        State &state = get_state();
+        const bool tracked = unit < MAX_TEXTURE_UNITS;
+        if (!should_emit(!tracked || state.samplers[unit] != sampler)) return;
+
+        glBindSampler(unit, sampler);
+        if (tracked) state.samplers[unit] = sampler;
+    }
+
+    void GLStateCache::set_enabled(const GLenum capability, const bool enabled) {
+        State &state = get_state();
+        const uint32_t slot = get_capability_slot(capability);
+        const Flag flag = enabled ? FLAG_ON : FLAG_OFF;
+        if (!should_emit(slot == UNKNOWN || state.capabilities[slot] != flag)) return;
+
+        if (enabled) {
+            glEnable(capability);
+        } else {
+            glDisable(capability);
+        }
+
+        if (slot != UNKNOWN) state.capabilities[slot] = flag;
+        // The non-indexed call sets every draw buffer at once
+        if (capability == GL_BLEND) {
+            std::fill(std::begin(state.blend_per_buffer), std::end(state.blend_per_buffer), flag);
+        }
+    }
+
+    void GLStateCache::set_enabled_indexed(const GLenum capability, const uint32_t index, const bool enabled) {
+        State &state = get_state();
+        const bool tracked = capability == GL_BLEND && index < MAX_DRAW_BUFFERS;
+        const Flag flag = enabled ? FLAG_ON : FLAG_OFF;
+        if (!should_emit(!tracked || state.blend_per_buffer[index] != flag)) return;
+
+        if (enabled) {
+            glEnablei(capability, index);
+        } else {
+            glDisablei(capability, index);
+        }
+
+        if (tracked) state.blend_per_buffer[index] = flag;
+        // Draw buffers may now disagree, so the next glEnable/glDisable must always go through
+        if (const uint32_t slot = get_capability_slot(capability); slot != UNKNOWN) {
+            state.capabilities[slot] = FLAG_UNKNOWN;
+        }
+    }
+
+    void GLStateCache::depth_func(const GLenum func) {
+        State &state = get_state();
+        if (!should_emit(state.depth_func != func)) return;
+
+        glDepthFunc(func);
+        state.depth_func = func;
+    }
+
+    void GLStateCache::depth_mask(const bool write) {
+        State &state = get_state();
+        const Flag flag = write ? FLAG_ON : FLAG_OFF;
+        if (!should_emit(state.depth_mask != flag)) return;
+
+        glDepthMask(write ? GL_TRUE : GL_FALSE);
+        state.depth_mask = flag;
+    }
+
+    void GLStateCache::color_mask(const bool write) {
+        State &state = get_state();
+        const Flag flag = write ? FLAG_ON : FLAG_OFF;
+        if (!should_emit(state.color_mask != flag)) return;
+
+        const GLboolean value = write ? GL_TRUE : GL_FALSE;
+        glColorMask(value, value, value, value);
+        state.color_mask = flag;
+    }
+
+    void GLStateCache::cull_face(const GLenum mode) {
+        State &state = get_state();
+        if (!should_emit(state.cull_face != mode)) return;
+
+        glCullFace(mode);
+        state.cull_face = mode;
+    }
+
+    void GLStateCache::front_face(const GLenum mode) {
+        State &state = get_state();
+        if (!should_emit(state.front_face != mode)) return;
+
+        glFrontFace(mode);
+        state.front_face = mode;
+    }
+
+    void GLStateCache::blend_func(const GLenum source, const GLenum destination) {
+        State &state = get_state();
+        if (!should_emit(state.blend_source != source || state.blend_destination != destination)) return;
+
+        glBlendFunc(source, destination);
+        state.blend_source = source;
+        state.blend_destination = destination;
+    }
+
+    void GLStateCache::blend_func_indexed(const uint32_t index, const GLenum source, const GLenum destination) {
+        State &state = get_state();
+        should_emit(true);
+
+        glBlendFunci(index, source, destination);
+        state.blend_source = UNKNOWN;
+        state.blend_destination = UNKNOWN;
+    }
+
+    void GLStateCache::polygon_offset(const float factor, const float units) {
+        State &state = get_state();
+        if (!should_emit(!state.has_polygon_offset || state.polygon_offset_factor != factor ||
+                         state.polygon_offset_units != units)) return;
+
+        glPolygonOffset(factor, units);
+        state.polygon_offset_factor = factor;
+        state.polygon_offset_units = units;
+        state.has_polygon_offset = true;
+    }
+
+    void GLStateCache::stencil_func(const GLenum func, const GLint reference, const GLuint mask) {
+        State &state = get_state();
+        if (!should_emit(state.stencil_func != func || state.stencil_reference != reference ||
+                         state.stencil_func_mask != mask)) return;
+
+        glStencilFunc(func, reference, mask);
+        state.stencil_func = func;
+        state.stencil_reference = reference;
+        state.stencil_func_mask = mask;
+    }
+
+    void GLStateCache::stencil_op(const GLenum stencil_fail, const GLenum depth_fail, const GLenum depth_pass) {
+        State &state = get_state();
+        if (!should_emit(state.stencil_fail != stencil_fail || state.stencil_depth_fail != depth_fail ||
+                         state.stencil_depth_pass != depth_pass)) return;
+
+        glStencilOp(stencil_fail, depth_fail, depth_pass);
+        state.stencil_fail = stencil_fail;
+        state.stencil_depth_fail = depth_fail;
+        state.stencil_depth_pass = depth_pass;
+    }
+
+    void GLStateCache::stencil_mask(const GLuint mask) {
+        State &state = get_state();
+        if (!should_emit(!state.has_stencil_mask || state.stencil_write_mask != mask)) return;
+
+        glStencilMask(mask);
+        state.stencil_write_mask = mask;
+        state.has_stencil_mask = true;
+    }
+
+    void GLStateCache::viewport(const GLint x, const GLint y, const GLsizei width, const GLsizei height) {
+        State &state = get_state();
+        if (!should_emit(!state.has_viewport || state.viewport[0] != x || state.viewport[1] != y ||
+                         state.viewport[2] != width || state.viewport[3] != height)) return;
+
+        glViewport(x, y, width, height);
+        state.viewport[0] = x;
+        state.viewport[1] = y;
+        state.viewport[2] = width;
+        state.viewport[3] = height;
+        state.has_viewport = true;
+    }
+
+    void GLStateCache::scissor(const GLint x, const GLint y, const GLsizei width, const GLsizei height) {
+        State &state = get_state();
+        if (!should_emit(!state.has_scissor || state.scissor[0] != x || state.scissor[1] != y ||
+                         state.scissor[2] != width || state.scissor[3] != height)) return;
+
+        glScissor(x, y, width, height);
+        state.scissor[0] = x;
+        state.scissor[1] = y;
+        state.scissor[2] = width;
+        state.scissor[3] = height;
+        state.has_scissor = true;
+    }
+
+    void GLStateCache::delete_program(const uint32_t program) {
+        if (program == 0) return;
+        glDeleteProgram(program);
+
+        // A program in use stays current until another one is installed, so only forget the name
+        State &state = get_state();
+        if (state.program == program) state.program = UNKNOWN;
+    }
+
+    void GLStateCache::delete_vertex_arrays(const GLsizei count, const uint32_t *vertex_arrays) {
+        glDeleteVertexArrays(count, vertex_arrays);
+
+        State &state = get_state();
+        for (GLsizei i = 0; i < count; i++) {
+            if (vertex_arrays[i] != 0 && state.vertex_array == vertex_arrays[i]) {
+                state.vertex_array = 0;
+                state.buffers[BUFFER_ELEMENT_ARRAY] = 0;
+            }
+        }
+    }
+
+    void GLStateCache::delete_buffers(const GLsizei count, const uint32_t *buffers) {
+        glDeleteBuffers(count, buffers);
+
+        State &state = get_state();
+        for (GLsizei i = 0; i < count; i++) {
+            const uint32_t buffer = buffers[i];
+            if (buffer == 0) continue;
+
+            std::replace(std::begin(state.buffers), std::end(state.buffers), buffer, 0u);
+            std::replace(std::begin(state.uniform_bases), std::end(state.uniform_bases), buffer, 0u);
+            std::replace(std::begin(state.storage_bases), std::end(state.storage_bases), buffer, 0u);
+        }
+    }
+
+    void GLStateCache::delete_textures(const GLsizei count, const uint32_t *textures) {
+        glDeleteTextures(count, textures);
+
+        State &state = get_state();
+        for (GLsizei i = 0; i < count; i++) {
+            if (textures[i] == 0) continue;
+
+            for (auto &unit: state.textures) {
+                std::replace(std::begin(unit), std::end(unit), textures[i], 0u);
+            }
+        }
+    }
+
+    void GLStateCache::delete_framebuffers(const GLsizei count, const uint32_t *framebuffers) {
+        glDeleteFramebuffers(count, framebuffers);
+
+        State &state = get_state();
+        for (GLsizei i = 0; i < count; i++) {
+            if (framebuffers[i] == 0) continue;
+
+            if (state.draw_framebuffer == framebuffers[i]) state.draw_framebuffer = 0;
+            if (state.read_framebuffer == framebuffers[i]) state.read_framebuffer = 0;
+        }
+    }
+}
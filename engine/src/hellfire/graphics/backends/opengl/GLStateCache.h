@@ -0,0 +1,206 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "GL/glew.h"
+
+namespace hellfire {
+    /// Calls forwarded to GL vs. dropped because they would not change state, reset with GLStateCache::reset_stats()
+    struct GLStateStats {
+        uint32_t emitted = 0;
+        uint32_t skipped = 0;
+
+        // Binds that reached GL, included in emitted
+        uint32_t program_binds = 0;
+        uint32_t vertex_array_binds = 0;
+        uint32_t texture_binds = 0;
+
+        uint64_t buffer_bytes_uploaded = 0; // Reported through record_buffer_upload()
+    };
+
+    /**
+     * @brief Shadow copy of the GL context state the engine touches.
+     *
+     * Every bind, enable and fixed-function setter goes through here and is only forwarded
+     * to GL when the value actually changes. This only works if nothing else changes the same
+     * state behind the cache's back: code outside the engine (e.g. ImGui) must be followed by
+     * invalidate(), and objects must be deleted through the delete_* helpers so a recycled name
+     * is never mistaken for one that is still bound.
+     *
+     * The element array binding is part of the VAO, so it is forgotten whenever the VAO changes.
+     */
+    class GLStateCache {
+    public:
+        static constexpr uint32_t MAX_TEXTURE_UNITS = 32;
+        static constexpr uint32_t MAX_INDEXED_BUFFER_BINDINGS = 16;
+        static constexpr uint32_t MAX_DRAW_BUFFERS = 8;
+
+        /// Forget everything, the next call of every kind is forwarded to GL
+        static void invalidate();
+
+        // Objects
+        static void use_program(uint32_t program);
+        static void bind_vertex_array(uint32_t vertex_array);
+        static void bind_buffer(GLenum target, uint32_t buffer);
+        /// Indexed uniform/storage binding, also binds the buffer to the generic target like GL does
+        static void bind_buffer_base(GLenum target, uint32_t index, uint32_t buffer);
+        static void bind_framebuffer(GLenum target, uint32_t framebuffer);
+
+        // Textures
+        static void active_texture(uint32_t unit);
+        /// Bind to the active texture unit (e.g. to upload data)
+        static void bind_texture(GLenum target, uint32_t texture);
+        /// Bind to a specific texture unit, switching the active unit only when needed
+        static void bind_texture_unit(uint32_t unit, GLenum target, uint32_t texture);
+        static void bind_sampler(uint32_t unit, uint32_t sampler);
+
+        // Capabilities
+        static void set_enabled(GLenum capability, bool enabled);
+        static void enable(const GLenum capability) { set_enabled(capability, true); }
+        static void disable(const GLenum capability) { set_enabled(capability, false); }
+        /// Per draw buffer capability (GL_BLEND)
+        static void set_enabled_indexed(GLenum capability, uint32_t index, bool enabled);
+
+        // Fixed function state
+        static void depth_func(GLenum func);
+        static void depth_mask(bool write);
+        /// All channels of every draw buffer at once
+        static void color_mask(bool write);
+        static void cull_face(GLenum mode);
+        static void front_face(GLenum mode);
+        static void blend_func(GLenum source, GLenum destination);
+        /// Blend function of one draw buffer, not cached: the next blend_func() always reaches GL afterwards
+        static void blend_func_indexed(uint32_t index, GLenum source, GLenum destination);
+        static void polygon_offset(float factor, float units);
+        static void stencil_func(GLenum func, GLint reference, GLuint mask);
+        static void stencil_op(GLenum stencil_fail, GLenum depth_fail, GLenum depth_pass);
+        static void stencil_mask(GLuint mask);
+        static void viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+        static void scissor(GLint x, GLint y, GLsizei width, GLsizei height);
+
+        // Deletion, clears every binding of the deleted names like GL does
+        static void delete_program(uint32_t program);
+        static void delete_vertex_arrays(GLsizei count, const uint32_t *vertex_arrays);
+        static void delete_buffers(GLsizei count, const uint32_t *buffers);
+        static void delete_textures(GLsizei count, const uint32_t *textures);
+        static void delete_framebuffers(GLsizei count, const uint32_t *framebuffers);
+
+        static uint32_t get_program() { return get_state().program; }
+        static uint32_t get_vertex_array() { return get_state().vertex_array; }
+
+        /// Count bytes written to a buffer object, the cache does not see glBufferData/glBufferSubData itself
+        static void record_buffer_upload(const size_t bytes) { get_state().stats.buffer_bytes_uploaded += bytes; }
+
+        static const GLStateStats &get_stats() { return get_state().stats; }
+        static void reset_stats() { get_state().stats = {}; }
+
+    private:
+        static constexpr uint32_t UNKNOWN = 0xFFFFFFFFu;
+
+        enum BufferSlot : uint32_t {
+            BUFFER_ARRAY,
+            BUFFER_ELEMENT_ARRAY,
+            BUFFER_UNIFORM,
+            BUFFER_SHADER_STORAGE,
+            BUFFER_DRAW_INDIRECT,
+            BUFFER_COPY_READ,
+            BUFFER_COPY_WRITE,
+            BUFFER_PIXEL_PACK,
+            BUFFER_PIXEL_UNPACK,
+            BUFFER_SLOT_COUNT
+        };
+
+        enum TextureSlot : uint32_t {
+            TEXTURE_SLOT_2D,
+            TEXTURE_SLOT_CUBE_MAP,
+            TEXTURE_SLOT_2D_ARRAY,
+            TEXTURE_SLOT_COUNT
+        };
+
+        enum CapabilitySlot : uint32_t {
+            CAP_DEPTH_TEST,
+            CAP_CULL_FACE,
+            CAP_BLEND,
+            CAP_STENCIL_TEST,
+            CAP_SCISSOR_TEST,
+            CAP_POLYGON_OFFSET_FILL,
+            CAP_MULTISAMPLE,
+            CAP_FRAMEBUFFER_SRGB,
+            CAP_TEXTURE_CUBE_MAP_SEAMLESS,
+            CAP_SLOT_COUNT
+        };
+
+        // Tri-state for booleans that start out unknown
+        enum Flag : uint8_t {
+            FLAG_UNKNOWN,
+            FLAG_OFF,
+            FLAG_ON
+        };
+
+        struct State {
+            uint32_t program;
+            uint32_t vertex_array;
+            uint32_t buffers[BUFFER_SLOT_COUNT];
+            uint32_t uniform_bases[MAX_INDEXED_BUFFER_BINDINGS];
+            uint32_t storage_bases[MAX_INDEXED_BUFFER_BINDINGS];
+            uint32_t draw_framebuffer;
+            uint32_t read_framebuffer;
+
+            uint32_t active_texture_unit;
+            uint32_t textures[MAX_TEXTURE_UNITS][TEXTURE_SLOT_COUNT];
+            uint32_t samplers[MAX_TEXTURE_UNITS];
+
+            Flag capabilities[CAP_SLOT_COUNT];
+            Flag blend_per_buffer[MAX_DRAW_BUFFERS];
+
+            GLenum depth_func;
+            Flag depth_mask;
+            Flag color_mask;
+            GLenum cull_face;
+            GLenum front_face;
+            GLenum blend_source;
+            GLenum blend_destination;
+            float polygon_offset_factor;
+            float polygon_offset_units;
+            bool has_polygon_offset;
+            GLenum stencil_func;
+            GLint stencil_reference;
+            GLuint stencil_func_mask;
+            GLenum stencil_fail;
+            GLenum stencil_depth_fail;
+            GLenum stencil_depth_pass;
+            GLuint stencil_write_mask;
+            bool has_stencil_mask;
+            GLint viewport[4];
+            bool has_viewport;
+            GLint scissor[4];
+            bool has_scissor;
+
+            GLStateStats stats;
+        };
+
+        static State &get_state();
+
+        /// Mark every piece of state unknown, keeping the stats
+        static void forget_all(State &state);
+
+        static uint32_t get_buffer_slot(GLenum target);
+        static uint32_t get_texture_slot(GLenum target);
+        static uint32_t get_capability_slot(GLenum capability);
+
+        /// Record a call, returns true when it has to reach GL
+        static bool should_emit(bool changed) {
+            State &state = get_state();
+            if (changed) {
+                ++state.stats.emitted;
+            } else {
+                ++state.stats.skipped;
+            }
+            return changed;
+        }
+    };
+}
@@ -0,0 +1,103 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include "GPUTimer.h"
+
+#include <algorithm>
+
+namespace hellfire {
+    GPUTimer::~GPUTimer() {
+        for (FrameQueries &frame: frames_) {
+            if (!frame.queries.empty()) {
+                glDeleteQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+            }
+        }
+    }
+
+    void GPUTimer::begin_frame() {
+        frame_++;
+        FrameQueries &frame = frames_[frame_ % FRAME_LATENCY];
+        collect(frame);
+
+        frame.used = 0;
+        frame.scopes.clear();
+        open_scopes_.clear();
+        recording_ = enabled_;
+    }
+
+    void GPUTimer::begin(const std::string &pass) {
+        if (!recording_) return;
+
+        FrameQueries &frame = frames_[frame_ % FRAME_LATENCY];
+        const uint32_t depth = static_cast<uint32_t>(open_scopes_.size());
+        const uint32_t pass_index = get_pass_index(pass);
+        passes_[pass_index].depth = depth;
+
+        open_scopes_.push_back(static_cast<uint32_t>(frame.scopes.size()));
+        frame.scopes.push_back({pass_index, depth, issue_timestamp(frame), 0});
+    }
+
+    void GPUTimer::end() {
+        if (!recording_ || open_scopes_.empty()) return;
+
+        FrameQueries &frame = frames_[frame_ % FRAME_LATENCY];
+        frame.scopes[open_scopes_.back()].end_query = issue_timestamp(frame);
+        open_scopes_.pop_back();
+    }
+
+    const GPUPassTiming *GPUTimer::find_pass(const std::string &name) const {
+        const auto it = pass_indices_.find(name);
+        return it != pass_indices_.end() ? &passes_[it->second] : nullptr;
+    }
+
+    uint32_t GPUTimer::get_pass_index(const std::string &pass) {
+        const auto [it, inserted] = pass_indices_.try_emplace(pass, static_cast<uint32_t>(passes_.size()));
+        if (inserted) {
+            passes_.push_back({pass, 0, TimingHistory()});
+        }
+        return it->second;
+    }
+
+    uint32_t GPUTimer::issue_timestamp(FrameQueries &frame) {
+        if (frame.used == frame.queries.size()) {
+            GLuint query = 0;
+            glGenQueries(1, &query);
+            frame.queries.push_back(query);
+        }
+        glQueryCounter(frame.queries[frame.used], GL_TIMESTAMP);
+        return frame.used++;
+    }
+
+    void GPUTimer::collect(FrameQueries &frame) {
+        if (frame.used == 0) return;
+
+        // Queries complete in order, so the last one being ready means they all are
+        GLint available = GL_FALSE;
+        glGetQueryObjectiv(frame.queries[frame.used - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available != GL_TRUE) {
+            frames_dropped_++;
+            return;
+        }
+
+        results_.resize(frame.used);
+        for (uint32_t i = 0; i < frame.used; i++) {
+            glGetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT, &results_[i]);
+        }
+        // A pass timed more than once in a frame gets one sample, the sum of its scopes
+        pass_totals_.assign(passes_.size(), -1.0);
+        double frame_total = 0.0;
+        for (const RecordedScope &scope: frame.scopes) {
+            // Scopes still open at the end of the frame have no end timestamp
+            if (scope.end_query == 0) continue;
+            const double elapsed = static_cast<double>(results_[scope.end_query] - results_[scope.begin_query]) / 1.0e6;
+            double &total = pass_totals_[scope.pass_index];
+            total = std::max(total, 0.0) + elapsed;
+            if (scope.depth == 0) frame_total += elapsed;
+        }
+        for (size_t pass = 0; pass < passes_.size(); pass++) {
+            if (pass_totals_[pass] >= 0.0) passes_[pass].history.add(static_cast<float>(pass_totals_[pass]));
+        }
+        frame_history_.add(static_cast<float>(frame_total));
+        frames_collected_++;
+    }
+}
@@ -0,0 +1,114 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "GL/glew.h"
+#include "hellfire/core/TimingHistory.h"
+
+namespace hellfire {
+    /// GPU time of one named pass over the last frames
+    struct GPUPassTiming {
+        std::string name;
+        uint32_t depth = 0; // Nesting level of the scope it was measured in, 0 for top level passes
+        TimingHistory history;
+    };
+
+    /**
+     * @brief Measures GPU time per pass with timestamp queries, without ever waiting on the GPU.
+     *
+     * Each frame records its scopes into one of FRAME_LATENCY query sets. A set is only read back
+     * when the frame using it comes around again, by which time the GPU is normally done with it;
+     * if it isn't, that frame's timings are dropped rather than stalling. Timestamps instead of
+     * GL_TIME_ELAPSED let scopes nest, e.g. each shadow casting light inside the shadow pass.
+     */
+    class GPUTimer {
+    public:
+        static constexpr uint32_t FRAME_LATENCY = 4;
+
+        GPUTimer() = default;
+
+        ~GPUTimer();
+
+        GPUTimer(const GPUTimer &) = delete;
+
+        GPUTimer &operator=(const GPUTimer &) = delete;
+
+        /// Collect the timings of the frame whose query set is about to be reused, then start recording into it
+        void begin_frame();
+
+        void begin(const std::string &pass);
+
+        void end();
+
+        /// Times the passes issued during its lifetime
+        class Scope {
+        public:
+            Scope(GPUTimer &timer, const std::string &pass) : timer_(timer) { timer_.begin(pass); }
+            ~Scope() { timer_.end(); }
+
+            Scope(const Scope &) = delete;
+
+            Scope &operator=(const Scope &) = delete;
+
+        private:
+            GPUTimer &timer_;
+        };
+
+        void set_enabled(const bool enabled) { enabled_ = enabled; }
+        bool is_enabled() const { return enabled_; }
+
+        /// Every pass measured so far, in the order they were first seen
+        const std::vector<GPUPassTiming> &get_passes() const { return passes_; }
+
+        /// Timing of a pass by name, nullptr when it was never measured
+        const GPUPassTiming *find_pass(const std::string &name) const;
+
+        /// GPU time of whole frames, the sum of each frame's top level scopes
+        const TimingHistory &get_frame_history() const { return frame_history_; }
+
+        /// Frames added to the histories so far, tells a new sample from the previous one
+        uint64_t get_frames_collected() const { return frames_collected_; }
+
+        /// Frames whose queries were not ready FRAME_LATENCY frames later and were skipped
+        uint32_t get_frames_dropped() const { return frames_dropped_; }
+
+    private:
+        struct RecordedScope {
+            uint32_t pass_index;
+            uint32_t depth;
+            uint32_t begin_query; // Index into FrameQueries::queries
+            uint32_t end_query;
+        };
+
+        struct FrameQueries {
+            std::vector<GLuint> queries; // Grown on demand and reused, only the first `used` hold this frame's data
+            uint32_t used = 0;
+            std::vector<RecordedScope> scopes;
+        };
+
+        FrameQueries frames_[FRAME_LATENCY];
+        uint32_t frame_ = 0;
+        bool recording_ = false;
+        std::vector<uint32_t> open_scopes_; // Indices into the current frame's scopes
+        std::vector<GPUPassTiming> passes_;
+        std::unordered_map<std::string, uint32_t> pass_indices_;
+        std::vector<GLuint64> results_;
+        std::vector<double> pass_totals_; // Milliseconds per pass in the frame being collected, -1 when not timed
+        TimingHistory frame_history_;
+        uint64_t frames_collected_ = 0;
+        uint32_t frames_dropped_ = 0;
+        bool enabled_ = true;
+
+        uint32_t get_pass_index(const std::string &pass);
+
+        uint32_t issue_timestamp(FrameQueries &frame);
+
+        void collect(FrameQueries &frame);
+    };
+}
@@ -0,0 +1,275 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include "GeometryArena.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <numeric>
+
+#include "GLStateCache.h"
+#include "VertexFormat.h"
+
+namespace hellfire {
+    GeometryArena::GeometryArena(const uint32_t vertex_capacity, const uint32_t index_capacity)
+        : initial_vertex_capacity_(vertex_capacity) {
+        for (size_t type = 0; type < INDEX_TYPE_COUNT; type++) {
+            IndexPool &indices = index_pools_[type];
+            indices.ranges.grow(index_capacity);
+            indices.buffer = resize_buffer(0, 0, static_cast<size_t>(index_capacity) *
+                                                 get_index_size(static_cast<IndexType>(type)));
+        }
+        get_pool(VertexLayout::full());
+        ensure_instance_capacity(1024);
+    }
+
+    GeometryArena::~GeometryArena() {
+        for (VertexPool &pool: pools_) {
+            for (GLuint &vao: pool.vaos) {
+                if (vao) GLStateCache::delete_vertex_arrays(1, &vao);
+            }
+            if (pool.vertex_buffer) GLStateCache::delete_buffers(1, &pool.vertex_buffer);
+        }
+        for (IndexPool &indices: index_pools_) {
+            if (indices.buffer) GLStateCache::delete_buffers(1, &indices.buffer);
+        }
+        if (instance_index_buffer_) GLStateCache::delete_buffers(1, &instance_index_buffer_);
+    }
+
+    uint32_t GeometryArena::get_pool(const VertexLayout &layout) {
+        for (uint32_t pool = 0; pool < pools_.size(); pool++) {
+            if (pools_[pool].layout == layout) return pool;
+        }
+
+        // The first pool gets the configured capacity, later ones start smaller and grow on demand
+        const uint32_t capacity = pools_.empty() ? initial_vertex_capacity_ : initial_vertex_capacity_ / 8;
+        VertexPool &pool = pools_.emplace_back();
+        pool.layout = layout;
+        pool.ranges.grow(capacity);
+        pool.vertex_buffer = resize_buffer(0, 0, static_cast<size_t>(capacity) * layout.get_stride());
+        glGenVertexArrays(INDEX_TYPE_COUNT, pool.vaos);
+        for (size_t type = 0; type < INDEX_TYPE_COUNT; type++) {
+            setup_vertex_format(pool, static_cast<IndexType>(type));
+        }
+        return static_cast<uint32_t>(pools_.size() - 1);
+    }
+
+    void GeometryArena::setup_vertex_format(const VertexPool &pool, const IndexType index_type) const {
+        const auto type = static_cast<size_t>(index_type);
+        GLStateCache::bind_vertex_array(pool.vaos[type]);
+
+        // Same attribute layout as a dedicated Mesh VAO of this layout
+        set_vertex_format(pool.layout, VERTEX_BUFFER_BINDING);
+        glBindVertexBuffer(VERTEX_BUFFER_BINDING, pool.vertex_buffer, 0, pool.layout.get_stride());
+
+        glEnableVertexAttribArray(INSTANCE_INDEX_LOCATION);
+        glVertexAttribIFormat(INSTANCE_INDEX_LOCATION, 1, GL_UNSIGNED_INT, 0);
+        glVertexAttribBinding(INSTANCE_INDEX_LOCATION, INSTANCE_BUFFER_BINDING);
+        glVertexBindingDivisor(INSTANCE_BUFFER_BINDING, 1);
+        if (instance_index_buffer_) {
+            glBindVertexBuffer(INSTANCE_BUFFER_BINDING, instance_index_buffer_, 0, sizeof(uint32_t));
+        }
+
+        GLStateCache::bind_buffer(GL_ELEMENT_ARRAY_BUFFER, index_pools_[type].buffer);
+        GLStateCache::bind_vertex_array(0);
+    }
+
+    GeometryAllocation GeometryArena::allocate(const VertexLayout &layout, const std::vector<uint8_t> &vertex_data,
+                                               const uint32_t vertex_count, const std::vector<unsigned int> &indices,
+                                               const IndexType index_type) {
+        GeometryAllocation allocation;
+        if (vertex_count == 0) return allocation;
+        if (index_type == IndexType::UINT16 && vertex_count > MAX_UINT16_INDEXED_VERTICES) {
+            std::cerr << "GeometryArena: " << vertex_count << " vertices can't use 16 bit indices" << std::endl;
+            return allocation;
+        }
+
+        const auto index_count = static_cast<uint32_t>(indices.size());
+        const uint32_t stride = layout.get_stride();
+        const auto type = static_cast<size_t>(index_type);
+        const uint32_t index_size = get_index_size(index_type);
+        IndexPool &index_pool = index_pools_[type];
+
+        allocation.pool = get_pool(layout);
+        VertexPool &pool = pools_[allocation.pool];
+        const GLuint old_vertex_buffer = pool.vertex_buffer;
+        allocation.base_vertex = allocate_range(pool.ranges, vertex_count, pool.vertex_buffer, stride);
+        allocation.vertex_count = vertex_count;
+        const GLuint old_index_buffer = index_pool.buffer;
+        allocation.first_index = index_count > 0
+                                     ? allocate_range(index_pool.ranges, index_count, index_pool.buffer, index_size)
+                                     : 0;
+        allocation.index_count = index_count;
+        allocation.index_type = index_type;
+        if (allocation.base_vertex == RangeAllocator::INVALID_OFFSET ||
+            allocation.first_index == RangeAllocator::INVALID_OFFSET) {
+            if (allocation.base_vertex != RangeAllocator::INVALID_OFFSET) {
+                pool.ranges.free(allocation.base_vertex, vertex_count);
+            }
+            if (index_count > 0 && allocation.first_index != RangeAllocator::INVALID_OFFSET) {
+                index_pool.ranges.free(allocation.first_index, index_count);
+            }
+            return {};
+        }
+
+        // Point the VAOs at grown storage
+        if (pool.vertex_buffer != old_vertex_buffer) {
+            for (const GLuint vao: pool.vaos) {
+                GLStateCache::bind_vertex_array(vao);
+                glBindVertexBuffer(VERTEX_BUFFER_BINDING, pool.vertex_buffer, 0, stride);
+            }
+            GLStateCache::bind_vertex_array(0);
+        }
+        if (index_pool.buffer != old_index_buffer) {
+            for (const VertexPool &other: pools_) {
+                GLStateCache::bind_vertex_array(other.vaos[type]);
+                GLStateCache::bind_buffer(GL_ELEMENT_ARRAY_BUFFER, index_pool.buffer);
+            }
+            GLStateCache::bind_vertex_array(0);
+        }
+
+        GLStateCache::bind_buffer(GL_ARRAY_BUFFER, pool.vertex_buffer);
+        glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(allocation.base_vertex) * stride,
+                        static_cast<GLsizeiptr>(vertex_count) * stride, vertex_data.data());
+        GLStateCache::bind_buffer(GL_ARRAY_BUFFER, 0);
+        GLStateCache::record_buffer_upload(static_cast<size_t>(vertex_count) * stride);
+
+        if (index_count > 0) {
+            // Indices stay mesh relative, draws add the base vertex
+            const std::vector<uint8_t> index_data = pack_indices(indices, index_type);
+            GLStateCache::bind_buffer(GL_COPY_WRITE_BUFFER, index_pool.buffer);
+            glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(allocation.first_index) * index_size,
+                            static_cast<GLsizeiptr>(index_data.size()), index_data.data());
+            GLStateCache::bind_buffer(GL_COPY_WRITE_BUFFER, 0);
+            GLStateCache::record_buffer_upload(index_data.size());
+        }
+
+        return allocation;
+    }
+
+    void GeometryArena::free(GeometryAllocation &allocation) {
+        if (!allocation.is_valid()) return;
+
+        pools_[allocation.pool].ranges.free(allocation.base_vertex, allocation.vertex_count);
+        if (allocation.index_count > 0) {
+            index_pools_[static_cast<size_t>(allocation.index_type)].ranges.free(allocation.first_index,
+                                                                                  allocation.index_count);
+        }
+        allocation = {};
+    }
+
+    void GeometryArena::bind(const uint32_t pool, const IndexType index_type) const {
+        GLStateCache::bind_vertex_array(get_vertex_array_id(pool, index_type));
+    }
+
+    void GeometryArena::unbind() const {
+        GLStateCache::bind_vertex_array(0);
+    }
+
+    void GeometryArena::ensure_instance_capacity(const uint32_t count) {
+        if (count <= instance_capacity_) return;
+
+        const uint32_t new_capacity = std::max(count, instance_capacity_ * 2);
+        std::vector<uint32_t> identity(new_capacity);
+        std::iota(identity.begin(), identity.end(), 0u);
+
+        if (!instance_index_buffer_) glGenBuffers(1, &instance_index_buffer_);
+        GLStateCache::bind_buffer(GL_ARRAY_BUFFER, instance_index_buffer_);
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(identity.size() * sizeof(uint32_t)), identity.data(),
+                     GL_STATIC_DRAW);
+        GLStateCache::bind_buffer(GL_ARRAY_BUFFER, 0);
+        instance_capacity_ = new_capacity;
+
+        for (const VertexPool &pool: pools_) {
+            for (const GLuint vao: pool.vaos) {
+                GLStateCache::bind_vertex_array(vao);
+                glBindVertexBuffer(INSTANCE_BUFFER_BINDING, instance_index_buffer_, 0, sizeof(uint32_t));
+            }
+        }
+        GLStateCache::bind_vertex_array(0);
+    }
+
+    uint32_t GeometryArena::get_used_vertices() const {
+        uint32_t used = 0;
+        for (const VertexPool &pool: pools_) used += pool.ranges.get_used();
+        return used;
+    }
+
+    uint32_t GeometryArena::get_vertex_capacity() const {
+        uint32_t capacity = 0;
+        for (const VertexPool &pool: pools_) capacity += pool.ranges.get_capacity();
+        return capacity;
+    }
+
+    uint64_t GeometryArena::get_used_vertex_bytes() const {
+        uint64_t bytes = 0;
+        for (const VertexPool &pool: pools_) {
+            bytes += static_cast<uint64_t>(pool.ranges.get_used()) * pool.layout.get_stride();
+        }
+        return bytes;
+    }
+
+    uint32_t GeometryArena::get_used_indices() const {
+        uint32_t used = 0;
+        for (const IndexPool &indices: index_pools_) used += indices.ranges.get_used();
+        return used;
+    }
+
+    uint32_t GeometryArena::get_index_capacity() const {
+        uint32_t capacity = 0;
+        for (const IndexPool &indices: index_pools_) capacity += indices.ranges.get_capacity();
+        return capacity;
+    }
+
+    uint64_t GeometryArena::get_used_index_bytes() const {
+        uint64_t bytes = 0;
+        for (size_t type = 0; type < INDEX_TYPE_COUNT; type++) {
+            bytes += static_cast<uint64_t>(index_pools_[type].ranges.get_used()) *
+                    get_index_size(static_cast<IndexType>(type));
+        }
+        return bytes;
+    }
+
+    uint32_t GeometryArena::allocate_range(RangeAllocator &ranges, const uint32_t count, GLuint &buffer,
+                                           const size_t element_size) {
+        uint32_t offset = ranges.allocate(count);
+        if (offset != RangeAllocator::INVALID_OFFSET) return offset;
+
+        // Out of space: double until it fits, keeping existing ranges where they are
+        const uint32_t old_capacity = ranges.get_capacity();
+        uint32_t new_capacity = std::max(old_capacity, 1u);
+        while (new_capacity < old_capacity + count) {
+            new_capacity *= 2;
+        }
+
+        buffer = resize_buffer(buffer, old_capacity * element_size, new_capacity * element_size);
+        ranges.grow(new_capacity);
+
+        offset = ranges.allocate(count);
+        if (offset == RangeAllocator::INVALID_OFFSET) {
+            std::cerr << "GeometryArena: Failed to allocate " << count << " elements" << std::endl;
+        }
+        return offset;
+    }
+
+    GLuint GeometryArena::resize_buffer(const GLuint buffer, const size_t old_bytes, const size_t new_bytes) {
+        GLuint new_buffer = 0;
+        glGenBuffers(1, &new_buffer);
+        GLStateCache::bind_buffer(GL_COPY_WRITE_BUFFER, new_buffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(new_bytes), nullptr, GL_STATIC_DRAW);
+
+        if (buffer != 0) {
+            if (old_bytes > 0) {
+                GLStateCache::bind_buffer(GL_COPY_READ_BUFFER, buffer);
+                glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0,
+                                    static_cast<GLsizeiptr>(old_bytes));
+                GLStateCache::bind_buffer(GL_COPY_READ_BUFFER, 0);
+            }
+            GLStateCache::delete_buffers(1, &buffer);
+        }
+
+        GLStateCache::bind_buffer(GL_COPY_WRITE_BUFFER, 0);
+        return new_buffer;
+    }
+}
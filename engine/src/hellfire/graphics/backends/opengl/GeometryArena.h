@@ -0,0 +1,124 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "GL/glew.h"
+#include "hellfire/graphics/IndexType.h"
+#include "hellfire/graphics/VertexLayout.h"
+#include "hellfire/graphics/geometry/RangeAllocator.h"
+
+namespace hellfire {
+    /// Location of a mesh inside the GeometryArena buffers
+    struct GeometryAllocation {
+        uint32_t base_vertex = RangeAllocator::INVALID_OFFSET;
+        uint32_t vertex_count = 0;
+        uint32_t first_index = RangeAllocator::INVALID_OFFSET;
+        uint32_t index_count = 0;
+        uint32_t pool = 0; // Vertex pool of the mesh's layout
+        IndexType index_type = IndexType::UINT32;
+
+        bool is_valid() const { return base_vertex != RangeAllocator::INVALID_OFFSET; }
+    };
+
+    /// Layout consumed by glMultiDrawElementsIndirect
+    struct DrawElementsIndirectCommand {
+        uint32_t count;
+        uint32_t instance_count;
+        uint32_t first_index;
+        int32_t base_vertex;
+        uint32_t base_instance;
+    };
+
+    static_assert(sizeof(DrawElementsIndirectCommand) == 20, "Indirect commands must be tightly packed");
+
+    /**
+     * @brief Shared vertex and index storage for all meshes.
+     *
+     * Meshes sub-allocate ranges out of the vertex buffer of their VertexLayout's pool and the
+     * index buffer of their IndexType. Each pool has a VAO per index type, draws select their range
+     * with a base vertex and first index, so any number of meshes sharing a VAO can go out in one
+     * glMultiDrawElementsIndirect.
+     *
+     * The VAO also sources an instance index attribute (divisor 1) from an identity buffer.
+     * With baseInstance offsetting it, shaders read baseInstance + instance as their per-draw
+     * record index, which is what gl_DrawID/gl_BaseInstance would give on GL 4.6.
+     */
+    class GeometryArena {
+    public:
+        static constexpr GLuint INSTANCE_INDEX_LOCATION = 6;
+
+        explicit GeometryArena(uint32_t vertex_capacity = 1 << 18, uint32_t index_capacity = 1 << 20);
+
+        ~GeometryArena();
+
+        GeometryArena(const GeometryArena &) = delete;
+
+        GeometryArena &operator=(const GeometryArena &) = delete;
+
+        /// Copy vertex_data (vertex_count vertices encoded in layout) and indices into the arena, growing it if needed
+        GeometryAllocation allocate(const VertexLayout &layout, const std::vector<uint8_t> &vertex_data,
+                                    uint32_t vertex_count, const std::vector<unsigned int> &indices,
+                                    IndexType index_type = IndexType::UINT32);
+
+        void free(GeometryAllocation &allocation);
+
+        void bind(uint32_t pool, IndexType index_type) const;
+
+        void unbind() const;
+
+        /// Make sure instance indices [0, count) can be sourced by the instance index attribute
+        void ensure_instance_capacity(uint32_t count);
+
+        uint32_t get_vertex_array_id(const uint32_t pool, const IndexType index_type) const {
+            return pools_[pool].vaos[static_cast<size_t>(index_type)];
+        }
+        uint32_t get_pool_count() const { return static_cast<uint32_t>(pools_.size()); }
+        uint32_t get_used_vertices() const;
+        uint32_t get_vertex_capacity() const;
+        /// Vertex buffer memory in use across all pools
+        uint64_t get_used_vertex_bytes() const;
+        uint32_t get_used_indices() const;
+        uint32_t get_index_capacity() const;
+        /// Index buffer memory in use across both index types
+        uint64_t get_used_index_bytes() const;
+
+    private:
+        static constexpr GLuint VERTEX_BUFFER_BINDING = 0;
+        static constexpr GLuint INSTANCE_BUFFER_BINDING = 1;
+        static constexpr size_t INDEX_TYPE_COUNT = 2;
+
+        /// Vertex buffer for the meshes of one layout, with a VAO per index type
+        struct VertexPool {
+            VertexLayout layout;
+            GLuint vaos[INDEX_TYPE_COUNT] = {};
+            GLuint vertex_buffer = 0;
+            RangeAllocator ranges;
+        };
+
+        /// Index storage for one IndexType, ranges count indices rather than bytes
+        struct IndexPool {
+            GLuint buffer = 0;
+            RangeAllocator ranges;
+        };
+
+        std::vector<VertexPool> pools_;
+        uint32_t initial_vertex_capacity_;
+        IndexPool index_pools_[INDEX_TYPE_COUNT];
+        GLuint instance_index_buffer_ = 0;
+        uint32_t instance_capacity_ = 0;
+
+        uint32_t get_pool(const VertexLayout &layout);
+
+        void setup_vertex_format(const VertexPool &pool, IndexType index_type) const;
+
+        /// @return Offset of the range, growing buffer (of element_size elements) when ranges is full
+        static uint32_t allocate_range(RangeAllocator &ranges, uint32_t count, GLuint &buffer, size_t element_size);
+
+        /// Reallocate buffer with room for new_bytes, keeping the first old_bytes
+        static GLuint resize_buffer(GLuint buffer, size_t old_bytes, size_t new_bytes);
+    };
+}
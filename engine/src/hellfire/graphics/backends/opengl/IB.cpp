@@ -1,6 +1,7 @@
 #include "IB.h"
 
 #include <GL/glew.h>
+#include "GLStateCache.h"
 #include <cstdint>
 
 IB::IB()
@@ -10,15 +11,15 @@ IB::IB()
 
 IB::~IB()
 {
-	glDeleteBuffers(1, &m_renderer_id_);
+	hellfire::GLStateCache::delete_buffers(1, &m_renderer_id_);
 }
 
 void IB::bind()
 {
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_renderer_id_);
+	hellfire::GLStateCache::bind_buffer(GL_ELEMENT_ARRAY_BUFFER, m_renderer_id_);
 }
 
 void IB::unbind()
 {
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	hellfire::GLStateCache::bind_buffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
@@ -0,0 +1,99 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include "PixelReadback.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "GLStateCache.h"
+
+namespace hellfire {
+    PixelReadback::~PixelReadback() {
+        for (Slot &slot: slots_) {
+            if (slot.fence) glDeleteSync(slot.fence);
+            if (slot.buffer != 0) GLStateCache::delete_buffers(1, &slot.buffer);
+        }
+        if (framebuffer_ != 0) GLStateCache::delete_framebuffers(1, &framebuffer_);
+    }
+
+    bool PixelReadback::request(const uint32_t texture, const PixelRegion &requested, Callback callback) {
+        if (texture == 0 || requested.width <= 0 || requested.height <= 0) return false;
+
+        // Reading outside the attachment leaves those texels undefined, so cut the region to the texture
+        GLint texture_width = 0, texture_height = 0;
+        GLStateCache::bind_texture(GL_TEXTURE_2D, texture);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &texture_width);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &texture_height);
+
+        PixelRegion region;
+        region.x = std::clamp(requested.x, 0, texture_width);
+        region.y = std::clamp(requested.y, 0, texture_height);
+        region.width = std::clamp(requested.x + requested.width, 0, texture_width) - region.x;
+        region.height = std::clamp(requested.y + requested.height, 0, texture_height) - region.y;
+        if (region.width <= 0 || region.height <= 0) return false;
+
+        const auto free_slot = std::find_if(std::begin(slots_), std::end(slots_),
+                                            [](const Slot &slot) { return slot.fence == nullptr; });
+        if (free_slot == std::end(slots_)) {
+            requests_dropped_++;
+            return false;
+        }
+        Slot &slot = *free_slot;
+
+        if (framebuffer_ == 0) glGenFramebuffers(1, &framebuffer_);
+        if (slot.buffer == 0) glGenBuffers(1, &slot.buffer);
+
+        GLStateCache::bind_framebuffer(GL_READ_FRAMEBUFFER, framebuffer_);
+        glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+
+        // With a pack buffer bound glReadPixels only queues the copy, the pointer is an offset into the buffer
+        const size_t bytes = static_cast<size_t>(region.width) * region.height * sizeof(uint32_t);
+        GLStateCache::bind_buffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+        if (bytes > slot.capacity) {
+            glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_READ);
+            slot.capacity = bytes;
+        }
+        glReadPixels(region.x, region.y, region.width, region.height, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+        GLStateCache::bind_buffer(GL_PIXEL_PACK_BUFFER, 0);
+        GLStateCache::bind_framebuffer(GL_READ_FRAMEBUFFER, 0);
+
+        slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        slot.region = region;
+        slot.callback = std::move(callback);
+        pending_.push_back(static_cast<uint32_t>(free_slot - std::begin(slots_)));
+        return true;
+    }
+
+    void PixelReadback::poll() {
+        // Fences signal in submission order, so the first unfinished read means the rest aren't done either
+        while (!pending_.empty()) {
+            Slot &slot = slots_[pending_.front()];
+            const GLenum status = glClientWaitSync(slot.fence, 0, 0);
+            if (status == GL_TIMEOUT_EXPIRED) return;
+            pending_.pop_front();
+
+            glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+            const PixelRegion region = slot.region;
+            const Callback callback = std::move(slot.callback);
+            slot.callback = nullptr;
+            if (status == GL_WAIT_FAILED) continue;
+
+            const size_t count = static_cast<size_t>(region.width) * region.height;
+            GLStateCache::bind_buffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+            const void *data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0,
+                                                static_cast<GLsizeiptr>(count * sizeof(uint32_t)), GL_MAP_READ_BIT);
+            if (data) {
+                pixels_.resize(count);
+                std::memcpy(pixels_.data(), data, count * sizeof(uint32_t));
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            }
+            GLStateCache::bind_buffer(GL_PIXEL_PACK_BUFFER, 0);
+
+            // The slot is free again before the callback runs, so it can queue the next read
+            if (data && callback) callback(region, pixels_);
+        }
+    }
+}
@@ -0,0 +1,74 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
+
+#include "GL/glew.h"
+
+namespace hellfire {
+    /// Rectangle of texels, origin at the bottom left like GL
+    struct PixelRegion {
+        int x = 0;
+        int y = 0;
+        int width = 1;
+        int height = 1;
+    };
+
+    /**
+     * @brief Reads GL_R32UI texture regions (e.g. object ids) back to the CPU without stalling on the GPU.
+     *
+     * request() has the GPU copy the region into a pixel buffer object and drops a fence behind it.
+     * poll() checks the fences without waiting and hands the finished reads to their callbacks in
+     * request order, normally a frame or two later. Only MAX_PENDING reads can be in flight, requests
+     * beyond that are refused instead of waiting for a buffer to come back.
+     */
+    class PixelReadback {
+    public:
+        /// region is the clamped region that was read, pixels holds its width * height values row by row from the bottom
+        using Callback = std::function<void(const PixelRegion &region, const std::vector<uint32_t> &pixels)>;
+
+        static constexpr uint32_t MAX_PENDING = 4;
+
+        PixelReadback() = default;
+
+        ~PixelReadback();
+
+        PixelReadback(const PixelReadback &) = delete;
+
+        PixelReadback &operator=(const PixelReadback &) = delete;
+
+        /**
+         * Queue a read of a region of the texture's level 0. The region is clamped to the texture size,
+         * false when nothing of it lies inside the texture or all buffers are busy.
+         */
+        bool request(uint32_t texture, const PixelRegion &requested, Callback callback);
+
+        /// Run the callbacks of the reads the GPU has finished, never blocks
+        void poll();
+
+        uint32_t get_pending_count() const { return static_cast<uint32_t>(pending_.size()); }
+
+        /// Requests refused because MAX_PENDING reads were already in flight
+        uint32_t get_requests_dropped() const { return requests_dropped_; }
+
+    private:
+        struct Slot {
+            GLuint buffer = 0;
+            size_t capacity = 0; // Bytes allocated for buffer
+            GLsync fence = nullptr;
+            PixelRegion region;
+            Callback callback;
+        };
+
+        Slot slots_[MAX_PENDING];
+        std::deque<uint32_t> pending_; // Slot indices in request order
+        GLuint framebuffer_ = 0; // Read framebuffer the requested texture is attached to
+        std::vector<uint32_t> pixels_; // Handed to the callbacks, reused between reads
+        uint32_t requests_dropped_ = 0;
+    };
+}
@@ -0,0 +1,66 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include "ShaderBuffer.h"
+
+#include <algorithm>
+
+#include "GLStateCache.h"
+
+namespace hellfire {
+    ShaderBuffer::ShaderBuffer(const GLenum target, const uint32_t binding, const size_t size)
+        : target_(target), binding_(binding) {
+        glGenBuffers(1, &buffer_id_);
+        if (size > 0) {
+            allocate(size);
+        }
+    }
+
+    ShaderBuffer::~ShaderBuffer() {
+        if (buffer_id_ != 0) {
+            GLStateCache::delete_buffers(1, &buffer_id_);
+        }
+    }
+
+    void ShaderBuffer::upload(const void *data, const size_t size, const size_t offset) {
+        if (size == 0) return;
+
+        if (offset + size > size_) {
+            // Grow geometrically so streaming buffers don't reallocate every frame
+            allocate(std::max(offset + size, size_ + size_ / 2));
+        }
+
+        GLStateCache::bind_buffer(target_, buffer_id_);
+        glBufferSubData(target_, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+        GLStateCache::record_buffer_upload(size);
+
+        bind_base();
+    }
+
+    void ShaderBuffer::stream(const void *data, const size_t size) {
+        if (size == 0) return;
+
+        allocate(std::max(size, size_));
+        upload(data, size);
+    }
+
+    void ShaderBuffer::bind_base() const {
+        switch (target_) {
+            case GL_UNIFORM_BUFFER:
+            case GL_SHADER_STORAGE_BUFFER:
+            case GL_ATOMIC_COUNTER_BUFFER:
+            case GL_TRANSFORM_FEEDBACK_BUFFER:
+                GLStateCache::bind_buffer_base(target_, binding_, buffer_id_);
+                break;
+            default:
+                GLStateCache::bind_buffer(target_, buffer_id_);
+                break;
+        }
+    }
+
+    void ShaderBuffer::allocate(const size_t size) {
+        GLStateCache::bind_buffer(target_, buffer_id_);
+        glBufferData(target_, static_cast<GLsizeiptr>(size), nullptr, GL_DYNAMIC_DRAW);
+        size_ = size;
+    }
+}
@@ -0,0 +1,70 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "GL/glew.h"
+
+namespace hellfire {
+    /**
+     * @brief GPU buffer bound to an indexed shader binding point.
+     *
+     * Wraps a uniform buffer (GL_UNIFORM_BUFFER) or shader storage buffer
+     * (GL_SHADER_STORAGE_BUFFER). The layout of the uploaded data must match the
+     * std140/std430 block declared in GLSL. Non-indexed targets such as
+     * GL_DRAW_INDIRECT_BUFFER are supported too and are bound to the target itself.
+     */
+    class ShaderBuffer {
+    public:
+        ShaderBuffer(GLenum target, uint32_t binding, size_t size = 0);
+
+        ~ShaderBuffer();
+
+        ShaderBuffer(const ShaderBuffer &) = delete;
+
+        ShaderBuffer &operator=(const ShaderBuffer &) = delete;
+
+        /// Upload raw bytes. Growing the buffer discards its previous contents. Rebinds the binding point.
+        void upload(const void *data, size_t size, size_t offset = 0);
+
+        template<typename T>
+        void upload(const T &data) {
+            upload(&data, sizeof(T));
+        }
+
+        template<typename T>
+        void upload(const std::vector<T> &data) {
+            upload(data.data(), data.size() * sizeof(T));
+        }
+
+        /**
+         * @brief Replace the whole contents with data rewritten every frame.
+         * Orphans the old storage first so the driver doesn't stall on draws still reading it.
+         */
+        void stream(const void *data, size_t size);
+
+        template<typename T>
+        void stream(const std::vector<T> &data) {
+            stream(data.data(), data.size() * sizeof(T));
+        }
+
+        /// Attach the whole buffer to its binding point (or bind it to the target when it has none).
+        void bind_base() const;
+
+        uint32_t get_id() const { return buffer_id_; }
+        uint32_t get_binding() const { return binding_; }
+        size_t get_size() const { return size_; }
+
+    private:
+        GLenum target_;
+        uint32_t binding_;
+        uint32_t buffer_id_ = 0;
+        size_t size_ = 0;
+
+        void allocate(size_t size);
+    };
+}
@@ -1,6 +1,7 @@
 #include "VA.h"
 
 #include <GL/glew.h>
+#include "GLStateCache.h"
 #include <glm/detail/type_int.hpp>
 
 VA::VA()
@@ -10,16 +11,16 @@ VA::VA()
 
 VA::~VA()
 {
-	glDeleteVertexArrays(1, &m_renderer_id_);
+	hellfire::GLStateCache::delete_vertex_arrays(1, &m_renderer_id_);
 }
 
 void VA::bind() const {
-	glBindVertexArray(m_renderer_id_);
+	hellfire::GLStateCache::bind_vertex_array(m_renderer_id_);
 }
 
 void VA::unbind()
 {
-	glBindVertexArray(0);
+	hellfire::GLStateCache::bind_vertex_array(0);
 }
 
 uint32_t VA::get_id() const {
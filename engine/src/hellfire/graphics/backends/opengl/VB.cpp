@@ -1,5 +1,6 @@
 #include "VB.h"
 #include <GL/glew.h>
+#include "GLStateCache.h"
 
 VB::VB()
 {
@@ -8,16 +9,16 @@ VB::VB()
 
 VB::~VB()
 {
-	glDeleteBuffers(1, &m_renderer_id_);
+	hellfire::GLStateCache::delete_buffers(1, &m_renderer_id_);
 }
 
 void VB::bind()
 {
-	glBindBuffer(GL_ARRAY_BUFFER, m_renderer_id_);
+	hellfire::GLStateCache::bind_buffer(GL_ARRAY_BUFFER, m_renderer_id_);
 }
 
 void VB::unbind()
 {
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	hellfire::GLStateCache::bind_buffer(GL_ARRAY_BUFFER, 0);
 	
 }
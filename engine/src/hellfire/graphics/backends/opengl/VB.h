@@ -11,6 +11,7 @@ public:
 	~VB();
 	void bind();
 	void unbind();
+	uint32_t get_id() const { return m_renderer_id_; }
 
 	template<typename T>
 	void pass_data(const T* data, size_t count) const
@@ -0,0 +1,39 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include "VertexFormat.h"
+
+namespace hellfire {
+    void set_vertex_format(const VertexLayout &layout, const GLuint binding) {
+        for (GLuint location = 0; location < VertexLayout::MAX_ATTRIBUTES; location++) {
+            glDisableVertexAttribArray(location);
+        }
+        // Generic attribute values are context state, but nothing else ever sets this one
+        glVertexAttrib4f(2, 1.0f, 1.0f, 1.0f, 1.0f);
+
+        VertexAttributeFormat formats[VertexLayout::MAX_ATTRIBUTES];
+        const uint32_t count = layout.get_attributes(formats);
+        for (uint32_t i = 0; i < count; i++) {
+            const VertexAttributeFormat &format = formats[i];
+            glEnableVertexAttribArray(format.location);
+            switch (format.type) {
+                case VertexAttributeFormat::Type::FLOAT:
+                    glVertexAttribFormat(format.location, format.components, GL_FLOAT, GL_FALSE, format.offset);
+                    break;
+                case VertexAttributeFormat::Type::HALF_FLOAT:
+                    glVertexAttribFormat(format.location, format.components, GL_HALF_FLOAT, GL_FALSE, format.offset);
+                    break;
+                case VertexAttributeFormat::Type::UNORM16:
+                    glVertexAttribFormat(format.location, format.components, GL_UNSIGNED_SHORT, GL_TRUE, format.offset);
+                    break;
+                case VertexAttributeFormat::Type::UNORM8:
+                    glVertexAttribFormat(format.location, format.components, GL_UNSIGNED_BYTE, GL_TRUE, format.offset);
+                    break;
+                case VertexAttributeFormat::Type::SNORM_10_10_10_2:
+                    glVertexAttribFormat(format.location, 4, GL_INT_2_10_10_10_REV, GL_TRUE, format.offset);
+                    break;
+            }
+            glVertexAttribBinding(format.location, binding);
+        }
+    }
+}
@@ -0,0 +1,21 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#pragma once
+
+#include "GL/glew.h"
+#include "hellfire/graphics/IndexType.h"
+#include "hellfire/graphics/VertexLayout.h"
+
+namespace hellfire {
+    /**
+     * @brief Describe layout's attributes on the bound VAO, all sourced from vertex buffer binding.
+     * Locations the layout leaves out are disabled; a missing color reads constant white.
+     */
+    void set_vertex_format(const VertexLayout &layout, GLuint binding);
+
+    /// Type to pass to glDrawElements* for indices of type
+    inline GLenum get_gl_index_type(const IndexType type) {
+        return type == IndexType::UINT16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    }
+}
@@ -0,0 +1,96 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+namespace hellfire {
+    /// Axis aligned bounding box, empty (min > max) until a point is added
+    struct AABB {
+        glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
+        glm::vec3 max = glm::vec3(std::numeric_limits<float>::lowest());
+
+        bool is_valid() const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+
+        glm::vec3 get_center() const { return (min + max) * 0.5f; }
+        glm::vec3 get_extents() const { return (max - min) * 0.5f; }
+
+        void expand(const glm::vec3 &point) {
+            min = glm::min(min, point);
+            max = glm::max(max, point);
+        }
+
+        /**
+         * @brief Bounds of this box after transforming it by matrix.
+         * Transforms center and extents (Arvo) instead of all eight corners.
+         */
+        AABB transformed(const glm::mat4 &matrix) const {
+            if (!is_valid()) return *this;
+
+            const glm::vec3 center = glm::vec3(matrix * glm::vec4(get_center(), 1.0f));
+            const glm::vec3 extents = get_extents();
+
+            glm::vec3 world_extents(0.0f);
+            for (int axis = 0; axis < 3; axis++) {
+                world_extents += glm::abs(glm::vec3(matrix[axis])) * extents[axis];
+            }
+
+            return {center - world_extents, center + world_extents};
+        }
+    };
+
+    struct BoundingSphere {
+        glm::vec3 center = glm::vec3(0.0f);
+        float radius = -1.0f;
+
+        bool is_valid() const { return radius >= 0.0f; }
+
+        BoundingSphere transformed(const glm::mat4 &matrix) const {
+            if (!is_valid()) return *this;
+
+            // Non-uniform scale stretches the sphere along its largest axis
+            const float max_scale = std::max({
+                glm::length(glm::vec3(matrix[0])),
+                glm::length(glm::vec3(matrix[1])),
+                glm::length(glm::vec3(matrix[2]))
+            });
+
+            return {glm::vec3(matrix * glm::vec4(center, 1.0f)), radius * max_scale};
+        }
+    };
+
+    /// Local space bounds of a mesh
+    struct MeshBounds {
+        AABB aabb;
+        BoundingSphere sphere;
+
+        bool is_valid() const { return aabb.is_valid(); }
+
+        /// Box around the points, sphere centered on the box and enclosing every point
+        template<typename VertexT>
+        static MeshBounds from_vertices(const std::vector<VertexT> &vertices) {
+            MeshBounds bounds;
+            for (const auto &vertex: vertices) {
+                bounds.aabb.expand(vertex.position);
+            }
+
+            if (!bounds.aabb.is_valid()) return bounds;
+
+            bounds.sphere.center = bounds.aabb.get_center();
+            float max_distance_sq = 0.0f;
+            for (const auto &vertex: vertices) {
+                const glm::vec3 offset = vertex.position - bounds.sphere.center;
+                max_distance_sq = std::max(max_distance_sq, glm::dot(offset, offset));
+            }
+            bounds.sphere.radius = std::sqrt(max_distance_sq);
+
+            return bounds;
+        }
+    };
+}
@@ -0,0 +1,131 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include "Frustum.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HELLFIRE_FRUSTUM_SSE 1
+#include <xmmintrin.h>
+#endif
+
+namespace hellfire {
+    Frustum::Frustum() {
+        // A zero normal with a positive distance never rejects anything
+        for (int i = 0; i < PADDED_PLANE_COUNT; i++) {
+            set_plane(i, glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+        }
+    }
+
+    Frustum::Frustum(const glm::mat4 &view_projection) : Frustum() {
+        update(view_projection);
+    }
+
+    void Frustum::update(const glm::mat4 &view_projection) {
+        // Gribb/Hartmann: planes are sums of the matrix rows (glm is column-major)
+        const glm::mat4 &m = view_projection;
+        const glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+        const glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+        const glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+        const glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+        const glm::vec4 planes[PLANE_COUNT] = {
+            row3 + row0, // Left
+            row3 - row0, // Right
+            row3 + row1, // Bottom
+            row3 - row1, // Top
+            row3 + row2, // Near
+            row3 - row2  // Far
+        };
+
+        for (int i = 0; i < PLANE_COUNT; i++) {
+            const float length = glm::length(glm::vec3(planes[i]));
+            set_plane(i, length > 0.0f ? planes[i] / length : planes[i]);
+        }
+    }
+
+    void Frustum::set_plane(const int index, const glm::vec4 &plane) {
+        normal_x_[index] = plane.x;
+        normal_y_[index] = plane.y;
+        normal_z_[index] = plane.z;
+        distance_[index] = plane.w;
+    }
+
+    glm::vec4 Frustum::get_plane(const int index) const {
+        return {normal_x_[index], normal_y_[index], normal_z_[index], distance_[index]};
+    }
+
+    bool Frustum::intersects(const AABB &box) const {
+        if (!box.is_valid()) return true;
+
+        const glm::vec3 center = box.get_center();
+        const glm::vec3 extents = box.get_extents();
+
+#ifdef HELLFIRE_FRUSTUM_SSE
+        const __m128 center_x = _mm_set1_ps(center.x);
+        const __m128 center_y = _mm_set1_ps(center.y);
+        const __m128 center_z = _mm_set1_ps(center.z);
+        const __m128 extent_x = _mm_set1_ps(extents.x);
+        const __m128 extent_y = _mm_set1_ps(extents.y);
+        const __m128 extent_z = _mm_set1_ps(extents.z);
+        const __m128 sign_mask = _mm_set1_ps(-0.0f);
+        const __m128 zero = _mm_setzero_ps();
+
+        for (int i = 0; i < PADDED_PLANE_COUNT; i += 4) {
+            const __m128 nx = _mm_load_ps(normal_x_ + i);
+            const __m128 ny = _mm_load_ps(normal_y_ + i);
+            const __m128 nz = _mm_load_ps(normal_z_ + i);
+
+            // Signed distance of the center and the projected radius of the box on each plane normal
+            const __m128 distance = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(nx, center_x), _mm_mul_ps(ny, center_y)),
+                _mm_add_ps(_mm_mul_ps(nz, center_z), _mm_load_ps(distance_ + i)));
+            const __m128 radius = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(_mm_andnot_ps(sign_mask, nx), extent_x),
+                           _mm_mul_ps(_mm_andnot_ps(sign_mask, ny), extent_y)),
+                _mm_mul_ps(_mm_andnot_ps(sign_mask, nz), extent_z));
+
+            if (_mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(distance, radius), zero)) != 0) {
+                return false;
+            }
+        }
+#else
+        for (int i = 0; i < PLANE_COUNT; i++) {
+            const float distance = normal_x_[i] * center.x + normal_y_[i] * center.y +
+                                   normal_z_[i] * center.z + distance_[i];
+            const float radius = std::abs(normal_x_[i]) * extents.x + std::abs(normal_y_[i]) * extents.y +
+                                 std::abs(normal_z_[i]) * extents.z;
+            if (distance + radius < 0.0f) return false;
+        }
+#endif
+        return true;
+    }
+
+    bool Frustum::intersects(const BoundingSphere &sphere) const {
+        if (!sphere.is_valid()) return true;
+
+#ifdef HELLFIRE_FRUSTUM_SSE
+        const __m128 center_x = _mm_set1_ps(sphere.center.x);
+        const __m128 center_y = _mm_set1_ps(sphere.center.y);
+        const __m128 center_z = _mm_set1_ps(sphere.center.z);
+        const __m128 negative_radius = _mm_set1_ps(-sphere.radius);
+
+        for (int i = 0; i < PADDED_PLANE_COUNT; i += 4) {
+            const __m128 distance = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(_mm_load_ps(normal_x_ + i), center_x),
+                           _mm_mul_ps(_mm_load_ps(normal_y_ + i), center_y)),
+                _mm_add_ps(_mm_mul_ps(_mm_load_ps(normal_z_ + i), center_z), _mm_load_ps(distance_ + i)));
+
+            if (_mm_movemask_ps(_mm_cmplt_ps(distance, negative_radius)) != 0) {
+                return false;
+            }
+        }
+#else
+        for (int i = 0; i < PLANE_COUNT; i++) {
+            const float distance = normal_x_[i] * sphere.center.x + normal_y_[i] * sphere.center.y +
+                                   normal_z_[i] * sphere.center.z + distance_[i];
+            if (distance < -sphere.radius) return false;
+        }
+#endif
+        return true;
+    }
+}
@@ -0,0 +1,45 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#pragma once
+
+#include "BoundingVolume.h"
+#include "glm/glm.hpp"
+
+namespace hellfire {
+    /**
+     * @brief View frustum used to cull bounding volumes.
+     *
+     * Planes are extracted from a view-projection matrix and stored structure-of-arrays,
+     * padded to eight so a box or sphere is tested against four planes per SSE instruction.
+     * A default constructed frustum contains everything.
+     */
+    class Frustum {
+    public:
+        static constexpr int PLANE_COUNT = 6;
+
+        Frustum();
+
+        explicit Frustum(const glm::mat4 &view_projection);
+
+        void update(const glm::mat4 &view_projection);
+
+        /// False only when the box lies completely outside at least one plane
+        bool intersects(const AABB &box) const;
+
+        bool intersects(const BoundingSphere &sphere) const;
+
+        /// Plane as (normal, distance), normal pointing into the frustum
+        glm::vec4 get_plane(int index) const;
+
+    private:
+        static constexpr int PADDED_PLANE_COUNT = 8;
+
+        alignas(16) float normal_x_[PADDED_PLANE_COUNT];
+        alignas(16) float normal_y_[PADDED_PLANE_COUNT];
+        alignas(16) float normal_z_[PADDED_PLANE_COUNT];
+        alignas(16) float distance_[PADDED_PLANE_COUNT];
+
+        void set_plane(int index, const glm::vec4 &plane);
+    };
+}
@@ -0,0 +1,331 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include "OcclusionBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+
+#include "hellfire/core/Profiler.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HELLFIRE_OCCLUSION_SSE 1
+#include <xmmintrin.h>
+#endif
+
+namespace hellfire {
+    namespace {
+        /// Boxes reaching this close to the camera plane are not tested
+        constexpr float MIN_CLIP_W = 1e-5f;
+        /// Largest screen rectangle, in texels per side, read from a hierarchy level
+        constexpr uint32_t MAX_TEST_TEXELS = 4;
+
+        bool all_outside(const glm::vec4 &a, const glm::vec4 &b, const glm::vec4 &c, const int axis, const float sign) {
+            return sign * a[axis] > a.w && sign * b[axis] > b.w && sign * c[axis] > c.w;
+        }
+    }
+
+    OcclusionBuffer::OcclusionBuffer(const uint32_t width, const uint32_t height)
+        : width_((std::max(width, 4u) + 3u) & ~3u), height_(std::max(height, 1u)) {
+        // Level 0 is the depth buffer itself, then halve until a single texel is left
+        uint32_t level_width = width_;
+        uint32_t level_height = height_;
+        while (true) {
+            levels_.push_back({level_width, level_height, std::vector<float>(level_width * level_height, 1.0f)});
+            if (level_width == 1 && level_height == 1) break;
+            level_width = std::max(1u, (level_width + 1) / 2);
+            level_height = std::max(1u, (level_height + 1) / 2);
+        }
+    }
+
+    OcclusionBuffer::~OcclusionBuffer() {
+        {
+            std::lock_guard lock(work_mutex_);
+            stopping_ = true;
+        }
+        work_ready_.notify_all();
+        for (std::thread &worker: workers_) {
+            worker.join();
+        }
+    }
+
+    void OcclusionBuffer::begin(const glm::mat4 &view_projection) {
+        view_projection_ = view_projection;
+        triangles_.clear();
+        for (Level &level: levels_) {
+            std::fill(level.depth.begin(), level.depth.end(), 1.0f);
+        }
+    }
+
+    void OcclusionBuffer::add_triangles(const unsigned int *indices, const size_t index_count) {
+        const size_t vertex_count = clip_positions_.size();
+        for (size_t i = 0; i + 2 < index_count; i += 3) {
+            if (indices[i] >= vertex_count || indices[i + 1] >= vertex_count || indices[i + 2] >= vertex_count) continue;
+
+            const glm::vec4 &a = clip_positions_[indices[i]];
+            const glm::vec4 &b = clip_positions_[indices[i + 1]];
+            const glm::vec4 &c = clip_positions_[indices[i + 2]];
+
+            // Entirely outside one of the side or far planes
+            if (all_outside(a, b, c, 0, 1.0f) || all_outside(a, b, c, 0, -1.0f) ||
+                all_outside(a, b, c, 1, 1.0f) || all_outside(a, b, c, 1, -1.0f) ||
+                all_outside(a, b, c, 2, 1.0f)) {
+                continue;
+            }
+
+            // Clip against the near plane (z >= -w), leaving a triangle or a quad
+            const glm::vec4 *input[3] = {&a, &b, &c};
+            glm::vec4 polygon[4];
+            int polygon_size = 0;
+            for (int v = 0; v < 3; v++) {
+                const glm::vec4 &current = *input[v];
+                const glm::vec4 &next = *input[(v + 1) % 3];
+                const float current_distance = current.z + current.w;
+                const float next_distance = next.z + next.w;
+
+                if (current_distance >= 0.0f) polygon[polygon_size++] = current;
+                if ((current_distance >= 0.0f) != (next_distance >= 0.0f)) {
+                    const float t = current_distance / (current_distance - next_distance);
+                    polygon[polygon_size++] = current + (next - current) * t;
+                }
+            }
+
+            for (int v = 2; v < polygon_size; v++) {
+                add_clipped_triangle(polygon[0], polygon[v - 1], polygon[v]);
+            }
+        }
+    }
+
+    void OcclusionBuffer::add_clipped_triangle(const glm::vec4 &a, const glm::vec4 &b, const glm::vec4 &c) {
+        Triangle triangle;
+        const glm::vec4 *clip[3] = {&a, &b, &c};
+        for (int v = 0; v < 3; v++) {
+            const float w = std::max(clip[v]->w, MIN_CLIP_W);
+            const glm::vec3 ndc = glm::vec3(*clip[v]) / w;
+            triangle.vertices[v] = glm::vec3((ndc.x * 0.5f + 0.5f) * static_cast<float>(width_),
+                                             (ndc.y * 0.5f + 0.5f) * static_cast<float>(height_),
+                                             std::clamp(ndc.z * 0.5f + 0.5f, 0.0f, 1.0f));
+        }
+        triangles_.push_back(triangle);
+    }
+
+    void OcclusionBuffer::render(const uint32_t worker_count) {
+        const uint32_t requested_bands = std::clamp(worker_count, 1u, height_);
+        const uint32_t rows_per_band = (height_ + requested_bands - 1) / requested_bands;
+        // Rounding up the rows can leave fewer bands than asked for
+        const uint32_t bands = (height_ + rows_per_band - 1) / rows_per_band;
+
+        if (bands > 1) {
+            while (workers_.size() < bands - 1) {
+                const auto band = static_cast<uint32_t>(workers_.size() + 1);
+                workers_.emplace_back(&OcclusionBuffer::worker_loop, this, band, work_generation_);
+            }
+            {
+                std::lock_guard lock(work_mutex_);
+                band_count_ = bands;
+                rows_per_band_ = rows_per_band;
+                bands_remaining_ = bands - 1;
+                work_generation_++;
+            }
+            work_ready_.notify_all();
+        }
+
+        // Bands write disjoint rows, the caller takes the first one
+        rasterize_band(0, std::min(height_, rows_per_band));
+        if (bands > 1) {
+            std::unique_lock lock(work_mutex_);
+            work_done_.wait(lock, [this] { return bands_remaining_ == 0; });
+        }
+
+        build_hierarchy();
+    }
+
+    void OcclusionBuffer::worker_loop(const uint32_t band, uint64_t generation) {
+        HF_PROFILE_THREAD("Occlusion worker " + std::to_string(band));
+        while (true) {
+            uint32_t row_begin, row_end;
+            {
+                std::unique_lock lock(work_mutex_);
+                work_ready_.wait(lock, [&] { return stopping_ || work_generation_ != generation; });
+                if (stopping_) return;
+                generation = work_generation_;
+                // Fewer bands than workers this time
+                if (band >= band_count_) continue;
+                row_begin = band * rows_per_band_;
+                row_end = std::min(height_, row_begin + rows_per_band_);
+            }
+
+            rasterize_band(row_begin, row_end);
+
+            std::lock_guard lock(work_mutex_);
+            if (--bands_remaining_ == 0) work_done_.notify_one();
+        }
+    }
+
+    void OcclusionBuffer::rasterize_band(const uint32_t row_begin, const uint32_t row_end) {
+        HF_PROFILE_SCOPE("OcclusionBuffer::rasterize_band");
+        std::vector<float> &depth = levels_[0].depth;
+
+        for (const Triangle &triangle: triangles_) {
+            glm::vec3 v0 = triangle.vertices[0];
+            glm::vec3 v1 = triangle.vertices[1];
+            glm::vec3 v2 = triangle.vertices[2];
+
+            // Occluders are drawn two-sided, so wind every triangle counter-clockwise
+            float area = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+            if (std::abs(area) < 1e-6f) continue;
+            if (area < 0.0f) {
+                std::swap(v1, v2);
+                area = -area;
+            }
+
+            // Pixels whose centers fall inside the bounds, limited to this band
+            const float min_x = std::min({v0.x, v1.x, v2.x});
+            const float max_x = std::max({v0.x, v1.x, v2.x});
+            const float min_y = std::min({v0.y, v1.y, v2.y});
+            const float max_y = std::max({v0.y, v1.y, v2.y});
+            const int x_begin = std::max(0, static_cast<int>(std::ceil(min_x - 0.5f)));
+            const int x_end = std::min(static_cast<int>(width_) - 1, static_cast<int>(std::floor(max_x - 0.5f)));
+            const int y_begin = std::max(static_cast<int>(row_begin), static_cast<int>(std::ceil(min_y - 0.5f)));
+            const int y_end = std::min(static_cast<int>(row_end) - 1, static_cast<int>(std::floor(max_y - 0.5f)));
+            if (x_begin > x_end || y_begin > y_end) continue;
+
+            // Edge functions e = a * x + b * y + c, positive inside. A shared edge is always set up
+            // from the same end, so its two triangles see exactly opposite values and leave no cracks
+            const glm::vec3 *edge_start[3] = {&v0, &v1, &v2};
+            const glm::vec3 *edge_end[3] = {&v1, &v2, &v0};
+            float edge_a[3], edge_b[3], edge_c[3];
+            for (int e = 0; e < 3; e++) {
+                const glm::vec3 *start = edge_start[e];
+                const glm::vec3 *end = edge_end[e];
+                const bool flip = end->x < start->x || (end->x == start->x && end->y < start->y);
+                if (flip) std::swap(start, end);
+
+                const float sign = flip ? -1.0f : 1.0f;
+                edge_a[e] = sign * (start->y - end->y);
+                edge_b[e] = sign * (end->x - start->x);
+                edge_c[e] = sign * -((start->y - end->y) * start->x + (end->x - start->x) * start->y);
+            }
+
+            // Depth is linear in screen space
+            const float depth_dx = ((v1.z - v0.z) * (v2.y - v0.y) - (v2.z - v0.z) * (v1.y - v0.y)) / area;
+            const float depth_dy = ((v1.x - v0.x) * (v2.z - v0.z) - (v2.x - v0.x) * (v1.z - v0.z)) / area;
+            const float depth_c = v0.z - depth_dx * v0.x - depth_dy * v0.y;
+
+            for (int y = y_begin; y <= y_end; y++) {
+                const float pixel_y = static_cast<float>(y) + 0.5f;
+                float *row = depth.data() + static_cast<size_t>(y) * width_;
+                const float row_edge[3] = {
+                    edge_b[0] * pixel_y + edge_c[0],
+                    edge_b[1] * pixel_y + edge_c[1],
+                    edge_b[2] * pixel_y + edge_c[2],
+                };
+                const float row_depth = depth_dy * pixel_y + depth_c;
+
+#if HELLFIRE_OCCLUSION_SSE
+                // Four pixels at a time from an aligned column; width_ is a multiple of four
+                const __m128 offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+                const __m128 zero = _mm_setzero_ps();
+                for (int x = x_begin & ~3; x <= x_end; x += 4) {
+                    const __m128 pixel_x = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), offsets);
+
+                    __m128 inside = _mm_cmpge_ps(
+                        _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edge_a[0]), pixel_x), _mm_set1_ps(row_edge[0])), zero);
+                    inside = _mm_and_ps(inside, _mm_cmpge_ps(
+                        _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edge_a[1]), pixel_x), _mm_set1_ps(row_edge[1])), zero));
+                    inside = _mm_and_ps(inside, _mm_cmpge_ps(
+                        _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edge_a[2]), pixel_x), _mm_set1_ps(row_edge[2])), zero));
+                    if (_mm_movemask_ps(inside) == 0) continue;
+
+                    const __m128 pixel_depth = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(depth_dx), pixel_x),
+                                                          _mm_set1_ps(row_depth));
+                    const __m128 old_depth = _mm_loadu_ps(row + x);
+                    const __m128 new_depth = _mm_min_ps(old_depth, pixel_depth);
+                    _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, new_depth), _mm_andnot_ps(inside, old_depth)));
+                }
+#else
+                for (int x = x_begin; x <= x_end; x++) {
+                    const float pixel_x = static_cast<float>(x) + 0.5f;
+                    if (edge_a[0] * pixel_x + row_edge[0] < 0.0f ||
+                        edge_a[1] * pixel_x + row_edge[1] < 0.0f ||
+                        edge_a[2] * pixel_x + row_edge[2] < 0.0f) {
+                        continue;
+                    }
+                    row[x] = std::min(row[x], depth_dx * pixel_x + row_depth);
+                }
+#endif
+            }
+        }
+    }
+
+    void OcclusionBuffer::build_hierarchy() {
+        for (size_t i = 1; i < levels_.size(); i++) {
+            const Level &source = levels_[i - 1];
+            Level &target = levels_[i];
+            for (uint32_t y = 0; y < target.height; y++) {
+                const uint32_t y0 = y * 2;
+                const uint32_t y1 = std::min(y0 + 1, source.height - 1);
+                for (uint32_t x = 0; x < target.width; x++) {
+                    const uint32_t x0 = x * 2;
+                    const uint32_t x1 = std::min(x0 + 1, source.width - 1);
+                    target.depth[y * target.width + x] = std::max(
+                        std::max(source.depth[y0 * source.width + x0], source.depth[y0 * source.width + x1]),
+                        std::max(source.depth[y1 * source.width + x0], source.depth[y1 * source.width + x1]));
+                }
+            }
+        }
+    }
+
+    bool OcclusionBuffer::is_visible(const AABB &box) const {
+        if (!box.is_valid()) return true;
+
+        glm::vec2 screen_min(std::numeric_limits<float>::max());
+        glm::vec2 screen_max(std::numeric_limits<float>::lowest());
+        float nearest_depth = 1.0f;
+        for (int corner = 0; corner < 8; corner++) {
+            const glm::vec3 point((corner & 1) ? box.max.x : box.min.x, (corner & 2) ? box.max.y : box.min.y,
+                                  (corner & 4) ? box.max.z : box.min.z);
+            const glm::vec4 clip = view_projection_ * glm::vec4(point, 1.0f);
+            // Reaches past the near plane, too close to say anything about
+            if (clip.w <= MIN_CLIP_W || clip.z < -clip.w) return true;
+
+            const glm::vec3 ndc = glm::vec3(clip) / clip.w;
+            const glm::vec2 screen((ndc.x * 0.5f + 0.5f) * static_cast<float>(width_),
+                                   (ndc.y * 0.5f + 0.5f) * static_cast<float>(height_));
+            screen_min = glm::min(screen_min, screen);
+            screen_max = glm::max(screen_max, screen);
+            nearest_depth = std::min(nearest_depth, ndc.z * 0.5f + 0.5f);
+        }
+
+        // Off screen boxes are left to frustum culling
+        if (screen_max.x < 0.0f || screen_max.y < 0.0f ||
+            screen_min.x > static_cast<float>(width_) || screen_min.y > static_cast<float>(height_)) {
+            return true;
+        }
+
+        const auto to_pixel = [](const float value, const uint32_t size) {
+            return static_cast<uint32_t>(std::clamp(static_cast<int>(std::floor(value)), 0, static_cast<int>(size) - 1));
+        };
+        const uint32_t x0 = to_pixel(screen_min.x, width_);
+        const uint32_t x1 = to_pixel(screen_max.x, width_);
+        const uint32_t y0 = to_pixel(screen_min.y, height_);
+        const uint32_t y1 = to_pixel(screen_max.y, height_);
+
+        // Coarsest level where the rectangle still covers only a few texels
+        const uint32_t extent = std::max(x1 - x0, y1 - y0) + 1;
+        size_t level_index = 0;
+        while (level_index + 1 < levels_.size() && (extent >> level_index) > MAX_TEST_TEXELS) {
+            level_index++;
+        }
+
+        const Level &level = levels_[level_index];
+        for (uint32_t y = y0 >> level_index; y <= (y1 >> level_index); y++) {
+            for (uint32_t x = x0 >> level_index; x <= (x1 >> level_index); x++) {
+                if (level.depth[y * level.width + x] >= nearest_depth) return true;
+            }
+        }
+        return false;
+    }
+}
@@ -0,0 +1,109 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "BoundingVolume.h"
+#include "glm/glm.hpp"
+
+namespace hellfire {
+    /**
+     * @brief Low resolution CPU depth buffer for software occlusion culling.
+     *
+     * A few large occluders are rasterized into a small depth buffer, split into horizontal
+     * bands that persistent worker threads fill in parallel, four pixels per SSE instruction. A hierarchy
+     * of max-depth levels is built on top, so a box can be tested against a handful of texels:
+     * it is hidden when its nearest point lies behind the farthest occluder depth under its
+     * screen rectangle. Works on the CPU only, nothing here touches GL.
+     */
+    class OcclusionBuffer {
+    public:
+        static constexpr uint32_t DEFAULT_WIDTH = 256;
+        static constexpr uint32_t DEFAULT_HEIGHT = 128;
+
+        /// Width is rounded up to a multiple of four
+        explicit OcclusionBuffer(uint32_t width = DEFAULT_WIDTH, uint32_t height = DEFAULT_HEIGHT);
+
+        ~OcclusionBuffer();
+
+        OcclusionBuffer(const OcclusionBuffer &) = delete;
+
+        OcclusionBuffer &operator=(const OcclusionBuffer &) = delete;
+
+        /// Clear to the far plane and take the camera that occluders and tests are projected with
+        void begin(const glm::mat4 &view_projection);
+
+        /// Queue the triangles of an occluder mesh, they are drawn by render()
+        template<typename VertexT>
+        void add_occluder(const glm::mat4 &model, const std::vector<VertexT> &vertices,
+                          const std::vector<unsigned int> &indices) {
+            const glm::mat4 model_view_projection = view_projection_ * model;
+            clip_positions_.resize(vertices.size());
+            for (size_t i = 0; i < vertices.size(); i++) {
+                clip_positions_[i] = model_view_projection * glm::vec4(vertices[i].position, 1.0f);
+            }
+            add_triangles(indices.data(), indices.size());
+        }
+
+        /**
+         * Rasterize the queued occluders on worker_count threads (the caller being one) and build the hierarchy.
+         * The workers are started the first time they're needed and wait for the next frame afterwards.
+         */
+        void render(uint32_t worker_count = 1);
+
+        /// False only when the box is certainly hidden behind the rendered occluders
+        bool is_visible(const AABB &box) const;
+
+        uint32_t get_width() const { return width_; }
+        uint32_t get_height() const { return height_; }
+        /// Triangles queued since begin(), after clipping
+        uint32_t get_triangle_count() const { return static_cast<uint32_t>(triangles_.size()); }
+        /// Nearest occluder depth in [0, 1] at a pixel, row 0 is the bottom of the screen
+        float get_depth(uint32_t x, uint32_t y) const { return levels_[0].depth[y * width_ + x]; }
+
+    private:
+        /// Screen space triangle: x and y in pixels, z the depth in [0, 1]
+        struct Triangle {
+            glm::vec3 vertices[3];
+        };
+
+        struct Level {
+            uint32_t width;
+            uint32_t height;
+            std::vector<float> depth;
+        };
+
+        uint32_t width_;
+        uint32_t height_;
+        glm::mat4 view_projection_ = glm::mat4(1.0f);
+
+        std::vector<glm::vec4> clip_positions_; // Scratch for add_occluder()
+        std::vector<Triangle> triangles_;
+        std::vector<Level> levels_; // Level 0 is the depth buffer, every next one the max of 2x2 texels
+
+        // Worker i rasterizes band i + 1 of each render(), the caller band 0
+        std::vector<std::thread> workers_;
+        std::mutex work_mutex_;
+        std::condition_variable work_ready_;
+        std::condition_variable work_done_;
+        uint64_t work_generation_ = 0; // Bumped by render() to start the workers, only the caller writes it
+        uint32_t band_count_ = 0;
+        uint32_t rows_per_band_ = 0;
+        uint32_t bands_remaining_ = 0; // Worker bands of the current render() not finished yet
+        bool stopping_ = false;
+
+        void worker_loop(uint32_t band, uint64_t generation);
+
+        void add_triangles(const unsigned int *indices, size_t index_count);
+        void add_clipped_triangle(const glm::vec4 &a, const glm::vec4 &b, const glm::vec4 &c);
+
+        void rasterize_band(uint32_t row_begin, uint32_t row_end);
+        void build_hierarchy();
+    };
+}
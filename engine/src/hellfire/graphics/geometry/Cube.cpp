@@ -143,5 +143,7 @@ namespace hellfire {
             v.texCoords = glm::vec2(uvs_[i * 2], uvs_[i * 2 + 1]);
             vertices.push_back(v);
         }
+
+        MeshOptimizer::optimize(vertices, indices);
     }
 }
@@ -0,0 +1,46 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace hellfire {
+    /// Most levels of detail a mesh carries, the full mesh (LOD 0) included
+    constexpr uint32_t MAX_MESH_LODS = 8;
+
+    /// Simplified version of a mesh, indexing the same vertices as the full mesh
+    struct MeshLod {
+        std::vector<unsigned int> indices;
+        float error = 0.0f; // Largest deviation from the full mesh, in the mesh's local units
+    };
+
+    /**
+     * @brief Coarsest LOD whose error stays below error_pixels on screen.
+     * lods holds LOD 1 and up, ordered by increasing error. To avoid popping, a coarser LOD is only
+     * taken once its error drops below (1 - hysteresis) times the threshold, and the current one is
+     * only left for a finer LOD once its error exceeds (1 + hysteresis) times the threshold.
+     * @param pixels_per_unit Pixels one local unit of the mesh covers at its distance from the camera
+     */
+    inline uint32_t select_mesh_lod(const std::vector<MeshLod> &lods, const float pixels_per_unit,
+                                    const uint32_t current_lod, const float error_pixels, const float hysteresis) {
+        const auto lod_count = static_cast<uint32_t>(std::min<size_t>(lods.size() + 1, MAX_MESH_LODS));
+        const auto projected_error = [&](const uint32_t lod) {
+            return lod == 0 ? 0.0f : lods[lod - 1].error * pixels_per_unit;
+        };
+
+        uint32_t lod = std::min(current_lod, lod_count - 1);
+        const uint32_t start_lod = lod;
+        while (lod > 0 && projected_error(lod) > error_pixels * (1.0f + hysteresis)) {
+            lod--;
+        }
+        if (lod < start_lod) return lod;
+
+        while (lod + 1 < lod_count && projected_error(lod + 1) <= error_pixels * (1.0f - hysteresis)) {
+            lod++;
+        }
+        return lod;
+    }
+}
@@ -0,0 +1,239 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include <glm/glm.hpp>
+
+namespace hellfire {
+    MeshOptimizationStats MeshOptimizer::optimize(std::vector<Vertex> &vertices, std::vector<unsigned int> &indices,
+                                                  std::vector<MeshLod> &lods) {
+        MeshOptimizationStats stats;
+        const size_t vertex_count = vertices.size();
+        const auto out_of_range = [&](const std::vector<unsigned int> &list) {
+            return std::any_of(list.begin(), list.end(), [&](const unsigned int index) { return index >= vertex_count; });
+        };
+        if (indices.size() % 3 != 0 || out_of_range(indices) ||
+            std::any_of(lods.begin(), lods.end(), [&](const MeshLod &lod) { return out_of_range(lod.indices); })) {
+            return stats;
+        }
+
+        stats.acmr_before = calculate_acmr(indices, vertex_count);
+
+        const std::vector<uint32_t> cluster_starts = optimize_vertex_cache(indices, vertex_count);
+        optimize_overdraw(indices, vertices, cluster_starts);
+        stats.clusters = static_cast<uint32_t>(cluster_starts.size());
+
+        // LODs are drawn small, cache order is all they need
+        std::vector<std::vector<unsigned int> *> index_lists = {&indices};
+        for (MeshLod &lod: lods) {
+            optimize_vertex_cache(lod.indices, vertex_count);
+            index_lists.push_back(&lod.indices);
+        }
+        optimize_vertex_fetch(vertices, index_lists);
+
+        stats.acmr_after = calculate_acmr(indices, vertices.size());
+        return stats;
+    }
+
+    MeshOptimizationStats MeshOptimizer::optimize(std::vector<Vertex> &vertices, std::vector<unsigned int> &indices) {
+        std::vector<MeshLod> no_lods;
+        return optimize(vertices, indices, no_lods);
+    }
+
+    std::vector<uint32_t> MeshOptimizer::optimize_vertex_cache(std::vector<unsigned int> &indices,
+                                                               const size_t vertex_count) {
+        std::vector<uint32_t> cluster_starts;
+        const size_t triangle_count = indices.size() / 3;
+        if (triangle_count == 0) return cluster_starts;
+
+        // Triangles around each vertex, as ranges of one shared list
+        std::vector<uint32_t> live(vertex_count, 0);
+        for (const unsigned int index: indices) live[index]++;
+        std::vector<uint32_t> adjacency_offsets(vertex_count + 1, 0);
+        std::partial_sum(live.begin(), live.end(), adjacency_offsets.begin() + 1);
+        std::vector<uint32_t> adjacency(indices.size());
+        std::vector<uint32_t> fill(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+        for (uint32_t triangle = 0; triangle < triangle_count; triangle++) {
+            for (int corner = 0; corner < 3; corner++) {
+                adjacency[fill[indices[triangle * 3 + corner]]++] = triangle;
+            }
+        }
+
+        // Tipsify: emit every triangle around a fanning vertex, then fan around the neighbour that
+        // will still be in the cache once its own triangles are emitted
+        std::vector<uint32_t> cache_time(vertex_count, 0);
+        std::vector<uint8_t> emitted(triangle_count, 0);
+        std::vector<uint32_t> dead_end;
+        std::vector<uint32_t> candidates;
+        std::vector<unsigned int> output;
+        output.reserve(indices.size());
+        uint32_t time = CACHE_SIZE + 1;
+        size_t cursor = 0;
+
+        auto next_unfinished = [&]() -> int64_t {
+            while (cursor < vertex_count && live[cursor] == 0) cursor++;
+            return cursor < vertex_count ? static_cast<int64_t>(cursor) : -1;
+        };
+
+        int64_t fanning = next_unfinished();
+        while (fanning >= 0) {
+            candidates.clear();
+            for (uint32_t a = adjacency_offsets[fanning]; a < adjacency_offsets[fanning + 1]; a++) {
+                const uint32_t triangle = adjacency[a];
+                if (emitted[triangle]) continue;
+                emitted[triangle] = 1;
+
+                for (int corner = 0; corner < 3; corner++) {
+                    const uint32_t vertex = indices[triangle * 3 + corner];
+                    output.push_back(vertex);
+                    dead_end.push_back(vertex);
+                    candidates.push_back(vertex);
+                    live[vertex]--;
+                    if (time - cache_time[vertex] > CACHE_SIZE) {
+                        cache_time[vertex] = time++;
+                    }
+                }
+            }
+
+            int64_t next = -1;
+            int64_t best_priority = -1;
+            for (const uint32_t vertex: candidates) {
+                if (live[vertex] == 0) continue;
+                // Age in the cache once fanned, or 0 when its triangles would push it out
+                int64_t priority = 0;
+                if (time - cache_time[vertex] + 2 * live[vertex] <= CACHE_SIZE) {
+                    priority = time - cache_time[vertex];
+                }
+                if (priority > best_priority) {
+                    best_priority = priority;
+                    next = vertex;
+                }
+            }
+
+            // Dead end: go back to a recently used vertex, failing that to any unfinished one
+            while (next < 0 && !dead_end.empty()) {
+                const uint32_t vertex = dead_end.back();
+                dead_end.pop_back();
+                if (live[vertex] > 0) next = vertex;
+            }
+            fanning = next >= 0 ? next : next_unfinished();
+        }
+        indices = std::move(output);
+
+        // A triangle missing the cache on all three corners starts from a cold cache, so
+        // clusters split there can be reordered without costing cache hits
+        std::vector<uint32_t> cache_stamp(vertex_count, 0);
+        uint32_t cache_clock = CACHE_SIZE + 1;
+        for (uint32_t triangle = 0; triangle < triangle_count; triangle++) {
+            int misses = 0;
+            for (int corner = 0; corner < 3; corner++) {
+                const uint32_t vertex = indices[triangle * 3 + corner];
+                if (cache_clock - cache_stamp[vertex] > CACHE_SIZE) {
+                    cache_stamp[vertex] = cache_clock++;
+                    misses++;
+                }
+            }
+            if (misses == 3 || triangle == 0) cluster_starts.push_back(triangle * 3);
+        }
+        return cluster_starts;
+    }
+
+    void MeshOptimizer::optimize_overdraw(std::vector<unsigned int> &indices, const std::vector<Vertex> &vertices,
+                                          const std::vector<uint32_t> &cluster_starts) {
+        if (cluster_starts.size() < 2) return;
+
+        struct Cluster {
+            uint32_t first_index;
+            uint32_t index_count;
+            float sort_key;
+        };
+
+        // Area weighted center and normal of each cluster
+        std::vector<Cluster> clusters;
+        std::vector<glm::vec3> centers;
+        std::vector<glm::vec3> normals;
+        glm::vec3 mesh_center(0.0f);
+        float mesh_area = 0.0f;
+        for (size_t c = 0; c < cluster_starts.size(); c++) {
+            const uint32_t first = cluster_starts[c];
+            const uint32_t end = c + 1 < cluster_starts.size()
+                                     ? cluster_starts[c + 1]
+                                     : static_cast<uint32_t>(indices.size());
+            glm::vec3 center(0.0f);
+            glm::vec3 normal(0.0f);
+            float area = 0.0f;
+            for (uint32_t i = first; i < end; i += 3) {
+                const glm::vec3 &a = vertices[indices[i]].position;
+                const glm::vec3 &b = vertices[indices[i + 1]].position;
+                const glm::vec3 &p = vertices[indices[i + 2]].position;
+                const glm::vec3 cross = glm::cross(b - a, p - a);
+                const float triangle_area = glm::length(cross) * 0.5f;
+                center += (a + b + p) / 3.0f * triangle_area;
+                normal += cross;
+                area += triangle_area;
+            }
+            mesh_center += center;
+            mesh_area += area;
+            centers.push_back(area > 0.0f ? center / area : center);
+            normals.push_back(glm::length(normal) > 0.0f ? glm::normalize(normal) : normal);
+            clusters.push_back({first, end - first, 0.0f});
+        }
+        if (mesh_area > 0.0f) mesh_center /= mesh_area;
+
+        // Clusters far out along their own normal occlude the rest from most directions
+        for (size_t c = 0; c < clusters.size(); c++) {
+            clusters[c].sort_key = glm::dot(centers[c] - mesh_center, normals[c]);
+        }
+        std::stable_sort(clusters.begin(), clusters.end(),
+                         [](const Cluster &a, const Cluster &b) { return a.sort_key > b.sort_key; });
+
+        std::vector<unsigned int> sorted;
+        sorted.reserve(indices.size());
+        for (const Cluster &cluster: clusters) {
+            sorted.insert(sorted.end(), indices.begin() + cluster.first_index,
+                          indices.begin() + cluster.first_index + cluster.index_count);
+        }
+        indices = std::move(sorted);
+    }
+
+    void MeshOptimizer::optimize_vertex_fetch(std::vector<Vertex> &vertices,
+                                              const std::vector<std::vector<unsigned int> *> &index_lists) {
+        constexpr uint32_t UNUSED = std::numeric_limits<uint32_t>::max();
+        std::vector<uint32_t> remap(vertices.size(), UNUSED);
+        uint32_t next_vertex = 0;
+        for (std::vector<unsigned int> *list: index_lists) {
+            for (unsigned int &index: *list) {
+                if (remap[index] == UNUSED) remap[index] = next_vertex++;
+                index = remap[index];
+            }
+        }
+
+        std::vector<Vertex> remapped(next_vertex);
+        for (size_t vertex = 0; vertex < vertices.size(); vertex++) {
+            if (remap[vertex] != UNUSED) remapped[remap[vertex]] = vertices[vertex];
+        }
+        vertices = std::move(remapped);
+    }
+
+    float MeshOptimizer::calculate_acmr(const std::vector<unsigned int> &indices, const size_t vertex_count,
+                                        const uint32_t cache_size) {
+        if (indices.size() < 3) return 0.0f;
+
+        // An entry is evicted once cache_size newer vertices went in after it
+        std::vector<uint32_t> cache_stamp(vertex_count, 0);
+        uint32_t clock = cache_size + 1;
+        uint32_t misses = 0;
+        for (const unsigned int index: indices) {
+            if (clock - cache_stamp[index] > cache_size) {
+                cache_stamp[index] = clock++;
+                misses++;
+            }
+        }
+        return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+    }
+}
@@ -0,0 +1,55 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "MeshLod.h"
+#include "hellfire/graphics/Vertex.h"
+
+namespace hellfire {
+    /// Average cache miss ratio (vertex shader runs per triangle) before and after optimize()
+    struct MeshOptimizationStats {
+        float acmr_before = 0.0f;
+        float acmr_after = 0.0f;
+        uint32_t clusters = 0; // Triangle clusters reordered against overdraw
+    };
+
+    /**
+     * @brief Reorders mesh data for the GPU without changing what is drawn.
+     *
+     * Three steps: triangles are reordered for the post-transform vertex cache (Tipsify),
+     * the clusters that produces are sorted outside-in so near faces tend to be drawn first,
+     * and vertices are renumbered in first use order so vertex fetch reads the buffer linearly.
+     */
+    class MeshOptimizer {
+    public:
+        static constexpr uint32_t CACHE_SIZE = 16; // FIFO entries assumed for the post-transform cache
+
+        /**
+         * @brief Run every step on a mesh and its LODs, which must index the same vertices.
+         * Vertices no triangle uses are dropped.
+         */
+        static MeshOptimizationStats optimize(std::vector<Vertex> &vertices, std::vector<unsigned int> &indices,
+                                              std::vector<MeshLod> &lods);
+
+        static MeshOptimizationStats optimize(std::vector<Vertex> &vertices, std::vector<unsigned int> &indices);
+
+        /// Reorder triangles for vertex cache hits, returns the index where each cluster starts
+        static std::vector<uint32_t> optimize_vertex_cache(std::vector<unsigned int> &indices, size_t vertex_count);
+
+        /// Sort the clusters so outward facing ones on the outside of the mesh come first
+        static void optimize_overdraw(std::vector<unsigned int> &indices, const std::vector<Vertex> &vertices,
+                                      const std::vector<uint32_t> &cluster_starts);
+
+        /// Renumber vertices in order of first use by index_lists, unused vertices are dropped
+        static void optimize_vertex_fetch(std::vector<Vertex> &vertices,
+                                          const std::vector<std::vector<unsigned int> *> &index_lists);
+
+        /// Cache misses per triangle, simulating a FIFO cache of cache_size entries
+        static float calculate_acmr(const std::vector<unsigned int> &indices, size_t vertex_count,
+                                    uint32_t cache_size = CACHE_SIZE);
+    };
+}
@@ -0,0 +1,461 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <queue>
+
+#include <glm/glm.hpp>
+
+namespace hellfire {
+    namespace {
+        /// Sum of plane equations as a symmetric 4x4 matrix, with the total weight they were added with
+        struct Quadric {
+            double m[10] = {}; // Upper triangle: xx, xy, xz, xw, yy, yz, yw, zz, zw, ww
+            double weight = 0.0;
+
+            void add_plane(const glm::dvec3 &normal, const double d, const double plane_weight) {
+                const double plane[4] = {normal.x, normal.y, normal.z, d};
+                int i = 0;
+                for (int row = 0; row < 4; row++) {
+                    for (int column = row; column < 4; column++) {
+                        m[i++] += plane[row] * plane[column] * plane_weight;
+                    }
+                }
+                weight += plane_weight;
+            }
+
+            Quadric &operator+=(const Quadric &other) {
+                for (int i = 0; i < 10; i++) m[i] += other.m[i];
+                weight += other.weight;
+                return *this;
+            }
+
+            /// Weighted mean of the squared distances from p to the planes
+            double evaluate(const glm::dvec3 &p) const {
+                if (weight <= 0.0) return 0.0;
+                const double error = m[0] * p.x * p.x + 2.0 * m[1] * p.x * p.y + 2.0 * m[2] * p.x * p.z +
+                                     2.0 * m[3] * p.x + m[4] * p.y * p.y + 2.0 * m[5] * p.y * p.z +
+                                     2.0 * m[6] * p.y + m[7] * p.z * p.z + 2.0 * m[8] * p.z + m[9];
+                return std::max(error, 0.0) / weight;
+            }
+        };
+
+        /// How different two vertices look, used when a collapse replaces one with the other
+        double attribute_distance(const Vertex &a, const Vertex &b) {
+            const glm::vec2 uv = a.texCoords - b.texCoords;
+            const glm::vec3 normal = a.normal - b.normal;
+            const glm::vec3 color = a.color - b.color;
+            return glm::dot(uv, uv) + 0.25 * glm::dot(normal, normal) + glm::dot(color, color);
+        }
+
+        struct Collapse {
+            double cost;
+            uint32_t from;
+            uint32_t to;
+
+            // Lowest cost on top of the priority queue
+            bool operator<(const Collapse &other) const { return cost > other.cost; }
+        };
+
+        /**
+         * Half-edge collapses on welded positions. A triangle corner keeps its own vertex (wedge),
+         * when its position collapses the corner moves to the wedge of the target position that
+         * shares a triangle with it, so both sides of a UV seam stay apart.
+         */
+        class EdgeCollapser {
+        public:
+            EdgeCollapser(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices)
+                : vertices_(vertices) {
+                weld_positions();
+                build_triangles(indices);
+                build_quadrics();
+
+                // Every edge is seen from both ends, so one direction per visit covers both
+                for (uint32_t position = 0; position < positions_.size(); position++) {
+                    push_collapses_around(position, false);
+                }
+            }
+
+            MeshLod run(const size_t target_index_count, const float max_error) {
+                const double max_squared_error = static_cast<double>(max_error) * max_error;
+                double squared_error = 0.0;
+
+                while (live_triangles_ * 3 > target_index_count && !queue_.empty()) {
+                    const Collapse collapse = queue_.top();
+                    queue_.pop();
+                    if (!position_alive_[collapse.from] || !position_alive_[collapse.to]) continue;
+
+                    double geometric_cost, cost;
+                    if (!evaluate(collapse.from, collapse.to, geometric_cost, cost)) continue;
+
+                    // Neighbouring collapses changed the cost since it was queued
+                    if (cost > collapse.cost * (1.0 + 1e-6) + 1e-30) {
+                        queue_.push({cost, collapse.from, collapse.to});
+                        continue;
+                    }
+                    if (geometric_cost > max_squared_error) continue;
+
+                    execute(collapse.from, collapse.to);
+                    squared_error = std::max(squared_error, geometric_cost);
+                }
+
+                MeshLod lod;
+                lod.indices.reserve(live_triangles_ * 3);
+                for (size_t t = 0; t < triangles_.size(); t++) {
+                    if (!triangle_alive_[t]) continue;
+                    lod.indices.insert(lod.indices.end(), triangles_[t].begin(), triangles_[t].end());
+                }
+                lod.error = static_cast<float>(std::sqrt(squared_error));
+                return lod;
+            }
+
+        private:
+            const std::vector<Vertex> &vertices_;
+
+            std::vector<uint32_t> position_ids_; // Per vertex, its welded position
+            std::vector<glm::dvec3> positions_;
+            std::vector<Quadric> quadrics_;
+            std::vector<uint8_t> position_alive_;
+            std::vector<uint8_t> on_border_; // Position lies on an open edge
+            std::vector<std::vector<uint32_t> > position_triangles_; // Triangles around a position, dead ones included
+
+            std::vector<std::array<uint32_t, 3> > triangles_; // Vertex indices
+            std::vector<uint8_t> triangle_alive_;
+            size_t live_triangles_ = 0;
+
+            double attribute_weight_ = 0.0;
+            std::priority_queue<Collapse> queue_;
+
+            // Scratch
+            std::vector<uint32_t> wedges_;
+            std::vector<uint32_t> neighbours_from_;
+            std::vector<uint32_t> neighbours_to_;
+
+            uint32_t position_of(const uint32_t vertex) const { return position_ids_[vertex]; }
+
+            void weld_positions() {
+                std::vector<uint32_t> order(vertices_.size());
+                std::iota(order.begin(), order.end(), 0u);
+                const auto less = [&](const uint32_t a, const uint32_t b) {
+                    const glm::vec3 &pa = vertices_[a].position;
+                    const glm::vec3 &pb = vertices_[b].position;
+                    if (pa.x != pb.x) return pa.x < pb.x;
+                    if (pa.y != pb.y) return pa.y < pb.y;
+                    return pa.z < pb.z;
+                };
+                std::sort(order.begin(), order.end(), less);
+
+                position_ids_.resize(vertices_.size());
+                for (size_t i = 0; i < order.size(); i++) {
+                    if (i == 0 || vertices_[order[i]].position != vertices_[order[i - 1]].position) {
+                        positions_.emplace_back(vertices_[order[i]].position);
+                    }
+                    position_ids_[order[i]] = static_cast<uint32_t>(positions_.size() - 1);
+                }
+
+                position_alive_.assign(positions_.size(), 1);
+                on_border_.assign(positions_.size(), 0);
+                position_triangles_.resize(positions_.size());
+            }
+
+            void build_triangles(const std::vector<unsigned int> &indices) {
+                const auto vertex_count = static_cast<unsigned int>(vertices_.size());
+                for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+                    if (indices[i] >= vertex_count || indices[i + 1] >= vertex_count || indices[i + 2] >= vertex_count) {
+                        continue;
+                    }
+                    const uint32_t a = position_of(indices[i]);
+                    const uint32_t b = position_of(indices[i + 1]);
+                    const uint32_t c = position_of(indices[i + 2]);
+                    if (a == b || b == c || c == a) continue;
+
+                    const auto triangle = static_cast<uint32_t>(triangles_.size());
+                    triangles_.push_back({indices[i], indices[i + 1], indices[i + 2]});
+                    for (const uint32_t position: {a, b, c}) {
+                        position_triangles_[position].push_back(triangle);
+                    }
+                }
+                triangle_alive_.assign(triangles_.size(), 1);
+                live_triangles_ = triangles_.size();
+
+                glm::dvec3 min(std::numeric_limits<double>::max());
+                glm::dvec3 max(std::numeric_limits<double>::lowest());
+                for (const glm::dvec3 &position: positions_) {
+                    min = glm::min(min, position);
+                    max = glm::max(max, position);
+                }
+                // Attribute differences are weighed like a surface error of half the mesh radius
+                const double radius = positions_.empty() ? 0.0 : glm::length(max - min) * 0.5;
+                attribute_weight_ = 0.25 * radius * radius;
+            }
+
+            /// Live triangles around from that also use to
+            uint32_t count_shared_triangles(const uint32_t from, const uint32_t to) const {
+                uint32_t shared = 0;
+                for (const uint32_t t: position_triangles_[from]) {
+                    if (!triangle_alive_[t]) continue;
+                    for (const uint32_t vertex: triangles_[t]) {
+                        if (position_of(vertex) == to) shared++;
+                    }
+                }
+                return shared;
+            }
+
+            void build_quadrics() {
+                quadrics_.resize(positions_.size());
+                for (const auto &triangle: triangles_) {
+                    const uint32_t corners[3] = {
+                        position_of(triangle[0]), position_of(triangle[1]), position_of(triangle[2])
+                    };
+                    const glm::dvec3 &p0 = positions_[corners[0]];
+                    const glm::dvec3 normal = glm::cross(positions_[corners[1]] - p0, positions_[corners[2]] - p0);
+                    const double double_area = glm::length(normal);
+                    if (double_area <= 0.0) continue;
+
+                    const glm::dvec3 unit_normal = normal / double_area;
+                    const double area = double_area * 0.5;
+                    for (const uint32_t corner: corners) {
+                        quadrics_[corner].add_plane(unit_normal, -glm::dot(unit_normal, p0), area);
+                    }
+
+                    // Open edges get a plane standing up along them, so the border keeps its shape
+                    for (int edge = 0; edge < 3; edge++) {
+                        const uint32_t a = corners[edge];
+                        const uint32_t b = corners[(edge + 1) % 3];
+                        if (count_shared_triangles(a, b) != 1) continue;
+
+                        on_border_[a] = on_border_[b] = 1;
+                        const glm::dvec3 edge_direction = positions_[b] - positions_[a];
+                        const glm::dvec3 border_normal = glm::cross(edge_direction, unit_normal);
+                        const double length = glm::length(border_normal);
+                        if (length <= 0.0) continue;
+
+                        const glm::dvec3 unit_border_normal = border_normal / length;
+                        const double d = -glm::dot(unit_border_normal, positions_[a]);
+                        quadrics_[a].add_plane(unit_border_normal, d, area);
+                        quadrics_[b].add_plane(unit_border_normal, d, area);
+                    }
+                }
+            }
+
+            /// Wedge of to that a corner of from using vertex takes over when from collapses onto to
+            uint32_t map_wedge(const uint32_t vertex, const uint32_t from, const uint32_t to) const {
+                // Prefer the wedge on the same side of any seam, the one sharing a triangle with this corner
+                for (const uint32_t t: position_triangles_[from]) {
+                    if (!triangle_alive_[t]) continue;
+                    const auto &triangle = triangles_[t];
+                    if (triangle[0] != vertex && triangle[1] != vertex && triangle[2] != vertex) continue;
+                    for (const uint32_t corner: triangle) {
+                        if (position_of(corner) == to) return corner;
+                    }
+                }
+
+                // Across a seam from to, the most similar of its wedges
+                uint32_t best = UINT32_MAX;
+                double best_distance = std::numeric_limits<double>::max();
+                for (const uint32_t t: position_triangles_[to]) {
+                    if (!triangle_alive_[t]) continue;
+                    for (const uint32_t corner: triangles_[t]) {
+                        if (position_of(corner) != to) continue;
+                        const double distance = attribute_distance(vertices_[vertex], vertices_[corner]);
+                        if (distance < best_distance) {
+                            best_distance = distance;
+                            best = corner;
+                        }
+                    }
+                }
+                return best;
+            }
+
+            void gather_wedges(const uint32_t position) {
+                wedges_.clear();
+                for (const uint32_t t: position_triangles_[position]) {
+                    if (!triangle_alive_[t]) continue;
+                    for (const uint32_t corner: triangles_[t]) {
+                        if (position_of(corner) == position &&
+                            std::find(wedges_.begin(), wedges_.end(), corner) == wedges_.end()) {
+                            wedges_.push_back(corner);
+                        }
+                    }
+                }
+            }
+
+            void gather_neighbours(const uint32_t position, std::vector<uint32_t> &neighbours) const {
+                neighbours.clear();
+                for (const uint32_t t: position_triangles_[position]) {
+                    if (!triangle_alive_[t]) continue;
+                    for (const uint32_t corner: triangles_[t]) {
+                        const uint32_t neighbour = position_of(corner);
+                        if (neighbour != position &&
+                            std::find(neighbours.begin(), neighbours.end(), neighbour) == neighbours.end()) {
+                            neighbours.push_back(neighbour);
+                        }
+                    }
+                }
+            }
+
+            bool evaluate(const uint32_t from, const uint32_t to, double &geometric_cost, double &cost) {
+                const glm::dvec3 &target = positions_[to];
+
+                uint32_t shared_triangles = 0;
+                for (const uint32_t t: position_triangles_[from]) {
+                    if (!triangle_alive_[t]) continue;
+                    const auto &triangle = triangles_[t];
+                    glm::dvec3 before[3], after[3];
+                    bool uses_target = false;
+                    for (int i = 0; i < 3; i++) {
+                        const uint32_t position = position_of(triangle[i]);
+                        uses_target = uses_target || position == to;
+                        before[i] = positions_[position];
+                        after[i] = position == from ? target : before[i];
+                    }
+                    if (uses_target) {
+                        shared_triangles++;
+                        continue;
+                    }
+
+                    // Reject folds: the moved triangle must keep roughly facing the same way
+                    const glm::dvec3 normal_before = glm::cross(before[1] - before[0], before[2] - before[0]);
+                    const glm::dvec3 normal_after = glm::cross(after[1] - after[0], after[2] - after[0]);
+                    const double length_before = glm::length(normal_before);
+                    const double length_after = glm::length(normal_after);
+                    if (length_after <= 0.0 || glm::dot(normal_before, normal_after) < 0.2 * length_before * length_after) {
+                        return false;
+                    }
+                }
+                if (shared_triangles == 0) return false;
+
+                // Borders only slide along themselves
+                if (on_border_[from] && shared_triangles != 1) return false;
+
+                // Link condition: positions next to both may only be the tips of the shared triangles,
+                // anything else would pinch the surface into a non-manifold edge
+                gather_neighbours(from, neighbours_from_);
+                gather_neighbours(to, neighbours_to_);
+                uint32_t common = 0;
+                for (const uint32_t neighbour: neighbours_from_) {
+                    if (std::find(neighbours_to_.begin(), neighbours_to_.end(), neighbour) != neighbours_to_.end()) {
+                        common++;
+                    }
+                }
+                if (common > shared_triangles) return false;
+
+                Quadric combined = quadrics_[from];
+                combined += quadrics_[to];
+                geometric_cost = combined.evaluate(target);
+
+                double attribute_cost = 0.0;
+                gather_wedges(from);
+                for (const uint32_t wedge: wedges_) {
+                    const uint32_t replacement = map_wedge(wedge, from, to);
+                    if (replacement == UINT32_MAX) return false;
+                    attribute_cost += attribute_distance(vertices_[wedge], vertices_[replacement]);
+                }
+
+                cost = geometric_cost + attribute_weight_ * attribute_cost;
+                return true;
+            }
+
+            void execute(const uint32_t from, const uint32_t to) {
+                // Resolve every corner's new wedge before triangles start changing
+                gather_wedges(from);
+                std::vector<std::pair<uint32_t, uint32_t> > remap;
+                remap.reserve(wedges_.size());
+                for (const uint32_t wedge: wedges_) {
+                    remap.emplace_back(wedge, map_wedge(wedge, from, to));
+                }
+
+                for (const uint32_t t: position_triangles_[from]) {
+                    if (!triangle_alive_[t]) continue;
+                    auto &triangle = triangles_[t];
+
+                    bool uses_target = false;
+                    for (const uint32_t corner: triangle) {
+                        uses_target = uses_target || position_of(corner) == to;
+                    }
+                    if (uses_target) {
+                        triangle_alive_[t] = 0;
+                        live_triangles_--;
+                        continue;
+                    }
+
+                    for (uint32_t &corner: triangle) {
+                        if (position_of(corner) != from) continue;
+                        for (const auto &[wedge, replacement]: remap) {
+                            if (wedge == corner) {
+                                corner = replacement;
+                                break;
+                            }
+                        }
+                    }
+                    position_triangles_[to].push_back(t);
+                }
+
+                quadrics_[to] += quadrics_[from];
+                position_alive_[from] = 0;
+                position_triangles_[from].clear();
+                position_triangles_[from].shrink_to_fit();
+
+                auto &around = position_triangles_[to];
+                around.erase(std::remove_if(around.begin(), around.end(),
+                                            [&](const uint32_t t) { return !triangle_alive_[t]; }), around.end());
+                push_collapses_around(to, true);
+            }
+
+            void push_collapses_around(const uint32_t position, const bool both_directions) {
+                std::vector<uint32_t> neighbours;
+                gather_neighbours(position, neighbours);
+                for (const uint32_t neighbour: neighbours) {
+                    double geometric_cost, cost;
+                    if (evaluate(position, neighbour, geometric_cost, cost)) {
+                        queue_.push({cost, position, neighbour});
+                    }
+                    if (both_directions && evaluate(neighbour, position, geometric_cost, cost)) {
+                        queue_.push({cost, neighbour, position});
+                    }
+                }
+            }
+        };
+    }
+
+    MeshLod MeshSimplifier::simplify(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices,
+                                     const size_t target_index_count, const float max_error) {
+        EdgeCollapser collapser(vertices, indices);
+        return collapser.run(target_index_count, max_error);
+    }
+
+    std::vector<MeshLod> MeshSimplifier::build_lod_chain(const std::vector<Vertex> &vertices,
+                                                         const std::vector<unsigned int> &indices,
+                                                         const std::vector<float> &ratios) {
+        std::vector<MeshLod> lods;
+        const size_t full_triangles = indices.size() / 3;
+        std::vector<unsigned int> source = indices;
+        float source_error = 0.0f;
+
+        for (const float ratio: ratios) {
+            if (lods.size() + 1 >= MAX_MESH_LODS) break;
+
+            const size_t target_index_count = static_cast<size_t>(static_cast<float>(full_triangles) * ratio) * 3;
+            if (target_index_count >= source.size()) continue;
+
+            MeshLod lod = simplify(vertices, source, target_index_count);
+
+            // Mostly borders and seams that can't collapse any further
+            if (lod.indices.empty() || static_cast<float>(lod.indices.size()) > 0.9f * static_cast<float>(source.size())) {
+                break;
+            }
+
+            // Each level was measured against the previous one, so the errors add up
+            lod.error += source_error;
+            source_error = lod.error;
+            source = lod.indices;
+            lods.push_back(std::move(lod));
+        }
+        return lods;
+    }
+}
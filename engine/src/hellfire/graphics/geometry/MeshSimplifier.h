@@ -0,0 +1,42 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#pragma once
+
+#include <limits>
+#include <vector>
+
+#include "MeshLod.h"
+#include "hellfire/graphics/Vertex.h"
+
+namespace hellfire {
+    /**
+     * @brief Quadric error edge collapse simplification for generating mesh LODs.
+     *
+     * Vertices are welded by position and collapsed onto one of their neighbours, so the
+     * simplified mesh only references vertices of the original and keeps their attributes.
+     * Where a collapse would stretch UVs, normals or colors across a seam or crease, that
+     * difference is added to its cost. Open borders only collapse along themselves and
+     * collapses that flip a triangle are rejected.
+     */
+    class MeshSimplifier {
+    public:
+        /**
+         * @brief Simplify until at most target_index_count indices are left.
+         * Stops early when the next collapse would move the surface further than max_error.
+         * @return Indices into vertices and the geometric error of the result
+         */
+        static MeshLod simplify(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices,
+                                size_t target_index_count,
+                                float max_error = std::numeric_limits<float>::max());
+
+        /**
+         * @brief LOD 1 and up at the given fractions of the full triangle count.
+         * Every level is simplified from the previous one; the chain ends early once a level
+         * no longer removes a meaningful share of the triangles.
+         */
+        static std::vector<MeshLod> build_lod_chain(const std::vector<Vertex> &vertices,
+                                                    const std::vector<unsigned int> &indices,
+                                                    const std::vector<float> &ratios = {0.5f, 0.25f, 0.125f});
+    };
+}
@@ -0,0 +1,67 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include "RangeAllocator.h"
+
+#include <iterator>
+
+namespace hellfire {
+    RangeAllocator::RangeAllocator(const uint32_t capacity) {
+        grow(capacity);
+    }
+
+    uint32_t RangeAllocator::allocate(const uint32_t size) {
+        if (size == 0) return INVALID_OFFSET;
+
+        for (auto it = free_blocks_.begin(); it != free_blocks_.end(); ++it) {
+            auto [offset, block_size] = *it;
+            if (block_size < size) continue;
+
+            free_blocks_.erase(it);
+            if (block_size > size) {
+                free_blocks_.emplace(offset + size, block_size - size);
+            }
+
+            used_ += size;
+            return offset;
+        }
+
+        return INVALID_OFFSET;
+    }
+
+    void RangeAllocator::free(uint32_t offset, uint32_t size) {
+        if (size == 0 || offset == INVALID_OFFSET) return;
+
+        used_ -= size;
+
+        // Merge with the following block
+        const auto next = free_blocks_.lower_bound(offset);
+        if (next != free_blocks_.end() && offset + size == next->first) {
+            size += next->second;
+            free_blocks_.erase(next);
+        }
+
+        // Merge with the preceding block
+        auto it = free_blocks_.lower_bound(offset);
+        if (it != free_blocks_.begin()) {
+            const auto previous = std::prev(it);
+            if (previous->first + previous->second == offset) {
+                previous->second += size;
+                return;
+            }
+        }
+
+        free_blocks_.emplace(offset, size);
+    }
+
+    void RangeAllocator::grow(const uint32_t new_capacity) {
+        if (new_capacity <= capacity_) return;
+
+        const uint32_t old_capacity = capacity_;
+        capacity_ = new_capacity;
+
+        // Hand the new tail to free(), which merges it with a free block at the old end
+        used_ += new_capacity - old_capacity;
+        free(old_capacity, new_capacity - old_capacity);
+    }
+}
@@ -0,0 +1,41 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+
+namespace hellfire {
+    /**
+     * @brief First-fit allocator for ranges of a linear buffer (vertices, indices, ...).
+     *
+     * Only tracks offsets, the caller owns the storage. Freed ranges are merged with their
+     * neighbours so the free list stays short.
+     */
+    class RangeAllocator {
+    public:
+        static constexpr uint32_t INVALID_OFFSET = std::numeric_limits<uint32_t>::max();
+
+        explicit RangeAllocator(uint32_t capacity = 0);
+
+        /// @return Offset of the range, or INVALID_OFFSET when no free block is large enough
+        uint32_t allocate(uint32_t size);
+
+        void free(uint32_t offset, uint32_t size);
+
+        /// Extend the managed range, the new space is appended as free
+        void grow(uint32_t new_capacity);
+
+        uint32_t get_capacity() const { return capacity_; }
+        uint32_t get_used() const { return used_; }
+        size_t get_free_block_count() const { return free_blocks_.size(); }
+
+    private:
+        std::map<uint32_t, uint32_t> free_blocks_; // Offset -> size, ordered by offset
+        uint32_t capacity_ = 0;
+        uint32_t used_ = 0;
+    };
+}
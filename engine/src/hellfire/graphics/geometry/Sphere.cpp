@@ -6,6 +6,7 @@
 #include "hellfire/ecs/RenderableComponent.h"
 #include "hellfire/ecs/TransformComponent.h"
 #include "hellfire/ecs/components/MeshComponent.h"
+#include "hellfire/graphics/geometry/MeshOptimizer.h"
 #include "hellfire/scene/Scene.h"
 
 namespace hellfire {
@@ -99,6 +100,8 @@ namespace hellfire {
                 indices.push_back(next);
             }
         }
+
+        MeshOptimizer::optimize(vertices, indices);
     }
 
     void Sphere::subdivide_triangle(std::vector<glm::vec3> &vertices, const glm::vec3 &v1, const glm::vec3 &v2, const glm::vec3 &v3,
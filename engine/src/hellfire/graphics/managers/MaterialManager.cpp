@@ -19,14 +19,14 @@ namespace hellfire {
         material.bind();
     }
 
-    void MaterialManager::bind_property_to_shader(const Material::Property &property, uint32_t shader_program,
+    void MaterialManager::bind_property_to_shader(const Material::Property &property, UniformTable &uniforms,
                                                   int &texture_unit) {
-        bind_property(property, shader_program, texture_unit);
+        bind_property(property, uniforms, texture_unit);
     }
 
-    void MaterialManager::bind_property(const Material::Property &property, uint32_t shader_program,
+    void MaterialManager::bind_property(const Material::Property &property, UniformTable &uniforms,
                                         int &texture_unit) {
-        const ShaderUniformBinder binder(shader_program);
+        const ShaderUniformBinder binder(uniforms);
         const std::string &uniform_name = property.uniform_name;
 
         switch (property.type) {
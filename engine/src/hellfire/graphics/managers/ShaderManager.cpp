@@ -14,6 +14,7 @@
 
 #include "hellfire/graphics/material/Material.h"
 #include "../backends/opengl/glsl.h"
+#include "hellfire/graphics/backends/opengl/GLStateCache.h"
 #include "hellfire/graphics/texture/Texture.h"
 
 #ifdef _WIN32
@@ -96,6 +97,16 @@ namespace hellfire {
                 continue;
             }
 
+            if (trimmed == "#else") {
+                if (condition_stack.size() > 1) {
+                    // Flip the innermost branch, it stays disabled if the enclosing one is
+                    const bool condition = condition_stack.top();
+                    condition_stack.pop();
+                    condition_stack.push(condition_stack.top() && !condition);
+                }
+                continue;
+            }
+
             if (trimmed == "#endif") {
                 if (condition_stack.size() > 1) {
                     condition_stack.pop();
@@ -208,7 +219,7 @@ namespace hellfire {
         }
     }
 
-    uint32_t ShaderManager::get_shader_for_material(Material &material) {
+    ShaderManager::ShaderVariant ShaderManager::get_variant_for_material(const Material &material) {
         ShaderVariant variant;
 
         // Check if material has custom shader
@@ -228,11 +239,127 @@ namespace hellfire {
             add_automatic_defines(material, variant.defines);
         }
 
-        uint32_t shader_id = load_shader(variant);
+        return variant;
+    }
+
+    uint32_t ShaderManager::get_shader_for_material(Material &material) {
+        uint32_t shader_id = load_shader(get_variant_for_material(material));
         material.set_compiled_shader_id(shader_id);
         return shader_id;
     }
 
+    uint32_t ShaderManager::get_instanced_shader_for_material(const Material &material) {
+        ShaderVariant variant = get_variant_for_material(material);
+        variant.defines.insert(INSTANCED_DEFINE);
+
+        const std::string cache_key = variant.get_key();
+        if (const auto it = compiled_shaders_.find(cache_key); it != compiled_shaders_.end()) {
+            return it->second;
+        }
+        if (unsupported_variants_.contains(cache_key)) {
+            return 0;
+        }
+
+        // Only shaders that read their model matrix from the instance buffer can be batched
+        try {
+            const std::string vertex_source = process_includes(load_shader_file(variant.vertex_path),
+                                                               get_directory_from_path(variant.vertex_path));
+            if (vertex_source.find(std::string("#ifdef ") + INSTANCED_DEFINE) == std::string::npos) {
+                unsupported_variants_.insert(cache_key);
+                return 0;
+            }
+        } catch (const std::exception &e) {
+            std::cerr << "Error loading shader: " << e.what() << std::endl;
+            unsupported_variants_.insert(cache_key);
+            return 0;
+        }
+
+        const uint32_t shader_id = load_shader(variant);
+        if (shader_id == 0) {
+            unsupported_variants_.insert(cache_key);
+        }
+        return shader_id;
+    }
+
+    uint32_t ShaderManager::get_oit_shader_for_material(const Material &material) {
+        ShaderVariant variant = get_variant_for_material(material);
+        variant.defines.insert(OIT_DEFINE);
+
+        const std::string cache_key = variant.get_key();
+        if (const auto it = compiled_shaders_.find(cache_key); it != compiled_shaders_.end()) {
+            return it->second;
+        }
+        if (unsupported_variants_.contains(cache_key)) {
+            return 0;
+        }
+
+        // Only fragment shaders that can write the accumulation and revealage targets take part
+        try {
+            const std::string fragment_source = process_includes(load_shader_file(variant.fragment_path),
+                                                                 get_directory_from_path(variant.fragment_path));
+            if (fragment_source.find(std::string("#ifdef ") + OIT_DEFINE) == std::string::npos) {
+                unsupported_variants_.insert(cache_key);
+                return 0;
+            }
+        } catch (const std::exception &e) {
+            std::cerr << "Error loading shader: " << e.what() << std::endl;
+            unsupported_variants_.insert(cache_key);
+            return 0;
+        }
+
+        const uint32_t shader_id = load_shader(variant);
+        if (shader_id == 0) {
+            unsupported_variants_.insert(cache_key);
+        }
+        return shader_id;
+    }
+
+    uint32_t ShaderManager::get_depth_only_shader_for_material(const Material &material, const bool instanced) {
+        return get_pass_shader_for_material(material, DEPTH_ONLY_FRAGMENT_PATH, instanced, "invariant gl_Position");
+    }
+
+    uint32_t ShaderManager::get_overdraw_shader_for_material(const Material &material, const bool instanced) {
+        return get_pass_shader_for_material(material, OVERDRAW_FRAGMENT_PATH, instanced, nullptr);
+    }
+
+    uint32_t ShaderManager::get_pass_shader_for_material(const Material &material, const char *fragment_path,
+                                                         const bool instanced, const char *required_token) {
+        ShaderVariant variant = get_variant_for_material(material);
+        variant.fragment_path = fragment_path;
+        if (instanced) variant.defines.insert(INSTANCED_DEFINE);
+
+        const std::string cache_key = variant.get_key();
+        if (const auto it = compiled_shaders_.find(cache_key); it != compiled_shaders_.end()) {
+            return it->second;
+        }
+        if (unsupported_variants_.contains(cache_key)) {
+            return 0;
+        }
+
+        try {
+            const std::string vertex_source = process_includes(load_shader_file(variant.vertex_path),
+                                                               get_directory_from_path(variant.vertex_path));
+            const bool has_token = !required_token || vertex_source.find(required_token) != std::string::npos;
+            const bool has_instanced_path = !instanced ||
+                                            vertex_source.find(std::string("#ifdef ") + INSTANCED_DEFINE) !=
+                                            std::string::npos;
+            if (!has_token || !has_instanced_path) {
+                unsupported_variants_.insert(cache_key);
+                return 0;
+            }
+        } catch (const std::exception &e) {
+            std::cerr << "Error loading shader: " << e.what() << std::endl;
+            unsupported_variants_.insert(cache_key);
+            return 0;
+        }
+
+        const uint32_t shader_id = load_shader(variant);
+        if (shader_id == 0) {
+            unsupported_variants_.insert(cache_key);
+        }
+        return shader_id;
+    }
+
     uint32_t ShaderManager::get_shader(const std::string &key) const {
         const auto it = compiled_shaders_.find(key);
         return (it != compiled_shaders_.end()) ? it->second : 0;
@@ -284,9 +411,35 @@ namespace hellfire {
 
         // Clean up compiled shaders
         for (const auto &[key, shader_id]: compiled_shaders_) {
-            glDeleteProgram(shader_id);
+            GLStateCache::delete_program(shader_id);
         }
         compiled_shaders_.clear();
+        unsupported_variants_.clear();
+        uniform_tables_.clear();
+    }
+
+    UniformTable *ShaderManager::get_uniform_table(const uint32_t program_id) {
+        if (program_id == 0) return nullptr;
+
+        auto &table = uniform_tables_[program_id];
+        if (!table) {
+            table = std::make_unique<UniformTable>(program_id);
+        }
+        return table.get();
+    }
+
+    uint32_t ShaderManager::get_uniform_upload_count() const {
+        uint32_t count = 0;
+        for (const auto &[program_id, table]: uniform_tables_) {
+            count += table->get_uploaded_count();
+        }
+        return count;
+    }
+
+    void ShaderManager::reset_uniform_stats() {
+        for (const auto &[program_id, table]: uniform_tables_) {
+            table->reset_stats();
+        }
     }
 
     std::vector<uint32_t> ShaderManager::get_all_shader_ids() const {
@@ -323,8 +476,12 @@ namespace hellfire {
 
         if (program_id == 0) {
             std::cerr << "Failed to link shader program" << std::endl;
+            return 0;
         }
 
+        // Reflect uniform locations once, right after linking
+        uniform_tables_[program_id] = std::make_unique<UniformTable>(program_id);
+
         return program_id;
     }
 }
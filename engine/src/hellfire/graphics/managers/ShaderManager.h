@@ -7,6 +7,9 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <regex>
+#include <memory>
+
+#include "hellfire/graphics/shader/UniformTable.h"
 
 namespace hellfire {
     class Application;
@@ -19,6 +22,10 @@ namespace hellfire {
     private:
         std::unordered_map<std::string, std::string> include_cache_;
         std::unordered_map<std::string, uint32_t> compiled_shaders_;
+        // Instanced and pass variant keys their vertex shader doesn't support, so they're not checked again
+        std::unordered_set<std::string> unsupported_variants_;
+        // Reflected uniform tables, one per linked program, alive as long as the program
+        std::unordered_map<uint32_t, std::unique_ptr<UniformTable>> uniform_tables_;
         
         // Recursively process #include directives
         std::string process_includes(const std::string& source, const std::string& base_path = "shaders/");
@@ -48,9 +55,45 @@ namespace hellfire {
 
         uint32_t load_shader(const ShaderVariant& variant);
 
+        /// Define enabling the per-instance model matrix path in shaders (see common/instance_data.glsl)
+        static constexpr const char *INSTANCED_DEFINE = "INSTANCED";
+
         // Method for material-based shader loading
         uint32_t get_shader_for_material(Material& material);
 
+        /// Variant the material's shader is compiled from: its custom shader or the standard one, plus automatic defines
+        ShaderVariant get_variant_for_material(const Material& material);
+
+        /**
+         * @brief INSTANCED variant of the material's shader.
+         * @return Program id, or 0 when the vertex shader has no INSTANCED path
+         */
+        uint32_t get_instanced_shader_for_material(const Material& material);
+
+        /// Define switching a fragment shader's output to the weighted blended OIT targets (see common/oit_output.glsl)
+        static constexpr const char *OIT_DEFINE = "OIT";
+
+        /**
+         * @brief OIT variant of the material's shader, for the weighted blended transparency pass.
+         * @return Program id, or 0 when the fragment shader has no OIT path
+         */
+        uint32_t get_oit_shader_for_material(const Material& material);
+
+        // Fragment shaders of the renderer's own passes, paired with a material's vertex shader
+        static constexpr const char *DEPTH_ONLY_FRAGMENT_PATH = "assets/shaders/depth_only.frag";
+        static constexpr const char *OVERDRAW_FRAGMENT_PATH = "assets/shaders/overdraw.frag";
+
+        /**
+         * @brief The material's vertex shader with a depth-only fragment shader, for the depth pre-pass.
+         * @return Program id, or 0 when the vertex shader doesn't declare an invariant gl_Position (its
+         *         depth could then differ from the color pass and fail the GL_EQUAL test) or, with instanced
+         *         set, has no INSTANCED path
+         */
+        uint32_t get_depth_only_shader_for_material(const Material& material, bool instanced);
+
+        /// The material's vertex shader with the overdraw visualization fragment shader, 0 if it can't be built
+        uint32_t get_overdraw_shader_for_material(const Material& material, bool instanced);
+
         [[nodiscard]] uint32_t get_shader(const std::string& key) const;
 
         bool has_shader(const std::string& key) const {
@@ -62,6 +105,13 @@ namespace hellfire {
 
         uint32_t load_shader_from_files(const std::string& vertex_path, const std::string& fragment_path);
 
+        /// Uniform table of a program, reflected on first use if the program wasn't linked by this manager.
+        UniformTable *get_uniform_table(uint32_t program_id);
+
+        /// Uniform values sent to GL by every table since reset_uniform_stats()
+        uint32_t get_uniform_upload_count() const;
+        void reset_uniform_stats();
+
         void clear_cache();
 
         ~ShaderManager() {
@@ -74,6 +124,10 @@ namespace hellfire {
         friend class Application;
 
     private:
+        /// Material's vertex shader with another fragment shader, 0 when the vertex source lacks required_token
+        uint32_t get_pass_shader_for_material(const Material& material, const char *fragment_path, bool instanced,
+                                              const char *required_token);
+
         uint32_t compile_shader_program(const std::string& vertex_source, const std::string& fragment_source);
     };
 }
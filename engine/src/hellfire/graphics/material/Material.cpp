@@ -4,12 +4,18 @@
 #include "hellfire/graphics/managers/ShaderManager.h"
 #include "hellfire/graphics/material/Material.h"
 
+#include <atomic>
+
 #include "hellfire/core/Application.h"
+#include "hellfire/graphics/backends/opengl/GLStateCache.h"
 #include "hellfire/utilities/ServiceLocator.h"
 
 namespace hellfire {
     void Material::bind() const {
-        uint32_t shader_program = get_compiled_shader_id();
+        bind(get_compiled_shader_id());
+    }
+
+    void Material::bind(const uint32_t shader_program) const {
         if (shader_program == 0) {
             std::cerr << "Warning: Material " << get_name() << " has no compiled shader!" << std::endl;
             return;
@@ -17,8 +23,16 @@ namespace hellfire {
 
         bound_texture_units_.clear();
 
+        UniformTable *uniforms = ServiceLocator::get_service<ShaderManager>()->get_uniform_table(shader_program);
+        if (!uniforms) return;
+
         int texture_unit = 0;
-        bind_all_properties(shader_program, texture_unit);
+        bind_all_properties(*uniforms, texture_unit);
+    }
+
+    uint32_t Material::next_render_id() {
+        static std::atomic<uint32_t> counter{1};
+        return counter++;
     }
 
     void Material::unbind() const {
@@ -31,18 +45,17 @@ namespace hellfire {
     void Material::unbind_all_textures() const {
         // Unbind all textures that were bound during the last bind() call
         for (int texture_unit : bound_texture_units_) {
-            glActiveTexture(GL_TEXTURE0 + texture_unit);
-            glBindTexture(GL_TEXTURE_2D, 0);
+            GLStateCache::bind_texture_unit(texture_unit, GL_TEXTURE_2D, 0);
         }
         bound_texture_units_.clear();
     }
 
-    void Material::bind_all_properties(const uint32_t shader_program, int &texture_unit) const {
+    void Material::bind_all_properties(UniformTable &uniforms, int &texture_unit) const {
         for (const auto &property: properties_ | std::views::values) {
             // Track texture unit usage
             int start_texture_unit = texture_unit;
             
-            MaterialManager::bind_property_to_shader(property, shader_program, texture_unit);
+            MaterialManager::bind_property_to_shader(property, uniforms, texture_unit);
 
             // If a texture was bound, track which unit it used
             if (property.type == PropertyType::TEXTURE && texture_unit > start_texture_unit) {
@@ -15,6 +15,7 @@ namespace hellfire {
     class MaterialInstance;
     class Application;
     class ShaderManager;
+    class UniformTable;
 }
 
 namespace hellfire {
@@ -102,6 +103,8 @@ namespace hellfire {
         std::map<std::string, Property> properties_;
         std::optional<ShaderInfo> custom_shader_info_;
         uint32_t compiled_shader_id_ = 0;
+        uint32_t render_id_ = next_render_id();
+        uint32_t version_ = 0;
 
         // Instancing support
         std::shared_ptr<Material> base_material_;
@@ -116,11 +119,13 @@ namespace hellfire {
         void set_property(const std::string &name, const T &value, PropertyType type,
                           const std::string &uniform_name = "") {
             properties_[name] = Property(name, value, type, uniform_name);
+            version_++;
         }
 
         template<typename T>
         void set_property(const std::string &name, const T &value, const std::string &uniform_name = "") {
             properties_[name] = Property(name, value, uniform_name);
+            version_++;
         }
 
         // Generic Property Getter
@@ -206,10 +211,12 @@ namespace hellfire {
         // Custom Shader Support
         void set_custom_shader(const std::string &vertex_path, const std::string &fragment_path) {
             custom_shader_info_ = ShaderInfo{vertex_path, fragment_path};
+            version_++;
         }
 
         void set_custom_shader(const ShaderInfo &shader_info) {
             custom_shader_info_ = shader_info;
+            version_++;
         }
 
         void add_shader_define(const std::string &define) {
@@ -234,14 +241,24 @@ namespace hellfire {
 
         void set_compiled_shader_id(uint32_t shader_id) {
             compiled_shader_id_ = shader_id;
+            version_++;
         }
 
         uint32_t get_compiled_shader_id() const {
             return compiled_shader_id_;
         }
 
+        /// Id used to group draws by material in render sort keys
+        uint32_t get_render_id() const { return render_id_; }
+
+        /// Bumped on every property or shader change, so caches of derived state can revalidate cheaply
+        uint32_t get_version() const { return version_; }
+
         /// Used to bind a Material for rendering
         void bind() const;
+
+        /// Bind to a variant of the material's shader (e.g. its instanced one) instead of the compiled program
+        void bind(uint32_t shader_program) const;
         void unbind() const;
 
         void unbind_all_textures() const;
@@ -252,6 +269,8 @@ namespace hellfire {
         void set_name(const std::string &name) { name_ = name; }
     private:
         mutable std::vector<int> bound_texture_units_;
+
+        static uint32_t next_render_id();
         
         Material& set_texture_internal(Texture* texture, TextureType type, int texture_slot) {
             const char* uniform_name = MaterialConstants::get_texture_uniform_name(type);
@@ -273,7 +292,7 @@ namespace hellfire {
             return *this;
         }
 
-        void bind_all_properties(uint32_t shader_program, int &texture_unit) const;
+        void bind_all_properties(UniformTable &uniforms, int &texture_unit) const;
 
         bool has_property(const std::string &name) const {
             return properties_.find(name) != properties_.end();
@@ -0,0 +1,104 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+namespace hellfire {
+    // Must match the defines in assets/shaders/common/light_uniforms.glsl
+    constexpr int MAX_DIRECTIONAL_LIGHTS = 4;
+    constexpr int MAX_SHADOW_CASCADES = 4;
+
+    // Froxel grid of the clustered light lists: screen tiles times exponential depth slices
+    constexpr uint32_t LIGHT_CLUSTER_GRID_X = 16;
+    constexpr uint32_t LIGHT_CLUSTER_GRID_Y = 9;
+    constexpr uint32_t LIGHT_CLUSTER_GRID_Z = 24;
+    constexpr uint32_t LIGHT_CLUSTER_COUNT = LIGHT_CLUSTER_GRID_X * LIGHT_CLUSTER_GRID_Y * LIGHT_CLUSTER_GRID_Z;
+
+    // Fixed binding points shared with the GLSL block declarations
+    constexpr uint32_t FRAME_DATA_BINDING = 0;
+    constexpr uint32_t LIGHT_DATA_BINDING = 1;
+    constexpr uint32_t INSTANCE_DATA_BINDING = 2; // Shader storage binding, see common/instance_data.glsl
+    // Shader storage bindings of the clustered light lists, see common/light_uniforms.glsl
+    constexpr uint32_t POINT_LIGHT_BINDING = 3;
+    constexpr uint32_t LIGHT_CLUSTER_BINDING = 4;
+    constexpr uint32_t LIGHT_INDEX_BINDING = 5;
+
+    // The shadow atlas is bound once per frame to this unit (layout(binding) in light_uniforms.glsl)
+    constexpr int SHADOW_MAP_TEXTURE_UNIT = 10;
+
+    /// std140 mirror of the FrameData block in common/frame_data.glsl
+    struct FrameData {
+        glm::mat4 view;
+        glm::mat4 projection;
+        glm::mat4 view_projection;
+        glm::vec3 view_position;
+        float time;
+        glm::vec3 ambient_light;
+        float padding0;
+    };
+
+    /// std140 mirror of DirectionalLight in common/light_uniforms.glsl
+    struct GPUDirectionalLight {
+        glm::vec3 direction;
+        float padding0;
+        glm::vec3 color;
+        float intensity;
+    };
+
+    /// Mirror of PointLight in common/light_uniforms.glsl, same size under std140 and std430
+    struct GPUPointLight {
+        glm::vec3 position;
+        float padding0;
+        glm::vec3 color;
+        float intensity;
+        float range;
+        float attenuation;
+        float padding1[2];
+    };
+
+    /// std140 mirror of the LightData block in common/light_uniforms.glsl
+    struct LightData {
+        GPUDirectionalLight directional_lights[MAX_DIRECTIONAL_LIGHTS];
+        glm::mat4 shadow_matrices[MAX_DIRECTIONAL_LIGHTS * MAX_SHADOW_CASCADES]; // [light * MAX_SHADOW_CASCADES + cascade]
+        glm::vec4 shadow_tiles[MAX_DIRECTIONAL_LIGHTS * MAX_SHADOW_CASCADES]; // UV rect of each cascade in the atlas
+        glm::vec4 cascade_splits; // View depth where each cascade ends, shared by all lights
+        glm::vec4 cluster_scale; // Pixels to tiles (xy), log view depth to slice (z * log(depth) + w)
+        glm::ivec4 cluster_grid; // LIGHT_CLUSTER_GRID_X/Y/Z, w unused
+        int32_t num_directional_lights;
+        int32_t num_point_lights;
+        float shadow_bias;
+        int32_t num_cascades;
+    };
+
+    /// std430 mirror of LightCluster in common/light_uniforms.glsl: a cluster's range of the light index list
+    struct GPULightCluster {
+        uint32_t offset;
+        uint32_t count;
+    };
+
+    /// std430 mirror of InstanceRecord in common/instance_data.glsl, one per automatically instanced draw
+    struct GPUInstanceData {
+        glm::mat4 model;
+        uint32_t object_id;
+        uint32_t padding0[3];
+    };
+
+    static_assert(sizeof(FrameData) == 224, "FrameData must match the std140 layout");
+    static_assert(offsetof(FrameData, view_position) == 192);
+    static_assert(offsetof(FrameData, ambient_light) == 208);
+    static_assert(sizeof(GPUDirectionalLight) == 32, "DirectionalLight must match the std140 layout");
+    static_assert(sizeof(GPUPointLight) == 48, "PointLight must match the std140 layout");
+    static_assert(offsetof(LightData, shadow_matrices) == 128);
+    static_assert(offsetof(LightData, shadow_tiles) == 1152);
+    static_assert(offsetof(LightData, cascade_splits) == 1408);
+    static_assert(offsetof(LightData, cluster_scale) == 1424);
+    static_assert(offsetof(LightData, cluster_grid) == 1440);
+    static_assert(offsetof(LightData, num_directional_lights) == 1456);
+    static_assert(sizeof(LightData) == 1472, "LightData must match the std140 layout");
+    static_assert(sizeof(GPULightCluster) == 8, "LightCluster must match the std430 array stride");
+    static_assert(sizeof(GPUInstanceData) == 80, "InstanceRecord must match the std430 array stride");
+}
@@ -0,0 +1,167 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include "LightClusters.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace hellfire {
+    namespace {
+        /// Point at the given view depth on the line between two view space points
+        glm::vec3 point_at_depth(const glm::vec3 &near_point, const glm::vec3 &far_point, const float view_depth) {
+            const float t = (view_depth + near_point.z) / (near_point.z - far_point.z);
+            return near_point + (far_point - near_point) * t;
+        }
+
+        uint32_t get_tile(const float ndc, const uint32_t tile_count) {
+            const auto tile = static_cast<int>(std::floor((ndc * 0.5f + 0.5f) * static_cast<float>(tile_count)));
+            return static_cast<uint32_t>(std::clamp(tile, 0, static_cast<int>(tile_count) - 1));
+        }
+    }
+
+    void LightClusters::set_projection(const glm::mat4 &projection, const float near_plane, const float far_plane) {
+        if (projection == projection_ && near_plane == near_plane_ && far_plane == far_plane_ && !bounds_.empty()) {
+            return;
+        }
+        projection_ = projection;
+        near_plane_ = near_plane;
+        far_plane_ = far_plane;
+
+        const float log_ratio = std::log(far_plane / near_plane);
+        depth_scale_ = static_cast<float>(LIGHT_CLUSTER_GRID_Z) / log_ratio;
+        depth_bias_ = -static_cast<float>(LIGHT_CLUSTER_GRID_Z) * std::log(near_plane) / log_ratio;
+
+        // View space line through every tile corner, from the near to the far clip plane
+        constexpr uint32_t corners_x = LIGHT_CLUSTER_GRID_X + 1;
+        const glm::mat4 inverse_projection = glm::inverse(projection);
+        std::vector<glm::vec3> corner_near((LIGHT_CLUSTER_GRID_X + 1) * (LIGHT_CLUSTER_GRID_Y + 1));
+        std::vector<glm::vec3> corner_far(corner_near.size());
+        for (uint32_t y = 0; y <= LIGHT_CLUSTER_GRID_Y; y++) {
+            for (uint32_t x = 0; x <= LIGHT_CLUSTER_GRID_X; x++) {
+                const glm::vec2 ndc(-1.0f + 2.0f * static_cast<float>(x) / LIGHT_CLUSTER_GRID_X,
+                                    -1.0f + 2.0f * static_cast<float>(y) / LIGHT_CLUSTER_GRID_Y);
+                const glm::vec4 near_point = inverse_projection * glm::vec4(ndc, -1.0f, 1.0f);
+                const glm::vec4 far_point = inverse_projection * glm::vec4(ndc, 1.0f, 1.0f);
+                corner_near[y * corners_x + x] = glm::vec3(near_point) / near_point.w;
+                corner_far[y * corners_x + x] = glm::vec3(far_point) / far_point.w;
+            }
+        }
+
+        bounds_.resize(LIGHT_CLUSTER_COUNT);
+        const float depth_ratio = far_plane / near_plane;
+        for (uint32_t z = 0; z < LIGHT_CLUSTER_GRID_Z; z++) {
+            const float slice_near = near_plane * std::pow(depth_ratio, static_cast<float>(z) / LIGHT_CLUSTER_GRID_Z);
+            const float slice_far = near_plane * std::pow(depth_ratio, static_cast<float>(z + 1) / LIGHT_CLUSTER_GRID_Z);
+
+            for (uint32_t y = 0; y < LIGHT_CLUSTER_GRID_Y; y++) {
+                for (uint32_t x = 0; x < LIGHT_CLUSTER_GRID_X; x++) {
+                    Bounds &bounds = bounds_[x + LIGHT_CLUSTER_GRID_X * (y + LIGHT_CLUSTER_GRID_Y * z)];
+                    bounds.min = glm::vec3(std::numeric_limits<float>::max());
+                    bounds.max = glm::vec3(std::numeric_limits<float>::lowest());
+
+                    for (uint32_t corner = 0; corner < 4; corner++) {
+                        const uint32_t index = (y + (corner >> 1)) * corners_x + x + (corner & 1);
+                        for (const float depth: {slice_near, slice_far}) {
+                            const glm::vec3 point = point_at_depth(corner_near[index], corner_far[index], depth);
+                            bounds.min = glm::min(bounds.min, point);
+                            bounds.max = glm::max(bounds.max, point);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void LightClusters::assign(const glm::mat4 &view, const std::vector<Light> &lights) {
+        stats_ = {};
+        stats_.lights = static_cast<uint32_t>(lights.size());
+        clusters_.assign(LIGHT_CLUSTER_COUNT, {0, 0});
+        light_indices_.clear();
+        hits_.clear();
+        if (bounds_.empty()) return;
+
+        for (uint32_t i = 0; i < lights.size(); i++) {
+            const float radius = lights[i].range;
+            if (radius <= 0.0f) continue;
+
+            const glm::vec3 center = glm::vec3(view * glm::vec4(lights[i].position, 1.0f));
+            const float depth = -center.z;
+            if (depth + radius < near_plane_ || depth - radius > far_plane_) continue;
+
+            // Tiles the light can touch; a sphere crossing the near plane may cover any of them
+            uint32_t x_begin = 0, x_end = LIGHT_CLUSTER_GRID_X - 1;
+            uint32_t y_begin = 0, y_end = LIGHT_CLUSTER_GRID_Y - 1;
+            if (depth - radius > near_plane_) {
+                glm::vec2 ndc_min(std::numeric_limits<float>::max());
+                glm::vec2 ndc_max(std::numeric_limits<float>::lowest());
+                for (int corner = 0; corner < 8; corner++) {
+                    const glm::vec3 offset((corner & 1) ? radius : -radius, (corner & 2) ? radius : -radius,
+                                           (corner & 4) ? radius : -radius);
+                    const glm::vec4 clip = projection_ * glm::vec4(center + offset, 1.0f);
+                    const glm::vec2 ndc = glm::vec2(clip) / clip.w;
+                    ndc_min = glm::min(ndc_min, ndc);
+                    ndc_max = glm::max(ndc_max, ndc);
+                }
+                if (ndc_max.x < -1.0f || ndc_min.x > 1.0f || ndc_max.y < -1.0f || ndc_min.y > 1.0f) continue;
+
+                x_begin = get_tile(ndc_min.x, LIGHT_CLUSTER_GRID_X);
+                x_end = get_tile(ndc_max.x, LIGHT_CLUSTER_GRID_X);
+                y_begin = get_tile(ndc_min.y, LIGHT_CLUSTER_GRID_Y);
+                y_end = get_tile(ndc_max.y, LIGHT_CLUSTER_GRID_Y);
+            }
+
+            const uint32_t z_begin = get_slice(depth - radius);
+            const uint32_t z_end = get_slice(depth + radius);
+            const size_t first_hit = hits_.size();
+
+            for (uint32_t z = z_begin; z <= z_end; z++) {
+                for (uint32_t y = y_begin; y <= y_end; y++) {
+                    for (uint32_t x = x_begin; x <= x_end; x++) {
+                        const uint32_t cluster = x + LIGHT_CLUSTER_GRID_X * (y + LIGHT_CLUSTER_GRID_Y * z);
+                        const Bounds &bounds = bounds_[cluster];
+
+                        // Sphere vs box: distance from the center to the closest point of the box
+                        const glm::vec3 closest = glm::clamp(center, bounds.min, bounds.max);
+                        const glm::vec3 delta = closest - center;
+                        if (glm::dot(delta, delta) > radius * radius) continue;
+
+                        hits_.push_back({cluster, i});
+                        clusters_[cluster].count++;
+                    }
+                }
+            }
+            if (hits_.size() > first_hit) stats_.visible_lights++;
+        }
+
+        // Lay the lists out back to back, each in light order
+        uint32_t offset = 0;
+        for (GPULightCluster &cluster: clusters_) {
+            cluster.offset = offset;
+            offset += cluster.count;
+            if (cluster.count > 0) stats_.occupied_clusters++;
+            stats_.max_lights_per_cluster = std::max(stats_.max_lights_per_cluster, cluster.count);
+            cluster.count = 0;
+        }
+
+        light_indices_.resize(hits_.size());
+        for (const Hit &hit: hits_) {
+            GPULightCluster &cluster = clusters_[hit.cluster];
+            light_indices_[cluster.offset + cluster.count++] = hit.light;
+        }
+        stats_.light_indices = static_cast<uint32_t>(light_indices_.size());
+    }
+
+    uint32_t LightClusters::get_cluster_index(const glm::vec2 &screen_uv, const float view_depth) const {
+        const uint32_t x = get_tile(screen_uv.x * 2.0f - 1.0f, LIGHT_CLUSTER_GRID_X);
+        const uint32_t y = get_tile(screen_uv.y * 2.0f - 1.0f, LIGHT_CLUSTER_GRID_Y);
+        return x + LIGHT_CLUSTER_GRID_X * (y + LIGHT_CLUSTER_GRID_Y * get_slice(view_depth));
+    }
+
+    uint32_t LightClusters::get_slice(const float view_depth) const {
+        if (view_depth <= near_plane_) return 0;
+        const auto slice = static_cast<int>(std::floor(std::log(view_depth) * depth_scale_ + depth_bias_));
+        return static_cast<uint32_t>(std::clamp(slice, 0, static_cast<int>(LIGHT_CLUSTER_GRID_Z) - 1));
+    }
+}
@@ -0,0 +1,79 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "FrameData.h"
+#include "glm/glm.hpp"
+
+namespace hellfire {
+    /// Light lists built by the last LightClusters::assign()
+    struct LightClusterStats {
+        uint32_t lights = 0; // Lights handed to assign()
+        uint32_t visible_lights = 0; // Lights that touch at least one cluster
+        uint32_t light_indices = 0; // Entries of all light lists together
+        uint32_t occupied_clusters = 0;
+        uint32_t max_lights_per_cluster = 0;
+    };
+
+    /**
+     * @brief CPU light assignment for clustered forward shading.
+     *
+     * The view frustum is divided into LIGHT_CLUSTER_GRID_X * Y screen tiles and LIGHT_CLUSTER_GRID_Z
+     * exponential depth slices. Every light's bounding sphere is tested against the view space
+     * bounds of the clusters its projection covers, giving a light index list per cluster.
+     * Fragments then only loop over the lights of their own cluster.
+     */
+    class LightClusters {
+    public:
+        struct Light {
+            glm::vec3 position; // World space
+            float range;
+        };
+
+        /// Recompute the cluster bounds, only does work when the projection changed
+        void set_projection(const glm::mat4 &projection, float near_plane, float far_plane);
+
+        /// Build the light lists; light indices refer to the order of lights
+        void assign(const glm::mat4 &view, const std::vector<Light> &lights);
+
+        /// Cluster of a point on screen, the same lookup as getLightCluster() in light_uniforms.glsl
+        uint32_t get_cluster_index(const glm::vec2 &screen_uv, float view_depth) const;
+
+        /// Slice z maps to log(view_depth) * get_depth_scale() + get_depth_bias()
+        float get_depth_scale() const { return depth_scale_; }
+        float get_depth_bias() const { return depth_bias_; }
+
+        const std::vector<GPULightCluster> &get_clusters() const { return clusters_; }
+        const std::vector<uint32_t> &get_light_indices() const { return light_indices_; }
+        const LightClusterStats &get_stats() const { return stats_; }
+
+    private:
+        struct Bounds {
+            glm::vec3 min;
+            glm::vec3 max;
+        };
+
+        struct Hit {
+            uint32_t cluster;
+            uint32_t light;
+        };
+
+        glm::mat4 projection_ = glm::mat4(0.0f);
+        float near_plane_ = 0.0f;
+        float far_plane_ = 0.0f;
+        float depth_scale_ = 0.0f;
+        float depth_bias_ = 0.0f;
+
+        std::vector<Bounds> bounds_; // View space, one per cluster
+        std::vector<GPULightCluster> clusters_;
+        std::vector<uint32_t> light_indices_;
+        std::vector<Hit> hits_; // Scratch, kept to avoid reallocating every frame
+        LightClusterStats stats_;
+
+        uint32_t get_slice(float view_depth) const;
+    };
+}
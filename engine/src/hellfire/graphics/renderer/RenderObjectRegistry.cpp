@@ -0,0 +1,131 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include "RenderObjectRegistry.h"
+
+#include "hellfire/ecs/InstancedRenderableComponent.h"
+#include "hellfire/ecs/RenderableComponent.h"
+#include "hellfire/ecs/TransformComponent.h"
+#include "hellfire/ecs/components/MeshComponent.h"
+
+namespace hellfire {
+    RenderObjectRegistry::~RenderObjectRegistry() {
+        detach();
+    }
+
+    void RenderObjectRegistry::attach(Scene *scene) {
+        if (scene == scene_) return;
+
+        detach();
+        if (!scene) return;
+
+        scene_ = scene;
+        scene_->add_observer(this);
+
+        // Everything already in the scene goes through the regular sync path
+        for (const EntityID entity_id: scene_->get_all_entities() | std::views::keys) {
+            mark_dirty(entity_id);
+        }
+    }
+
+    void RenderObjectRegistry::detach() {
+        if (scene_) scene_->remove_observer(this);
+
+        scene_ = nullptr;
+        objects_.clear();
+        version_++;
+        object_index_.clear();
+        dirty_entities_.clear();
+        queued_.clear();
+        stats_ = {};
+    }
+
+    void RenderObjectRegistry::sync() {
+        stats_.objects_synced = static_cast<uint32_t>(dirty_entities_.size());
+
+        if (scene_) {
+            for (const EntityID entity_id: dirty_entities_) {
+                if (Entity *entity = scene_->get_entity(entity_id)) {
+                    update_object(*entity);
+                } else {
+                    remove_object(entity_id);
+                }
+            }
+        }
+
+        dirty_entities_.clear();
+        queued_.clear();
+        stats_.object_count = static_cast<uint32_t>(objects_.size());
+    }
+
+    void RenderObjectRegistry::on_component_added(Entity &entity, Component &component) {
+        mark_dirty(entity.get_id());
+    }
+
+    void RenderObjectRegistry::on_component_removed(Entity &entity, Component &component) {
+        mark_dirty(entity.get_id());
+    }
+
+    void RenderObjectRegistry::on_component_changed(Entity &entity, Component &component) {
+        mark_dirty(entity.get_id());
+    }
+
+    void RenderObjectRegistry::on_entity_destroyed(Entity &entity) {
+        // The components die with the entity, drop the pointers right away
+        remove_object(entity.get_id());
+    }
+
+    void RenderObjectRegistry::on_scene_destroyed(Scene &scene) {
+        if (&scene == scene_) detach();
+    }
+
+    void RenderObjectRegistry::mark_dirty(const EntityID entity_id) {
+        if (queued_.insert(entity_id).second) {
+            dirty_entities_.push_back(entity_id);
+        }
+    }
+
+    void RenderObjectRegistry::update_object(Entity &entity) {
+        const auto *transform = entity.get_component<TransformComponent>();
+        auto *mesh_component = entity.get_component<MeshComponent>();
+        const auto *renderable = entity.get_component<RenderableComponent>();
+        auto *instanced = entity.get_component<InstancedRenderableComponent>();
+
+        // Same requirements the renderer has for drawing the entity
+        if (!renderable || !mesh_component) {
+            mesh_component = nullptr;
+            renderable = nullptr;
+        }
+
+        if (!transform || (!mesh_component && !instanced)) {
+            remove_object(entity.get_id());
+            return;
+        }
+
+        RenderObject object{entity.get_id(), transform, mesh_component, renderable, instanced};
+        version_++;
+
+        if (const auto it = object_index_.find(entity.get_id()); it != object_index_.end()) {
+            objects_[it->second] = object;
+        } else {
+            object_index_[entity.get_id()] = static_cast<uint32_t>(objects_.size());
+            objects_.push_back(object);
+        }
+    }
+
+    void RenderObjectRegistry::remove_object(const EntityID entity_id) {
+        const auto it = object_index_.find(entity_id);
+        if (it == object_index_.end()) return;
+
+        // Swap with the last object to keep the array dense
+        const uint32_t index = it->second;
+        version_++;
+        object_index_.erase(it);
+
+        if (index != objects_.size() - 1) {
+            objects_[index] = objects_.back();
+            object_index_[objects_[index].entity_id] = index;
+        }
+        objects_.pop_back();
+    }
+}
@@ -0,0 +1,117 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "hellfire/scene/Scene.h"
+
+class Shader;
+
+namespace hellfire {
+    class InstancedRenderableComponent;
+    class MeshComponent;
+    class RenderableComponent;
+    class TransformComponent;
+    class Material;
+    class Mesh;
+
+    /**
+     * @brief Retained per-entity render data, stored densely.
+     *
+     * Component pointers are refreshed whenever the entity reports a change. The derived
+     * fields (mesh, material, shader, transparency) are owned by the renderer, which
+     * recomputes them when needs_refresh is set or the material version moved.
+     */
+    struct RenderObject {
+        EntityID entity_id;
+        const TransformComponent *transform;
+        MeshComponent *mesh_component; // nullptr: not a single mesh renderable
+        const RenderableComponent *renderable;
+        InstancedRenderableComponent *instanced;
+
+        // Derived state, see Renderer::refresh_render_object()
+        Mesh *mesh = nullptr;
+        Material *material = nullptr;
+        Shader *shader = nullptr;
+        uint32_t material_version = 0;
+        bool is_transparent = false;
+        bool needs_refresh = true;
+
+        // Motion tracking for the static shadow layer, see Renderer::collect_geometry_from_scene()
+        uint32_t world_version = 0;
+        uint64_t last_moved_frame = 0;
+        bool is_static_caster = false;
+        uint32_t shadow_caster = UINT32_MAX; // Index into Renderer::shadow_casters_, UINT32_MAX when not in it
+
+        uint32_t lod = 0; // Level of detail picked by the last main pass, kept to apply hysteresis
+    };
+
+    /// Number of render objects and how many were rebuilt by the last sync
+    struct RenderObjectStats {
+        uint32_t object_count = 0;
+        uint32_t objects_synced = 0;
+    };
+
+    /**
+     * @brief Set of render objects of one scene, kept up to date through SceneObserver notifications.
+     *
+     * Changes only queue the entity. sync() then looks up the queued entities' components once,
+     * so a frame where nothing changed does no per-entity lookups at all.
+     */
+    class RenderObjectRegistry final : public SceneObserver {
+    public:
+        RenderObjectRegistry() = default;
+
+        ~RenderObjectRegistry() override;
+
+        RenderObjectRegistry(const RenderObjectRegistry &) = delete;
+
+        RenderObjectRegistry &operator=(const RenderObjectRegistry &) = delete;
+
+        /// Observe scene, registering all of its entities. Passing the current scene does nothing.
+        void attach(Scene *scene);
+
+        void detach();
+
+        [[nodiscard]] Scene *get_scene() const { return scene_; }
+
+        /// Apply the queued changes
+        void sync();
+
+        [[nodiscard]] std::vector<RenderObject> &get_objects() { return objects_; }
+        /// Bumped whenever an object is added, rebuilt or removed, which also moves others around in get_objects()
+        [[nodiscard]] uint64_t get_version() const { return version_; }
+        [[nodiscard]] const RenderObjectStats &get_stats() const { return stats_; }
+
+        void on_component_added(Entity &entity, Component &component) override;
+
+        void on_component_removed(Entity &entity, Component &component) override;
+
+        void on_component_changed(Entity &entity, Component &component) override;
+
+        void on_entity_destroyed(Entity &entity) override;
+
+        void on_scene_destroyed(Scene &scene) override;
+
+    private:
+        Scene *scene_ = nullptr;
+        std::vector<RenderObject> objects_;
+        std::unordered_map<EntityID, uint32_t> object_index_; // Entity -> index into objects_
+
+        std::vector<EntityID> dirty_entities_;
+        std::unordered_set<EntityID> queued_; // Entities already in dirty_entities_
+        RenderObjectStats stats_;
+        uint64_t version_ = 0;
+
+        void mark_dirty(EntityID entity_id);
+
+        void update_object(Entity &entity);
+
+        void remove_object(EntityID entity_id);
+    };
+}
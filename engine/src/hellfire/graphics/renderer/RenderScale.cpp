@@ -0,0 +1,43 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include "RenderScale.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace hellfire {
+    float RenderScaleController::update(const float gpu_frame_ms, const RenderScaleSettings &settings) {
+        const float min_scale = std::clamp(settings.min_scale, MIN_SCALE, MAX_SCALE);
+        const float max_scale = std::clamp(settings.max_scale, min_scale, MAX_SCALE);
+        scale_ = std::clamp(scale_, min_scale, max_scale);
+        if (gpu_frame_ms <= 0.0f || settings.target_frame_ms <= 0.0f) return scale_;
+
+        accumulated_ms_ += gpu_frame_ms;
+        if (++sample_count_ < ADJUST_INTERVAL) return scale_;
+        const float average_ms = accumulated_ms_ / static_cast<float>(sample_count_);
+        accumulated_ms_ = 0.0f;
+        sample_count_ = 0;
+
+        // Aim for the middle of the band between the headroom and the target
+        const float aim_ms = settings.target_frame_ms * (1.0f - HEADROOM * 0.5f);
+        const float ideal = scale_ * std::sqrt(aim_ms / average_ms);
+        // Small bias so a scale that is already a whole step isn't rounded one step down
+        const float stepped = std::floor(ideal / SCALE_STEP + 1e-3f) * SCALE_STEP;
+
+        float next = scale_;
+        if (average_ms > settings.target_frame_ms) {
+            next = std::min(stepped, scale_ - SCALE_STEP);
+        } else if (average_ms < settings.target_frame_ms * (1.0f - HEADROOM)) {
+            next = std::max(stepped, scale_);
+        }
+        scale_ = std::clamp(next, min_scale, max_scale);
+        return scale_;
+    }
+
+    void RenderScaleController::reset(const float scale) {
+        scale_ = scale;
+        accumulated_ms_ = 0.0f;
+        sample_count_ = 0;
+    }
+}
@@ -0,0 +1,58 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#pragma once
+
+#include <cstdint>
+
+namespace hellfire {
+    enum class UpscaleFilter : uint8_t {
+        BILINEAR,
+        SHARPEN // Bilinear plus contrast adaptive sharpening
+    };
+
+    /**
+     * The scene is rendered at the output size times the render scale and filtered up to the output.
+     * With dynamic scaling on, the scale follows the measured GPU frame time instead of `scale`.
+     */
+    struct RenderScaleSettings {
+        float scale = 1.0f; // Fixed scale while dynamic scaling is off
+        bool dynamic = false;
+        float target_frame_ms = 16.6f;
+        float min_scale = 0.5f;
+        float max_scale = 1.0f;
+        UpscaleFilter filter = UpscaleFilter::SHARPEN;
+        float sharpness = 0.5f; // [0, 1], SHARPEN only
+    };
+
+    /**
+     * @brief Picks the render scale that brings the GPU frame time to the target.
+     *
+     * GPU cost is taken to grow with the pixel count, so the scale moves by the square root of
+     * target over measured time. Frame times are averaged over ADJUST_INTERVAL frames between
+     * changes, GPU timings arrive a few frames late and every change reallocates the render
+     * targets. The scale is only raised once there is HEADROOM to spare, which keeps it from
+     * bouncing around the target, and always lands on a multiple of SCALE_STEP.
+     */
+    class RenderScaleController {
+    public:
+        static constexpr float MIN_SCALE = 0.25f;
+        static constexpr float MAX_SCALE = 1.0f;
+        static constexpr float SCALE_STEP = 0.05f;
+        static constexpr float HEADROOM = 0.15f; // Fraction of the target left unused before scaling up
+        static constexpr uint32_t ADJUST_INTERVAL = 8;
+
+        /// Feed the GPU time of one frame, returns the scale to render at
+        float update(float gpu_frame_ms, const RenderScaleSettings &settings);
+
+        /// Start over from a scale, e.g. when dynamic scaling is switched on
+        void reset(float scale);
+
+        float get_scale() const { return scale_; }
+
+    private:
+        float scale_ = 1.0f;
+        float accumulated_ms_ = 0.0f;
+        uint32_t sample_count_ = 0;
+    };
+}
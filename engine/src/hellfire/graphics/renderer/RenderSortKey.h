@@ -0,0 +1,117 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace hellfire {
+    /**
+     * @brief Builds the 64-bit keys used to order render packets.
+     *
+     * Opaque:      [pass:2][shader:14][material:16][mesh:16][depth:16]  - state first, then front to back
+     * Transparent: [pass:2][depth:16 inverted][shader:14][material:16][mesh:16] - back to front first
+     *
+     * Ids are truncated to their field width, so two different handles can share bits.
+     * That only costs batching; submission compares the real handles before skipping a bind.
+     */
+    class RenderSortKey {
+    public:
+        enum Pass : uint64_t {
+            PASS_OPAQUE = 0,
+            PASS_TRANSPARENT = 1
+        };
+
+        static constexpr int PASS_SHIFT = 62;
+        static constexpr uint64_t SHADER_MASK = 0x3FFF;
+        static constexpr uint64_t FIELD_MASK = 0xFFFF;
+
+        /// Monotonic 16-bit bucket of a non-negative distance (top bits of the IEEE float)
+        static uint16_t quantize_depth(const float distance) {
+            const float clamped = distance > 0.0f ? distance : 0.0f;
+            return static_cast<uint16_t>(std::bit_cast<uint32_t>(clamped) >> 16);
+        }
+
+        static uint64_t make_opaque(const uint32_t shader_id, const uint32_t material_id, const uint32_t mesh_id,
+                                    const float distance) {
+            return (static_cast<uint64_t>(PASS_OPAQUE) << PASS_SHIFT) |
+                   ((shader_id & SHADER_MASK) << 48) |
+                   ((material_id & FIELD_MASK) << 32) |
+                   ((mesh_id & FIELD_MASK) << 16) |
+                   quantize_depth(distance);
+        }
+
+        static uint64_t make_transparent(const uint32_t shader_id, const uint32_t material_id, const uint32_t mesh_id,
+                                         const float distance) {
+            const uint64_t inverted_depth = FIELD_MASK - quantize_depth(distance);
+            return (static_cast<uint64_t>(PASS_TRANSPARENT) << PASS_SHIFT) |
+                   (inverted_depth << 46) |
+                   ((shader_id & SHADER_MASK) << 32) |
+                   ((material_id & FIELD_MASK) << 16) |
+                   (mesh_id & FIELD_MASK);
+        }
+
+        static Pass get_pass(const uint64_t key) {
+            return static_cast<Pass>(key >> PASS_SHIFT);
+        }
+    };
+
+    /// Key/index pair sorted in place of the (much larger) render packets
+    struct RenderSortEntry {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    /**
+     * @brief Stable LSD radix sort on 8-bit digits.
+     * Digits that are identical for every entry (typically the pass and upper id bits) are skipped.
+     * @param entries Entries to sort, sorted in place
+     * @param scratch Reused temporary storage, resized as needed
+     */
+    inline void radix_sort(std::vector<RenderSortEntry> &entries, std::vector<RenderSortEntry> &scratch) {
+        const size_t count = entries.size();
+        if (count < 2) return;
+
+        scratch.resize(count);
+
+        // One histogram per digit, built in a single pass over the keys
+        std::array<std::array<uint32_t, 256>, 8> histograms{};
+        for (const auto &entry: entries) {
+            for (int digit = 0; digit < 8; digit++) {
+                histograms[digit][(entry.key >> (digit * 8)) & 0xFF]++;
+            }
+        }
+
+        RenderSortEntry *source = entries.data();
+        RenderSortEntry *destination = scratch.data();
+
+        for (int digit = 0; digit < 8; digit++) {
+            auto &histogram = histograms[digit];
+
+            // Every key shares this digit, the pass would be a plain copy
+            if (histogram[(source[0].key >> (digit * 8)) & 0xFF] == count) continue;
+
+            uint32_t offset = 0;
+            for (auto &bucket: histogram) {
+                const uint32_t bucket_count = bucket;
+                bucket = offset;
+                offset += bucket_count;
+            }
+
+            for (size_t i = 0; i < count; i++) {
+                const auto bucket = (source[i].key >> (digit * 8)) & 0xFF;
+                destination[histogram[bucket]++] = source[i];
+            }
+
+            std::swap(source, destination);
+        }
+
+        if (source != entries.data()) {
+            entries.swap(scratch);
+        }
+    }
+}
@@ -0,0 +1,18 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include "RenderStats.h"
+
+namespace hellfire {
+    void RenderStats::write_csv_header(std::ostream &out) {
+        out << "frame";
+        RenderStats{}.visit([&](const char *name, auto) { out << ',' << name; });
+        out << '\n';
+    }
+
+    void RenderStats::write_csv_row(std::ostream &out, const uint64_t frame) const {
+        out << frame;
+        visit([&](const char *, const auto value) { out << ',' << value; });
+        out << '\n';
+    }
+}
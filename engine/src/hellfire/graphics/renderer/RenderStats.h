@@ -0,0 +1,55 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+
+namespace hellfire {
+    /**
+     * @brief What one Renderer::render_frame() submitted to the GPU, every pass included.
+     *
+     * Binds and uniform uploads only count calls that reached GL, the ones the state cache and
+     * uniform tables dropped are left out. Rows written with write_csv_row() under the header of
+     * write_csv_header() give a per-frame log two builds can be diffed against.
+     */
+    struct RenderStats {
+        uint32_t draw_calls = 0;
+        uint32_t instanced_draw_calls = 0; // Instanced and multi-draw indirect calls, part of draw_calls
+        uint64_t triangles = 0;
+        uint64_t instances = 0; // Objects and instances drawn, a plain draw counts as one
+        uint32_t program_binds = 0;
+        uint32_t vertex_array_binds = 0;
+        uint32_t texture_binds = 0;
+        uint32_t material_binds = 0;
+        uint32_t uniform_uploads = 0;
+        uint32_t shadow_draw_calls = 0; // Part of draw_calls
+        uint32_t objects_culled = 0; // By the camera frustum and occlusion culling
+        uint32_t shadow_casters_culled = 0; // Summed over all light frustums
+        uint64_t buffer_bytes_uploaded = 0;
+
+        /// Calls visitor(name, value) for every field, in CSV column order
+        template<typename Visitor>
+        void visit(Visitor &&visitor) const {
+            visitor("draw_calls", draw_calls);
+            visitor("instanced_draw_calls", instanced_draw_calls);
+            visitor("triangles", triangles);
+            visitor("instances", instances);
+            visitor("program_binds", program_binds);
+            visitor("vertex_array_binds", vertex_array_binds);
+            visitor("texture_binds", texture_binds);
+            visitor("material_binds", material_binds);
+            visitor("uniform_uploads", uniform_uploads);
+            visitor("shadow_draw_calls", shadow_draw_calls);
+            visitor("objects_culled", objects_culled);
+            visitor("shadow_casters_culled", shadow_casters_culled);
+            visitor("buffer_bytes_uploaded", buffer_bytes_uploaded);
+        }
+
+        /// Column names, starting with "frame"
+        static void write_csv_header(std::ostream &out);
+
+        void write_csv_row(std::ostream &out, uint64_t frame) const;
+    };
+}
@@ -4,25 +4,90 @@
 #include "Renderer.h"
 #include "GL/glew.h"
 #include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <ranges>
 
 
 #include "hellfire/core/Application.h"
+#include "hellfire/core/Profiler.h"
 #include "hellfire/core/Time.h"
 #include "hellfire/ecs/CameraComponent.h"
 #include "hellfire/ecs/InstancedRenderableComponent.h"
 #include "hellfire/ecs/LightComponent.h"
 #include "hellfire/ecs/components/MeshComponent.h"
+#include "hellfire/graphics/backends/opengl/GLStateCache.h"
+#include "hellfire/graphics/backends/opengl/VertexFormat.h"
 #include "hellfire/graphics/renderer/SkyboxRenderer.h"
 #include "hellfire/scene/Scene.h"
+#include "hellfire/utilities/ServiceLocator.h"
 
 namespace hellfire {
+    namespace {
+        /// Uniforms set on every draw, interned once so the hot path never builds strings.
+        struct DrawUniformIds {
+            UniformID object_id = UniformTable::intern("uObjectID");
+            UniformID light_view_proj = UniformTable::intern("uLightViewProjMatrix");
+            UniformID shadow_model = UniformTable::intern("uModelMatrix");
+            UniformID upscale_sharpness = UniformTable::intern("uSharpness");
+        };
+
+        const DrawUniformIds &draw_uniform_ids() {
+            static const DrawUniformIds ids;
+            return ids;
+        }
+
+        /// Size of the scene along one axis at a render scale, never 0
+        uint32_t scale_render_size(const uint32_t output_size, const float scale) {
+            return std::max(1u, static_cast<uint32_t>(std::lround(static_cast<float>(output_size) * scale)));
+        }
+
+        // Smallest cascade tile a light is shrunk to before it loses its shadows
+        constexpr uint32_t MIN_SHADOW_TILE_SIZE = 256;
+
+        /// Directional lights cover the whole screen alike, so the brighter one gets the sharper shadows
+        float get_shadow_importance(const LightComponent &light) {
+            const glm::vec3 &color = light.get_color();
+            return light.get_intensity() * std::max(color.r, std::max(color.g, color.b));
+        }
+
+        std::unique_ptr<Framebuffer> create_shadow_framebuffer(const glm::uvec2 &size) {
+            auto shadow_map = std::make_unique<Framebuffer>();
+            FrameBufferAttachmentSettings settings;
+            settings.width = size.x;
+            settings.height = size.y;
+
+            settings.min_filter = GL_NEAREST;
+            settings.mag_filter = GL_NEAREST;
+            settings.wrap_s = GL_CLAMP_TO_BORDER;
+            settings.wrap_t = GL_CLAMP_TO_BORDER;
+            shadow_map->attach_depth_texture(settings);
+
+            GLStateCache::bind_texture(GL_TEXTURE_2D, shadow_map->get_depth_attachment());
+            const float border_color[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+            glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, border_color);
+            return shadow_map;
+        }
+    }
+
     Renderer::Renderer()
-        : shader_registry_(nullptr), fallback_shader_(nullptr), fallback_program_(0), render_to_framebuffer_(false),
+        // Uniform tables are per GL program, so share the application-wide manager when there is one
+        : shader_registry_(ServiceLocator::get_service<ShaderManager>()
+                               ? ServiceLocator::get_service<ShaderManager>()
+                               : &shader_manager_), fallback_shader_(nullptr), fallback_program_(0), render_to_framebuffer_(false),
           framebuffer_width_(800), framebuffer_height_(600) {
         context_ = std::make_unique<OGLRendererContext>();
         context_->shader_handle = 0;
     }
 
+    Renderer::~Renderer() {
+        if (fullscreen_vao_ != 0) {
+            glDeleteVertexArrays(1, &fullscreen_vao_);
+        }
+    }
+
     void Renderer::init() {
         // Enable debugging for OpenGL
         glEnable(GL_DEBUG_OUTPUT);
@@ -42,6 +107,25 @@ namespace hellfire {
                                                           "assets/shaders/shadow.frag");
 
         skybox_renderer_.initialize();
+
+        if (const uint32_t composite_id = get_shader_manager().load_shader_from_files(
+            "assets/shaders/oit_composite.vert", "assets/shaders/oit_composite.frag")) {
+            oit_composite_shader_ = shader_registry_.get_shader_from_id(composite_id);
+        }
+        if (const uint32_t upscale_id = get_shader_manager().load_shader_from_files(
+            "assets/shaders/upscale.vert", "assets/shaders/upscale.frag")) {
+            upscale_shader_ = shader_registry_.get_shader_from_id(upscale_id);
+        }
+        glGenVertexArrays(1, &fullscreen_vao_);
+
+        // Per-frame camera and light blocks, bound at fixed binding points shared by all shaders
+        frame_data_buffer_ = std::make_unique<ShaderBuffer>(GL_UNIFORM_BUFFER, FRAME_DATA_BINDING, sizeof(FrameData));
+        light_data_buffer_ = std::make_unique<ShaderBuffer>(GL_UNIFORM_BUFFER, LIGHT_DATA_BINDING, sizeof(LightData));
+        instance_buffer_ = std::make_unique<ShaderBuffer>(GL_SHADER_STORAGE_BUFFER, INSTANCE_DATA_BINDING);
+        point_light_buffer_ = std::make_unique<ShaderBuffer>(GL_SHADER_STORAGE_BUFFER, POINT_LIGHT_BINDING);
+        light_cluster_buffer_ = std::make_unique<ShaderBuffer>(GL_SHADER_STORAGE_BUFFER, LIGHT_CLUSTER_BINDING);
+        light_index_buffer_ = std::make_unique<ShaderBuffer>(GL_SHADER_STORAGE_BUFFER, LIGHT_INDEX_BINDING);
+        indirect_buffer_ = std::make_unique<ShaderBuffer>(GL_DRAW_INDIRECT_BUFFER, 0);
     }
 
     void Renderer::render(Scene &scene, const Entity *camera_override = nullptr) {
@@ -78,11 +162,12 @@ namespace hellfire {
     }
 
     void Renderer::begin_frame() {
+        gpu_timer_.begin_frame();
         reset_framebuffer_data();
 
-        glEnable(GL_DEPTH_TEST);
-        glDepthMask(GL_TRUE);
-        glDepthFunc(GL_LESS);
+        GLStateCache::enable(GL_DEPTH_TEST);
+        GLStateCache::depth_mask(true);
+        GLStateCache::depth_func(GL_LESS);
 
         clear_draw_list();
     }
@@ -105,14 +190,12 @@ namespace hellfire {
             // Sort lights into their respective vectors
             switch (light->get_light_type()) {
                 case LightComponent::LightType::DIRECTIONAL:
-                    if (directional_lights.size() < 4) {
+                    if (directional_lights.size() < MAX_DIRECTIONAL_LIGHTS) {
                         directional_lights.push_back(entity);
                     }
                     break;
                 case LightComponent::LightType::POINT:
-                    if (point_lights.size() < 8) {
-                        point_lights.push_back(entity);
-                    }
+                    point_lights.push_back(entity);
                     break;
                 case LightComponent::LightType::SPOT:
                     // TODO: Handle spot lights
@@ -129,154 +212,622 @@ namespace hellfire {
             context_->directional_light_entities[i] = directional_lights[i];
         }
 
-        for (int i = 0; i < context_->num_point_lights; i++) {
-            context_->point_light_entities[i] = point_lights[i];
-        }
+        context_->point_light_entities = std::move(point_lights);
 
         // Store camera component
         context_->camera_component = &camera;
     }
 
-    void Renderer::collect_geometry_from_scene(Scene &scene, const glm::vec3 camera_pos) {
-        for (const EntityID root_id: scene.get_root_entities()) {
-            collect_render_commands_recursive(root_id, camera_pos);
-        }
-    }
+    void Renderer::collect_geometry_from_scene(Scene &scene, const CameraComponent &camera) {
+        HF_PROFILE_SCOPE("Renderer::collect_geometry_from_scene");
+        clear_draw_list();
+        scene_ = &scene;
+        culling_stats_.objects_tested = 0;
+        culling_stats_.objects_culled = 0;
 
-    void Renderer::collect_render_commands_recursive(EntityID entity_id, const glm::vec3 &camera_pos) {
-        const Entity *entity = scene_->get_entity(entity_id);
-        if (!entity) return;
+        render_objects_.attach(&scene);
+        render_objects_.sync();
+        bool shadow_casters_stale = render_objects_.get_version() != shadow_casters_version_;
 
-        // Check for renderable + mesh components
-        const auto *renderable = entity->get_component<RenderableComponent>();
-        const auto *mesh_comp = entity->get_component<MeshComponent>();
-        const auto *transform = entity->get_component<TransformComponent>();
+        const glm::mat4 projection = camera.get_projection_matrix();
+        const Frustum camera_frustum(projection * camera.get_view_matrix());
+        const Frustum *frustum = frustum_culling_enabled_ ? &camera_frustum : nullptr;
+        const glm::vec3 camera_pos = glm::vec3(camera.get_owner().transform()->get_world_matrix()[3]);
+        // Pixels one world unit covers at distance 1 along the view axis
+        const float lod_pixel_scale = projection[1][1] * static_cast<float>(framebuffer_height_) * 0.5f;
+
+        // Added, removed or rebuilt objects may have been shadow casters
+        if (render_objects_.get_stats().objects_synced > 0) {
+            static_caster_version_++;
+            dynamic_caster_version_++;
+        }
+
+        for (RenderObject &object: render_objects_.get_objects()) {
+            if (object.mesh_component && refresh_render_object(object)) {
+                shadow_casters_stale = true;
+            }
 
-        // Need all three to render
-        if (renderable && mesh_comp && transform) {
-            const auto mesh = mesh_comp->get_mesh();
-            const auto material = renderable->get_material();
+            Mesh *mesh = object.mesh;
+            Material *material = object.material;
 
             if (mesh && material) {
-                const glm::vec3 object_pos = transform->get_world_position();
-                const float distance = glm::length(camera_pos - object_pos);
-                const bool is_transparent = material->is_transparent();
+                // Casters that stayed put long enough go into the cached static shadow layer
+                if (const uint32_t world_version = object.transform->get_world_version();
+                    world_version != object.world_version) {
+                    object.world_version = world_version;
+                    object.last_moved_frame = frame_index_;
+                    if (object.renderable->get_cast_shadows()) dynamic_caster_version_++;
+                }
+                const bool is_static_caster = object.renderable->get_cast_shadows() &&
+                                              frame_index_ - object.last_moved_frame >=
+                                              shadow_settings_.static_caster_frames;
+                if (is_static_caster != object.is_static_caster) {
+                    object.is_static_caster = is_static_caster;
+                    static_caster_version_++;
+                    dynamic_caster_version_++;
+                }
 
-                const RenderCommand cmd = {entity_id, mesh, material, distance, is_transparent};
+                const bool casts_shadows = object.renderable->get_cast_shadows() && !object.is_transparent;
+                if (casts_shadows != (object.shadow_caster != UINT32_MAX)) shadow_casters_stale = true;
 
-                if (is_transparent) {
-                    transparent_objects_.push_back(cmd);
-                } else {
-                    opaque_objects_.push_back(cmd);
+                const AABB *world_bounds = &object.mesh_component->get_world_bounds(*object.transform);
+                bool visible = true;
+                if (frustum) {
+                    culling_stats_.objects_tested++;
+                    visible = frustum->intersects(*world_bounds);
+                    if (!visible) culling_stats_.objects_culled++;
                 }
-            }
-        }
 
-        // If the entity has an Instancing component setup the render commands
-        if (auto *instanced = entity->get_component<InstancedRenderableComponent>()) {
-            if (transform && instanced->has_mesh() && instanced->get_instance_count() > 0) {
-                if (const auto material = instanced->get_material()) {
-                    const glm::vec3 object_pos = transform->get_world_position();
+                if (visible) {
+                    const glm::mat4 &world_matrix = object.transform->get_world_matrix();
+                    const glm::vec3 object_pos = glm::vec3(world_matrix[3]);
                     const float distance = glm::length(camera_pos - object_pos);
-                    const bool is_transparent = material->is_transparent();
 
-                    const InstancedRenderCommand cmd = {entity_id, instanced, material, distance, is_transparent};
+                    // Error is in local units, so scale it like the mesh; measure from the nearest bounds point
+                    const float scale = std::max({
+                        glm::length(glm::vec3(world_matrix[0])), glm::length(glm::vec3(world_matrix[1])),
+                        glm::length(glm::vec3(world_matrix[2]))
+                    });
+                    const float surface_distance = std::max(
+                        glm::length(world_bounds->get_center() - camera_pos) - glm::length(world_bounds->get_extents()),
+                        0.01f);
+                    const uint32_t lod = lod_settings_.enabled
+                                             ? select_mesh_lod(mesh->lods, lod_pixel_scale * scale / surface_distance,
+                                                               object.lod, lod_settings_.error_pixels,
+                                                               lod_settings_.hysteresis)
+                                             : 0;
+                    // Casters are drawn into the shadow maps at the camera's LOD
+                    if (lod != object.lod && casts_shadows && !object.is_static_caster) {
+                        dynamic_caster_version_++;
+                    }
+                    object.lod = lod;
+                    const bool is_transparent = object.is_transparent;
+                    Shader *shader = object.shader;
+
+                    RenderCommand cmd = {
+                        0, object.entity_id, mesh, material, shader, object.transform, world_bounds, distance,
+                        is_transparent, object.renderable->get_cast_shadows(), object.is_static_caster,
+                        object.renderable->occluder_mode, std::min(object.lod, mesh->get_lod_count() - 1)
+                    };
+                    cmd.sort_key = is_transparent
+                                       ? RenderSortKey::make_transparent(shader->get_program_id(),
+                                                                         material->get_render_id(),
+                                                                         mesh->get_render_id(), distance)
+                                       : RenderSortKey::make_opaque(shader->get_program_id(), material->get_render_id(),
+                                                                    mesh->get_render_id(), distance);
 
                     if (is_transparent) {
-                        transparent_instanced_objects_.push_back(cmd);
+                        transparent_objects_.push_back(cmd);
                     } else {
-                        opaque_instanced_objects_.push_back(cmd);
+                        opaque_objects_.push_back(cmd);
+                    }
+                }
+
+                // Casters keep the LOD of the camera's last pick, out of view ones included
+                if (!shadow_casters_stale && object.shadow_caster != UINT32_MAX) {
+                    RenderCommand &caster = shadow_casters_[object.shadow_caster];
+                    caster.is_static_caster = object.is_static_caster;
+                    caster.lod = std::min(object.lod, mesh->get_lod_count() - 1);
+                }
+            }
+
+            // Instance buffers change every frame anyway, read them live
+            if (auto *instanced = object.instanced) {
+                if (instanced->has_mesh() && instanced->get_instance_count() > 0) {
+                    if (Material *instanced_material = instanced->get_material().get()) {
+                        instanced->select_lods(camera_pos, lod_settings_.enabled ? lod_pixel_scale : 0.0f,
+                                               lod_settings_.error_pixels, lod_settings_.hysteresis);
+                        const glm::vec3 object_pos = glm::vec3(object.transform->get_world_matrix()[3]);
+                        const float distance = glm::length(camera_pos - object_pos);
+                        const bool is_transparent = instanced_material->is_transparent();
+
+                        const InstancedRenderCommand cmd = {
+                            object.entity_id, instanced, instanced_material, distance, is_transparent
+                        };
+
+                        if (is_transparent) {
+                            transparent_instanced_objects_.push_back(cmd);
+                        } else {
+                            opaque_instanced_objects_.push_back(cmd);
+                        }
                     }
                 }
             }
         }
 
-        // Recurse through children using scene hierarchy
-        for (const EntityID child_id: scene_->get_children(entity_id)) {
-            collect_render_commands_recursive(child_id, camera_pos);
+        if (shadow_casters_stale) rebuild_shadow_casters();
+    }
+
+    void Renderer::rebuild_shadow_casters() {
+        HF_PROFILE_SCOPE("Renderer::rebuild_shadow_casters");
+        std::vector<RenderObject> &objects = render_objects_.get_objects();
+
+        // Sorted once here, so the shadow passes draw casters sharing a mesh back to back without sorting.
+        // Distance doesn't matter for shadows, the key only groups casters by shader, material and mesh
+        std::vector<std::pair<uint64_t, uint32_t>> casters; // Sort key, object index
+        for (uint32_t i = 0; i < objects.size(); i++) {
+            RenderObject &object = objects[i];
+            object.shadow_caster = UINT32_MAX;
+            if (!object.mesh || !object.material || object.is_transparent ||
+                !object.renderable->get_cast_shadows()) {
+                continue;
+            }
+            casters.emplace_back(RenderSortKey::make_opaque(object.shader->get_program_id(),
+                                                            object.material->get_render_id(),
+                                                            object.mesh->get_render_id(), 0.0f), i);
+        }
+        std::ranges::sort(casters);
+
+        shadow_casters_.clear();
+        for (const auto &[sort_key, index]: casters) {
+            RenderObject &object = objects[index];
+            object.shadow_caster = static_cast<uint32_t>(shadow_casters_.size());
+            shadow_casters_.push_back({
+                sort_key, object.entity_id, object.mesh, object.material, object.shader, object.transform,
+                &object.mesh_component->get_world_bounds(*object.transform), 0.0f, false, true,
+                object.is_static_caster, object.renderable->occluder_mode,
+                std::min(object.lod, object.mesh->get_lod_count() - 1)
+            });
         }
+        shadow_casters_version_ = render_objects_.get_version();
     }
 
-    void Renderer::ensure_shadow_map(Entity *light_entity, const LightComponent &light) {
-        if (!shadow_maps_.contains(light_entity)) {
-            auto shadow_map = std::make_unique<Framebuffer>();
-            FrameBufferAttachmentSettings settings;
-            settings.width = 4096;
-            settings.height = 4096;
+    bool Renderer::refresh_render_object(RenderObject &object) {
+        Mesh *mesh = object.mesh_component->get_mesh().get();
+        Material *material = object.renderable->get_material().get();
 
-            settings.min_filter = GL_NEAREST;
-            settings.mag_filter = GL_NEAREST;
-            settings.wrap_s = GL_CLAMP_TO_BORDER;
-            settings.wrap_t = GL_CLAMP_TO_BORDER;
-            shadow_map->attach_depth_texture(settings);
+        // Public fields and shared assets can change without a notification, so compare the cheap bits too
+        if (!object.needs_refresh && mesh == object.mesh && material == object.material &&
+            (!material || material->get_version() == object.material_version)) {
+            return false;
+        }
 
-            glBindTexture(GL_TEXTURE_2D, shadow_map->get_depth_attachment());
-            const float border_color[] = { 1.0f, 1.0f, 1.0f, 1.0f };
-            glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, border_color);
-            glBindTexture(GL_TEXTURE_2D, 0);
-            shadow_maps_[light_entity] = {std::move(shadow_map), glm::mat4(1.0f)};
+        object.mesh = mesh;
+        object.material = material;
+        object.shader = material ? &get_shader_for_material(material) : nullptr;
+        // Read the version after resolving the shader, compiling it bumps the version once
+        object.material_version = material ? material->get_version() : 0;
+        object.is_transparent = material && material->is_transparent();
+        object.needs_refresh = false;
+        return true;
+    }
+
+    void Renderer::ensure_shadow_atlas() {
+        const uint32_t atlas_size = std::bit_ceil(std::max(shadow_settings_.atlas_size, MIN_SHADOW_TILE_SIZE));
+        if (shadow_atlas_ && shadow_atlas_allocator_.get_atlas_size() == atlas_size) return;
+
+        // Every tile is gone with the old atlas
+        shadow_atlas_ = create_shadow_framebuffer(glm::uvec2(atlas_size));
+        shadow_composite_atlas_.reset();
+        shadow_atlas_allocator_.reset(atlas_size);
+        shadow_maps_.clear();
+        sample_shadow_composite_ = false;
+    }
+
+    void Renderer::assign_shadow_tiles(const std::vector<EntityID> &lights_by_importance, const int cascade_count) {
+        // Reclaim the tiles of lights that were removed or stopped casting shadows
+        for (auto it = shadow_maps_.begin(); it != shadow_maps_.end();) {
+            if (!it->second.is_active) {
+                free_shadow_tiles(it->second);
+                it = shadow_maps_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        const uint32_t preferred_size = std::clamp(std::bit_ceil(shadow_settings_.cascade_resolution),
+                                                   MIN_SHADOW_TILE_SIZE, shadow_atlas_allocator_.get_atlas_size());
+
+        for (size_t i = 0; i < lights_by_importance.size(); i++) {
+            ShadowMapData &shadow_data = shadow_maps_[lights_by_importance[i]];
+
+            const bool has_tiles = shadow_data.cascade_count == cascade_count;
+            const uint32_t tile_size = has_tiles ? shadow_data.tiles[0].size : 0;
+            // A light that got less than it wanted retries once other lights gave tiles back
+            const bool may_upgrade = tile_size < preferred_size &&
+                                     shadow_data.allocation_epoch != shadow_atlas_free_epoch_;
+            if (has_tiles && tile_size <= preferred_size && !may_upgrade) continue;
+
+            free_shadow_tiles(shadow_data);
+            if (!allocate_shadow_tiles(shadow_data, cascade_count, preferred_size) && !has_tiles) {
+                // Take the tiles of the less important lights, they get what is left further down
+                for (size_t j = i + 1; j < lights_by_importance.size(); j++) {
+                    if (const auto it = shadow_maps_.find(lights_by_importance[j]); it != shadow_maps_.end()) {
+                        free_shadow_tiles(it->second);
+                    }
+                }
+                allocate_shadow_tiles(shadow_data, cascade_count, preferred_size);
+            }
+        }
+
+        // Frees made while assigning are already accounted for
+        for (const EntityID light_id: lights_by_importance) {
+            shadow_maps_[light_id].allocation_epoch = shadow_atlas_free_epoch_;
         }
     }
 
-    void Renderer::draw_render_command(const RenderCommand &cmd, const glm::mat4 &view, const glm::mat4 &projection) {
-        const Entity *entity = scene_->get_entity(cmd.entity_id);
-        if (!entity) return;
+    bool Renderer::allocate_shadow_tiles(ShadowMapData &shadow_data, const int cascade_count,
+                                         const uint32_t preferred_size) {
+        for (uint32_t size = preferred_size; size >= MIN_SHADOW_TILE_SIZE; size /= 2) {
+            int allocated = 0;
+            for (; allocated < cascade_count; allocated++) {
+                shadow_data.tiles[allocated] = shadow_atlas_allocator_.allocate(size);
+                if (!shadow_data.tiles[allocated].is_valid()) break;
+            }
 
-        const auto *transform = entity->get_component<TransformComponent>();
-        if (!transform) return;
+            if (allocated == cascade_count) {
+                shadow_data.cascade_count = cascade_count;
+                shadow_data.static_layer_valid = false;
+                return true;
+            }
 
-        Shader &shader = get_shader_for_material(cmd.material);
-        shader.use();
+            // Not all cascades fit at this size, give the partial set back (without counting it as a free)
+            for (int c = 0; c < allocated; c++) {
+                shadow_atlas_allocator_.free(shadow_data.tiles[c]);
+                shadow_data.tiles[c] = {};
+            }
+        }
+        return false;
+    }
 
-        // Upload lights
-        if (context_) {
-            RenderingUtils::upload_lights_to_shader(shader, *context_);
+    void Renderer::free_shadow_tiles(ShadowMapData &shadow_data) {
+        if (shadow_data.cascade_count == 0) return;
+
+        for (int c = 0; c < shadow_data.cascade_count; c++) {
+            shadow_atlas_allocator_.free(shadow_data.tiles[c]);
+            shadow_data.tiles[c] = {};
+        }
+        shadow_data.cascade_count = 0;
+        shadow_data.static_layer_valid = false;
+        shadow_data.dynamic_layer_valid = false;
+        shadow_atlas_free_epoch_++;
+    }
+
+    void Renderer::sort_render_commands(const std::vector<RenderCommand> &commands) {
+        sort_entries_.resize(commands.size());
+        for (size_t i = 0; i < commands.size(); i++) {
+            sort_entries_[i] = {commands[i].sort_key, static_cast<uint32_t>(i)};
+        }
+        radix_sort(sort_entries_, sort_scratch_);
+    }
+
+    Shader *Renderer::get_instanced_shader(const RenderCommand &cmd) {
+        const uint32_t program_id = cmd.shader->get_program_id();
+
+        // Materials drawn with the fallback shader have no variant of their own
+        if (program_id != cmd.material->get_compiled_shader_id()) return nullptr;
+
+        auto [it, inserted] = instanced_shaders_.try_emplace(program_id, nullptr);
+        if (inserted) {
+            if (const uint32_t instanced_id = get_shader_manager().get_instanced_shader_for_material(*cmd.material)) {
+                it->second = shader_registry_.get_shader_from_id(instanced_id);
+            }
+        }
+        return it->second;
+    }
 
-            // Bind shadow maps for directional lights
-            for (int i = 0; i < context_->num_directional_lights; i++) {
-                Entity* light_entity = context_->directional_light_entities[i];
+    Shader *Renderer::get_pass_shader(const PassShader pass, const Material &material, const Shader &shader,
+                                      const bool instanced) {
+        const uint32_t program_id = shader.get_program_id();
+
+        // Like the instanced variant, materials drawn with the fallback shader have none
+        if (!instanced && program_id != material.get_compiled_shader_id()) return nullptr;
+
+        auto &variants = pass == PassShader::DEPTH_ONLY
+                             ? depth_only_shaders_
+                             : pass == PassShader::OVERDRAW
+                                   ? overdraw_shaders_
+                                   : oit_shaders_;
+        auto [it, inserted] = variants.try_emplace(program_id, nullptr);
+        if (inserted) {
+            ShaderManager &manager = get_shader_manager();
+            uint32_t variant_id = 0;
+            switch (pass) {
+                case PassShader::DEPTH_ONLY:
+                    variant_id = manager.get_depth_only_shader_for_material(material, instanced);
+                    break;
+                case PassShader::OVERDRAW:
+                    variant_id = manager.get_overdraw_shader_for_material(material, instanced);
+                    break;
+                case PassShader::OIT:
+                    // Instanced renderables draw with the material's own program, so its variant serves both
+                    variant_id = manager.get_oit_shader_for_material(material);
+                    break;
+            }
+            if (variant_id) {
+                it->second = shader_registry_.get_shader_from_id(variant_id);
+            }
+        }
+        return it->second;
+    }
 
-                if (shadow_maps_.contains(light_entity)) {
-                    auto& shadow_data = shadow_maps_[light_entity];
+    Shader *Renderer::get_color_pass_shader(const Material &material, Shader *shader, const bool instanced) {
+        if (!overdraw_view_enabled_) return shader;
 
-                    // Bind depth texture to texture unit
-                    const int texture_unit = 10 + i; // Start at unit 10 to avoid conflicts
-                    glActiveTexture(GL_TEXTURE0 + texture_unit);
-                    glBindTexture(GL_TEXTURE_2D, shadow_data.framebuffer->get_depth_attachment());
+        Shader *overdraw_shader = get_pass_shader(PassShader::OVERDRAW, material, *shader, instanced);
+        return overdraw_shader ? overdraw_shader : shader;
+    }
 
-                    // Set shader uniforms
-                    shader.set_int("uShadowMap[" + std::to_string(i) + "]", texture_unit);
-                    shader.set_mat4("uLightSpaceMatrix[" + std::to_string(i) + "]", shadow_data.light_view_proj);
-                    shader.set_float("uShadowBias", shadow_settings_.bias);
+    void Renderer::build_draw_batches(const std::vector<RenderCommand> &commands) {
+        draw_batches_.clear();
+        instance_data_.clear();
+        indirect_commands_.clear();
+
+        // Multi-draw needs every mesh of a run in the same arena VAO
+        GeometryArena *arena = ServiceLocator::get_service<GeometryArena>();
+
+        const auto entry_count = static_cast<uint32_t>(sort_entries_.size());
+        uint32_t run_start = 0;
+        while (run_start < entry_count) {
+            const RenderCommand &first = commands[sort_entries_[run_start].index];
+
+            bool all_in_arena = first.mesh->is_in_geometry_arena();
+            uint32_t run_end = run_start + 1;
+            while (run_end < entry_count) {
+                const RenderCommand &cmd = commands[sort_entries_[run_end].index];
+                if (cmd.material != first.material || cmd.shader != first.shader) break;
+                // Arena meshes of another vertex layout or index type live in a different VAO
+                if (first.mesh->is_in_geometry_arena() && cmd.mesh->is_in_geometry_arena() &&
+                    cmd.mesh->get_vertex_array_id() != first.mesh->get_vertex_array_id()) {
+                    break;
                 }
+                all_in_arena = all_in_arena && cmd.mesh->is_in_geometry_arena();
+                run_end++;
             }
+
+            const uint32_t run_length = run_end - run_start;
+            Shader *batched_shader = nullptr;
+            if (draw_batching_settings_.enabled && arena && all_in_arena &&
+                run_length >= draw_batching_settings_.min_batch_size) {
+                batched_shader = get_instanced_shader(first);
+            }
+
+            DrawBatch batch = {run_start, run_length, batched_shader,
+                               static_cast<uint32_t>(indirect_commands_.size()), 0, false};
+
+            if (batched_shader) {
+                // Sorted by mesh within the run, so consecutive draws of a mesh and LOD become instances of one command
+                const Mesh *previous_mesh = nullptr;
+                uint32_t previous_lod = 0;
+                for (uint32_t i = run_start; i < run_end; i++) {
+                    const RenderCommand &cmd = commands[sort_entries_[i].index];
+                    const auto record_index = static_cast<uint32_t>(instance_data_.size());
+                    instance_data_.push_back({
+                        cmd.transform->get_world_matrix() * cmd.mesh->get_position_decode(), cmd.entity_id, {}
+                    });
+
+                    if (cmd.mesh == previous_mesh && cmd.lod == previous_lod) {
+                        indirect_commands_.back().instance_count++;
+                        continue;
+                    }
+
+                    // The allocation holds every LOD's indices, draw only the range of this one
+                    const GeometryAllocation &geometry = cmd.mesh->get_geometry_allocation();
+                    indirect_commands_.push_back({
+                        cmd.mesh->get_lod_index_count(cmd.lod), 1,
+                        geometry.first_index + cmd.mesh->get_lod_first_index(cmd.lod),
+                        static_cast<int32_t>(geometry.base_vertex), record_index
+                    });
+                    batch.indirect_command_count++;
+                    previous_mesh = cmd.mesh;
+                    previous_lod = cmd.lod;
+                }
+            }
+
+            draw_batches_.push_back(batch);
+            run_start = run_end;
         }
 
-        shader.set_vec3("uAmbientLight", scene_->environment()->get_ambient_light());
+        // One upload of records and commands for every batch in the pass
+        if (!instance_data_.empty() && instance_buffer_ && indirect_buffer_) {
+            arena->ensure_instance_capacity(static_cast<uint32_t>(instance_data_.size()));
+            instance_buffer_->stream(instance_data_);
+            indirect_buffer_->stream(indirect_commands_);
+        }
+    }
 
-        shader.set_uint("uObjectID", cmd.entity_id);
+    void Renderer::submit_sorted_commands(const std::vector<RenderCommand> &commands, const glm::mat4 &view,
+                                          const glm::mat4 &projection) {
+        const auto &uniforms = draw_uniform_ids();
+        const Shader *bound_shader = nullptr;
+        const Material *bound_material = nullptr;
+        uint32_t bound_vertex_array = 0;
+
+        // Commands are sorted by key, so only rebind when the shader/material/vertex array actually changes
+        for (const auto &batch: draw_batches_) {
+            const RenderCommand &first = commands[sort_entries_[batch.first_entry].index];
+            Shader *shader = get_color_pass_shader(*first.material,
+                                                   batch.batched_shader ? batch.batched_shader : first.shader,
+                                                   batch.batched_shader != nullptr);
+
+            // Batches the pre-pass skipped still have to resolve visibility themselves
+            GLStateCache::depth_func(batch.depth_prepassed ? GL_EQUAL : GL_LESS);
+            GLStateCache::depth_mask(!batch.depth_prepassed);
+
+            bool rebind_material = first.material != bound_material;
+            if (shader != bound_shader) {
+                shader->use();
+                bound_shader = shader;
+                rebind_material = true; // Material uniforms live in the program
+                state_change_stats_.shader_binds++;
+            }
+
+            if (rebind_material) {
+                // Texture units are simply overwritten by the next material, no unbind in between
+                first.material->bind(shader->get_program_id());
+                bound_material = first.material;
+                state_change_stats_.material_binds++;
+                render_stats_.material_binds++;
+            }
+
+            if (batch.batched_shader) {
+                // Every mesh of the batch lives in the arena VAO, model matrices and object ids come from the records
+                if (first.mesh->get_vertex_array_id() != bound_vertex_array) {
+                    first.mesh->bind();
+                    bound_vertex_array = first.mesh->get_vertex_array_id();
+                    state_change_stats_.mesh_binds++;
+                }
+
+                indirect_buffer_->bind_base();
+                glMultiDrawElementsIndirect(GL_TRIANGLES, get_gl_index_type(first.mesh->get_index_type()),
+                                            reinterpret_cast<const void *>(
+                                                batch.first_indirect_command * sizeof(DrawElementsIndirectCommand)),
+                                            static_cast<GLsizei>(batch.indirect_command_count), 0);
+
+                count_multi_draw(batch.first_indirect_command, batch.indirect_command_count);
+                state_change_stats_.draw_calls++;
+                state_change_stats_.multi_draw_calls++;
+                state_change_stats_.batched_objects += batch.count;
+                continue;
+            }
+
+            for (uint32_t i = batch.first_entry; i < batch.first_entry + batch.count; i++) {
+                const RenderCommand &cmd = commands[sort_entries_[i].index];
+
+                if (cmd.mesh->get_vertex_array_id() != bound_vertex_array) {
+                    cmd.mesh->bind();
+                    bound_vertex_array = cmd.mesh->get_vertex_array_id();
+                    state_change_stats_.mesh_binds++;
+                }
+
+                // Lights, shadows and camera data come from the per-frame FrameData/LightData blocks
+                shader->set_uint(uniforms.object_id, cmd.entity_id);
+                RenderingUtils::set_standard_uniforms(*shader, cmd.transform->get_world_matrix() *
+                                                               cmd.mesh->get_position_decode(), view, projection);
+
+                cmd.mesh->draw_elements(cmd.lod);
+                count_draw(cmd.mesh->get_lod_index_count(cmd.lod), 1, false);
+                state_change_stats_.draw_calls++;
+            }
+        }
+
+        GLStateCache::depth_func(GL_LESS);
+        GLStateCache::depth_mask(true);
+    }
+
+    void Renderer::execute_depth_prepass(const std::vector<RenderCommand> &commands, const glm::mat4 &view,
+                                         const glm::mat4 &projection) {
+        GLStateCache::color_mask(false);
+        GLStateCache::depth_mask(true);
+        GLStateCache::depth_func(GL_LESS);
+
+        const Shader *bound_shader = nullptr;
+        const Material *bound_material = nullptr;
+        uint32_t bound_vertex_array = 0;
+
+        // Same batches in the same front-to-back order as the color pass, only the fragment shader differs
+        for (auto &batch: draw_batches_) {
+            const RenderCommand &first = commands[sort_entries_[batch.first_entry].index];
+            Shader *shader = batch.batched_shader
+                                 ? get_pass_shader(PassShader::DEPTH_ONLY, *first.material, *batch.batched_shader, true)
+                                 : get_pass_shader(PassShader::DEPTH_ONLY, *first.material, *first.shader, false);
+            batch.depth_prepassed = shader != nullptr;
+            if (!shader) continue;
+
+            bool rebind_material = first.material != bound_material;
+            if (shader != bound_shader) {
+                shader->use();
+                bound_shader = shader;
+                rebind_material = true;
+            }
+
+            // Custom vertex shaders may read material uniforms
+            if (rebind_material) {
+                first.material->bind(shader->get_program_id());
+                bound_material = first.material;
+                render_stats_.material_binds++;
+            }
+
+            if (batch.batched_shader) {
+                if (first.mesh->get_vertex_array_id() != bound_vertex_array) {
+                    first.mesh->bind();
+                    bound_vertex_array = first.mesh->get_vertex_array_id();
+                }
+
+                indirect_buffer_->bind_base();
+                glMultiDrawElementsIndirect(GL_TRIANGLES, get_gl_index_type(first.mesh->get_index_type()),
+                                            reinterpret_cast<const void *>(
+                                                batch.first_indirect_command * sizeof(DrawElementsIndirectCommand)),
+                                            static_cast<GLsizei>(batch.indirect_command_count), 0);
+                count_multi_draw(batch.first_indirect_command, batch.indirect_command_count);
+                state_change_stats_.prepass_draw_calls++;
+                continue;
+            }
+
+            for (uint32_t i = batch.first_entry; i < batch.first_entry + batch.count; i++) {
+                const RenderCommand &cmd = commands[sort_entries_[i].index];
+
+                if (cmd.mesh->get_vertex_array_id() != bound_vertex_array) {
+                    cmd.mesh->bind();
+                    bound_vertex_array = cmd.mesh->get_vertex_array_id();
+                }
+
+                RenderingUtils::set_standard_uniforms(*shader, cmd.transform->get_world_matrix() *
+                                                               cmd.mesh->get_position_decode(), view, projection);
+                cmd.mesh->draw_elements(cmd.lod);
+                count_draw(cmd.mesh->get_lod_index_count(cmd.lod), 1, false);
+                state_change_stats_.prepass_draw_calls++;
+            }
+        }
+
+        GLStateCache::color_mask(true);
+    }
+
+    void Renderer::draw_render_command(const RenderCommand &cmd, const glm::mat4 &view, const glm::mat4 &projection,
+                                       Shader *shader_override) {
+        const auto &uniforms = draw_uniform_ids();
+        Shader *shader = shader_override ? shader_override : get_color_pass_shader(*cmd.material, cmd.shader, false);
+        shader->use();
+
+        // Lights, shadows and camera data come from the per-frame FrameData/LightData blocks
+        shader->set_uint(uniforms.object_id, cmd.entity_id);
 
         // Upload default uniforms
-        RenderingUtils::set_standard_uniforms(shader, transform->get_world_matrix(), view, projection);
+        RenderingUtils::set_standard_uniforms(*shader, cmd.transform->get_world_matrix() * cmd.mesh->get_position_decode(),
+                                              view, projection);
 
         // Bind material and draw mesh
-        cmd.material->bind();
-        cmd.mesh->draw();
-        cmd.material->unbind();
+        cmd.material->bind(shader->get_program_id());
+        cmd.mesh->bind();
+        cmd.mesh->draw_elements(cmd.lod);
+        count_draw(cmd.mesh->get_lod_index_count(cmd.lod), 1, false);
+        render_stats_.material_binds++;
+
+        state_change_stats_.draw_calls++;
+        state_change_stats_.shader_binds++;
+        state_change_stats_.material_binds++;
+        state_change_stats_.mesh_binds++;
     }
 
     void Renderer::draw_instanced_command(const InstancedRenderCommand &cmd, const glm::mat4 &view,
-                                          const glm::mat4 &projection) {
+                                          const glm::mat4 &projection, Shader *shader_override) {
         if (const Entity *entity = scene_->get_entity(cmd.entity_id); !entity) return;
 
-        Shader &shader = get_shader_for_material(cmd.material);
+        Shader &shader = shader_override
+                             ? *shader_override
+                             : *get_color_pass_shader(*cmd.material, &get_shader_for_material(cmd.material), false);
         shader.use();
 
-        // Upload light data as uniforms to shader
-        if (context_) {
-            RenderingUtils::upload_lights_to_shader(shader, *context_);
-        }
-
         // Upload the standard uniform data to the shader (Model, View, Projection, Time)
         RenderingUtils::set_standard_uniforms(shader, glm::mat4(1.0f), view, projection, Time::current_time);
 
@@ -284,27 +835,32 @@ namespace hellfire {
         cmd.instanced_renderable->prepare_for_draw();
 
         // Bind material and draw
-        cmd.material->bind();
+        cmd.material->bind(shader.get_program_id());
+        render_stats_.material_binds++;
 
         const auto mesh = cmd.instanced_renderable->get_mesh();
         if (mesh) {
             mesh->bind();
-            cmd.instanced_renderable->bind_instance_buffers();
-            mesh->draw_instanced(cmd.instanced_renderable->get_instance_count());
-            mesh->unbind();
+            if (!cmd.instanced_renderable->bind_instance_buffers()) return;
+            // Instances are uploaded grouped by LOD, one draw per group
+            for (uint32_t lod = 0; lod < mesh->get_lod_count(); lod++) {
+                if (const uint32_t count = cmd.instanced_renderable->get_lod_instance_count(lod); count > 0) {
+                    mesh->draw_elements_instanced(count, lod, cmd.instanced_renderable->get_lod_first_instance(lod));
+                    count_draw(mesh->get_lod_index_count(lod), count, true);
+                }
+            }
         }
-
-        cmd.material->unbind();
     }
 
     void Renderer::execute_skybox_pass(Scene *scene, const glm::mat4 &view, const glm::mat4 &projection,
-                                       CameraComponent *camera_comp) const {
+                                       CameraComponent *camera_comp) {
         if (!scene || !scene->environment()->has_skybox()) return;
 
-        glDisable(GL_CULL_FACE);
+        GLStateCache::disable(GL_CULL_FACE);
 
         if (camera_comp) {
             skybox_renderer_.render(*scene->environment()->get_skybox(), camera_comp);
+            count_draw(36, 1, false); // Unindexed cube
         }
     }
 
@@ -321,157 +877,501 @@ namespace hellfire {
     }
 
     void Renderer::execute_main_pass(Scene &scene, CameraComponent &camera) {
-        clear_draw_list();
-        scene_ = &scene;
+        HF_PROFILE_SCOPE("Renderer::execute_main_pass");
+        state_change_stats_ = {};
+        culling_stats_.occluders_rendered = 0;
+        culling_stats_.occluder_triangles = 0;
+        culling_stats_.occlusion_tested = 0;
+        culling_stats_.occlusion_culled = 0;
+        lod_stats_ = {};
 
+        const glm::mat4 view = camera.get_view_matrix();
+        const glm::mat4 projection = camera.get_projection_matrix();
 
-        // Gather lights and geometry
+        // The geometry inside the camera frustum was gathered by collect_geometry_from_scene() already
         collect_lights_from_scene(scene, camera);
-        collect_geometry_from_scene(scene, camera.get_owner().transform()->get_position());
+        const glm::vec3 camera_pos = glm::vec3(camera.get_owner().transform()->get_world_matrix()[3]);
+        if (occlusion_culling_settings_.enabled) {
+            cull_occluded_commands(projection * view, camera_pos);
+        }
+        gather_lod_stats();
 
         // Execute rendering passes
-        const glm::mat4 view = camera.get_view_matrix();
-        const glm::mat4 projection = camera.get_projection_matrix();
 
-        execute_geometry_pass(view, projection);
-        execute_skybox_pass(&scene, view, projection, &camera);
-        execute_transparency_pass(view, projection);
+        upload_frame_data(camera, view, projection);
+
+        if (overdraw_view_enabled_) {
+            // The heat map starts from black and has no sky
+            constexpr float black[] = {0.0f, 0.0f, 0.0f, 1.0f};
+            glClearBufferfv(GL_COLOR, 0, black);
+        }
+
+        {
+            GPUTimer::Scope timer(gpu_timer_, "Geometry");
+            execute_geometry_pass(view, projection);
+        }
+        if (!overdraw_view_enabled_) {
+            GPUTimer::Scope timer(gpu_timer_, "Skybox");
+            execute_skybox_pass(&scene, view, projection, &camera);
+        }
+        {
+            GPUTimer::Scope timer(gpu_timer_, "Transparency");
+            execute_transparency_pass(view, projection);
+        }
+    }
+
+
+
+    void Renderer::gather_lod_stats() {
+        const auto count = [&](const Mesh &mesh, const uint32_t lod, const uint32_t draws) {
+            lod_stats_.triangles += static_cast<uint64_t>(mesh.get_lod_index_count(lod) / 3) * draws;
+            lod_stats_.full_detail_triangles += static_cast<uint64_t>(mesh.get_lod_index_count(0) / 3) * draws;
+            lod_stats_.draws_per_lod[lod] += draws;
+        };
+        for (const auto *commands: {&opaque_objects_, &transparent_objects_}) {
+            for (const RenderCommand &cmd: *commands) {
+                count(*cmd.mesh, cmd.lod, 1);
+            }
+        }
+        for (const auto *commands: {&opaque_instanced_objects_, &transparent_instanced_objects_}) {
+            for (const InstancedRenderCommand &cmd: *commands) {
+                const auto mesh = cmd.instanced_renderable->get_mesh();
+                for (uint32_t lod = 0; lod < mesh->get_lod_count(); lod++) {
+                    count(*mesh, lod, cmd.instanced_renderable->get_lod_instance_count(lod));
+                }
+            }
+        }
     }
 
+    void Renderer::cull_occluded_commands(const glm::mat4 &view_projection, const glm::vec3 &camera_pos) {
+        HF_PROFILE_SCOPE("Renderer::cull_occluded_commands");
+        const OcclusionCullingSettings &settings = occlusion_culling_settings_;
+        occlusion_buffer_.begin(view_projection);
 
+        // Occluder candidates, ALWAYS ones ahead of the AUTO ones in order of projected size
+        occluder_candidates_.clear();
+        for (uint32_t i = 0; i < opaque_objects_.size(); i++) {
+            const RenderCommand &cmd = opaque_objects_[i];
+            if (cmd.occluder_mode == RenderableComponent::OccluderMode::NEVER || cmd.mesh->get_index_count() == 0) continue;
+
+            if (cmd.occluder_mode == RenderableComponent::OccluderMode::ALWAYS) {
+                occluder_candidates_.emplace_back(std::numeric_limits<float>::max(), i);
+                continue;
+            }
+
+            if (static_cast<uint32_t>(cmd.mesh->get_index_count()) / 3 > settings.max_occluder_triangles ||
+                !cmd.world_bounds->is_valid()) {
+                continue;
+            }
+            const float radius = glm::length(cmd.world_bounds->get_extents());
+            const float distance = glm::length(cmd.world_bounds->get_center() - camera_pos);
+            const float size = radius / std::max(distance, 0.001f);
+            if (size >= settings.auto_occluder_size) {
+                occluder_candidates_.emplace_back(size, i);
+            }
+        }
+        std::sort(occluder_candidates_.begin(), occluder_candidates_.end(),
+                  [](const auto &a, const auto &b) { return a.first > b.first; });
+        if (occluder_candidates_.size() > settings.max_occluders) {
+            occluder_candidates_.resize(settings.max_occluders);
+        }
+
+        is_occluder_.assign(opaque_objects_.size(), 0);
+        uint32_t occluders_rendered = 0;
+        for (const auto &[size, index]: occluder_candidates_) {
+            const RenderCommand &cmd = opaque_objects_[index];
+            // Rasterizing needs the CPU copy, occluders read it back once and keep it
+            if (!cmd.mesh->ensure_cpu_data()) continue;
+            occlusion_buffer_.add_occluder(cmd.transform->get_world_matrix(), cmd.mesh->vertices, cmd.mesh->indices);
+            is_occluder_[index] = 1;
+            occluders_rendered++;
+        }
+        culling_stats_.occluders_rendered = occluders_rendered;
+        culling_stats_.occluder_triangles = occlusion_buffer_.get_triangle_count();
+        if (occluders_rendered == 0) return;
+
+        occlusion_buffer_.render(settings.worker_count);
+
+        // Occluders stay, they'd only be tested against themselves
+        size_t kept = 0;
+        for (size_t i = 0; i < opaque_objects_.size(); i++) {
+            if (!is_occluder_[i]) {
+                culling_stats_.occlusion_tested++;
+                if (!occlusion_buffer_.is_visible(*opaque_objects_[i].world_bounds)) {
+                    culling_stats_.occlusion_culled++;
+                    continue;
+                }
+            }
+            opaque_objects_[kept++] = opaque_objects_[i];
+        }
+        opaque_objects_.resize(kept);
+        std::erase_if(transparent_objects_, [&](const RenderCommand &cmd) {
+            culling_stats_.occlusion_tested++;
+            const bool hidden = !occlusion_buffer_.is_visible(*cmd.world_bounds);
+            if (hidden) culling_stats_.occlusion_culled++;
+            return hidden;
+        });
+    }
+
+    void Renderer::upload_frame_data(const CameraComponent &camera, const glm::mat4 &view,
+                                     const glm::mat4 &projection) {
+        if (!frame_data_buffer_ || !light_data_buffer_ || !context_) return;
+
+        FrameData frame_data{};
+        frame_data.view = view;
+        frame_data.projection = projection;
+        frame_data.view_projection = projection * view;
+        frame_data.view_position = camera.get_owner().transform()->get_world_position();
+        frame_data.time = Time::current_time;
+        frame_data.ambient_light = scene_->environment()->get_ambient_light();
+        frame_data_buffer_->upload(frame_data);
+
+        LightData light_data{};
+        light_data.num_directional_lights = context_->num_directional_lights;
+        light_data.shadow_bias = shadow_settings_.bias;
+
+        for (int i = 0; i < context_->num_directional_lights; i++) {
+            Entity *light_entity = context_->directional_light_entities[i];
+            auto *light = light_entity->get_component<LightComponent>();
+            if (!light) continue;
+
+            auto &gpu_light = light_data.directional_lights[i];
+            gpu_light.direction = light->get_direction();
+            gpu_light.color = light->get_color();
+            gpu_light.intensity = light->get_intensity();
+
+            // Lights without atlas tiles keep an empty tile rect, which the shaders treat as unshadowed
+            if (const auto it = shadow_maps_.find(light_entity->get_id()); it != shadow_maps_.end()) {
+                const ShadowMapData &shadow_data = it->second;
+                for (int c = 0; c < shadow_data.cascade_count; c++) {
+                    const ShadowCascade &cascade = shadow_data.cascades[c];
+                    light_data.shadow_matrices[i * MAX_SHADOW_CASCADES + c] = cascade.view_projection;
+                    light_data.shadow_tiles[i * MAX_SHADOW_CASCADES + c] = cascade.tile;
+                    // Every light splits the same camera range
+                    light_data.cascade_splits[c] = cascade.split_far;
+                }
+                if (shadow_data.cascade_count > 0) light_data.num_cascades = shadow_data.cascade_count;
+            }
+        }
+
+        // The atlas stays bound for the whole frame, material textures use the lower units
+        if (shadow_atlas_) {
+            const Framebuffer &atlas = sample_shadow_composite_ ? *shadow_composite_atlas_ : *shadow_atlas_;
+            GLStateCache::bind_texture_unit(SHADOW_MAP_TEXTURE_UNIT, GL_TEXTURE_2D, atlas.get_depth_attachment());
+        }
+
+        upload_light_clusters(camera, view, projection, light_data);
+        light_data_buffer_->upload(light_data);
+    }
+
+    void Renderer::upload_light_clusters(const CameraComponent &camera, const glm::mat4 &view,
+                                         const glm::mat4 &projection, LightData &light_data) {
+        point_light_data_.clear();
+        cluster_lights_.clear();
+        for (const Entity *light_entity: context_->point_light_entities) {
+            const auto *light = light_entity->get_component<LightComponent>();
+            if (!light) continue;
+
+            GPUPointLight &gpu_light = point_light_data_.emplace_back();
+            gpu_light.position = glm::vec3(light_entity->transform()->get_world_matrix()[3]);
+            gpu_light.color = light->get_color();
+            gpu_light.intensity = light->get_intensity();
+            gpu_light.range = light->get_range();
+            gpu_light.attenuation = light->get_attenuation();
+            cluster_lights_.push_back({gpu_light.position, gpu_light.range});
+        }
+        light_data.num_point_lights = static_cast<int32_t>(point_light_data_.size());
+
+        const float near_plane = std::max(camera.get_near_plane(), 0.01f);
+        const float far_plane = std::max(camera.get_far_plane(), near_plane * 2.0f);
+        light_clusters_.set_projection(projection, near_plane, far_plane);
+        light_clusters_.assign(view, cluster_lights_);
+
+        light_data.cluster_scale = glm::vec4(
+            static_cast<float>(LIGHT_CLUSTER_GRID_X) / static_cast<float>(framebuffer_width_),
+            static_cast<float>(LIGHT_CLUSTER_GRID_Y) / static_cast<float>(framebuffer_height_),
+            light_clusters_.get_depth_scale(), light_clusters_.get_depth_bias());
+        light_data.cluster_grid = glm::ivec4(LIGHT_CLUSTER_GRID_X, LIGHT_CLUSTER_GRID_Y, LIGHT_CLUSTER_GRID_Z, 0);
+
+        // Keep every buffer non-empty so its binding point is backed even without point lights
+        if (point_light_data_.empty()) point_light_data_.emplace_back();
+        const std::vector<uint32_t> &light_indices = light_clusters_.get_light_indices();
+        const uint32_t no_lights = 0;
+        point_light_buffer_->stream(point_light_data_);
+        light_cluster_buffer_->stream(light_clusters_.get_clusters());
+        if (light_indices.empty()) {
+            light_index_buffer_->stream(&no_lights, sizeof(no_lights));
+        } else {
+            light_index_buffer_->stream(light_indices);
+        }
+    }
 
     void Renderer::execute_shadow_passes(Scene &scene, CameraComponent& camera) {
+        HF_PROFILE_SCOPE("Renderer::execute_shadow_passes");
+        ensure_shadow_atlas();
+
          // Gather all lights that cast shadows
         const std::vector<EntityID> light_entity_ids = scene.find_entities_with_component<LightComponent>();
 
-        std::vector<Entity*> shadow_casting_lights;
+        for (auto &shadow_data: shadow_maps_ | std::views::values) {
+            shadow_data.is_active = false;
+        }
+
+        std::vector<std::pair<float, EntityID>> shadow_casting_lights;
         for (const EntityID id : light_entity_ids) {
             Entity* entity = scene.get_entity(id);
             if (!entity) continue;
 
             const auto* light = entity->get_component<LightComponent>();
-            if (light && light->should_cast_shadows()) {
-                shadow_casting_lights.push_back(entity);
+            // Only directional lights have cascaded shadow maps
+            if (light && light->should_cast_shadows() && light->get_light_type() == LightComponent::DIRECTIONAL) {
+                shadow_casting_lights.emplace_back(get_shadow_importance(*light), id);
+                ShadowMapData &shadow_data = shadow_maps_[id];
+                shadow_data.is_active = true;
+                if (shadow_data.timer_label.empty()) {
+                    shadow_data.timer_label = "Shadow: light " + std::to_string(id);
+                }
             }
         }
 
-        clear_draw_list();
-        scene_ = &scene;
-        const glm::vec3 dummy_camera_pos(0.0f); // Distance doesn't matter for shadows
-        for (const EntityID root_id : scene.get_root_entities()) {
-            collect_render_commands_recursive(root_id, dummy_camera_pos);
+        // Most important first, ties broken by id so the order is stable
+        std::ranges::sort(shadow_casting_lights, [](const auto &a, const auto &b) {
+            return a.first != b.first ? a.first > b.first : a.second < b.second;
+        });
+        std::vector<EntityID> lights_by_importance;
+        lights_by_importance.reserve(shadow_casting_lights.size());
+        for (const EntityID id: shadow_casting_lights | std::views::values) {
+            lights_by_importance.push_back(id);
         }
 
-        // Render each light's shadow map
-        for (Entity* light_entity : shadow_casting_lights) {
-            auto* light = light_entity->get_component<LightComponent>();
-            if (!light) continue;
+        const int cascade_count = std::clamp(shadow_settings_.cascade_count, 2, MAX_SHADOW_CASCADES);
+        assign_shadow_tiles(lights_by_importance, cascade_count);
+
+        shadow_stats_ = {};
+        shadow_stats_.atlas_texels_used = shadow_atlas_allocator_.get_used_texels();
+        shadow_stats_.atlas_texels = static_cast<uint64_t>(shadow_atlas_allocator_.get_atlas_size()) *
+                                     shadow_atlas_allocator_.get_atlas_size();
 
-            ensure_shadow_map(light_entity, *light);
+        culling_stats_.shadow_casters_tested = 0;
+        culling_stats_.shadow_casters_culled = 0;
 
-            auto& shadow_data = shadow_maps_[light_entity];
-            shadow_data.framebuffer->bind();
+        // Casters outside the camera view still shadow it, each light culls shadow_casters_ against its own frustum
+        bool has_dynamic_casters = false;
+        for (const RenderCommand &cmd: shadow_casters_) {
+            if (!cmd.is_static_caster) {
+                has_dynamic_casters = true;
+                break;
+            }
+        }
+
+        // The composite atlas only exists while something moves; it holds every light's tiles then
+        sample_shadow_composite_ = shadow_settings_.caching_enabled && has_dynamic_casters;
+        if (sample_shadow_composite_ && !shadow_composite_atlas_) {
+            shadow_composite_atlas_ = create_shadow_framebuffer(glm::uvec2(shadow_atlas_allocator_.get_atlas_size()));
+        }
+
+        // Render each light's cascades into its atlas tiles
+        for (const EntityID light_id : lights_by_importance) {
+            Entity *light_entity = scene.get_entity(light_id);
+            auto* light = light_entity->get_component<LightComponent>();
+            ShadowMapData &shadow_data = shadow_maps_[light_id];
+            if (shadow_data.cascade_count == 0) {
+                shadow_stats_.lights_without_tiles++;
+                continue;
+            }
+            GPUTimer::Scope timer(gpu_timer_, shadow_data.timer_label);
 
-            glViewport(0, 0, 4096, 4096);
-            glClear(GL_DEPTH_BUFFER_BIT);
-            glEnable(GL_DEPTH_TEST);
-            glDepthFunc(GL_LESS);
+            // Stored for the main pass. Camera movement only changes them once it crosses a whole texel
+            const bool cascades_changed = calculate_shadow_cascades(light->get_direction(), camera, shadow_data);
 
-            glEnable(GL_CULL_FACE);
-            glCullFace(GL_FRONT);
+            if (!shadow_settings_.caching_enabled) {
+                render_shadow_layer(shadow_data, *shadow_atlas_, ShadowCasterFilter::ALL, true);
+                shadow_data.static_layer_valid = false;
+                shadow_data.dynamic_layer_valid = false;
+                continue;
+            }
 
-            // Use light's view-projection matrix
-            shadow_data.light_view_proj =  calculate_light_view_proj(light_entity, light, camera); // Store for main pass
+            const bool static_layer_stale = !shadow_data.static_layer_valid || cascades_changed ||
+                                            shadow_data.static_caster_version != static_caster_version_;
+            if (static_layer_stale) {
+                render_shadow_layer(shadow_data, *shadow_atlas_, ShadowCasterFilter::STATIC, true);
+                shadow_data.static_layer_valid = true;
+                shadow_data.static_caster_version = static_caster_version_;
+                shadow_stats_.static_layers_rendered++;
+            }
 
-            // glEnable(GL_POLYGON_OFFSET_FILL);
-            // glPolygonOffset(1.5f, 2.0f);
+            if (!has_dynamic_casters) {
+                // The static tiles are the whole shadow map
+                if (!static_layer_stale) shadow_stats_.lights_skipped++;
+                shadow_data.dynamic_layer_valid = false;
+                continue;
+            }
 
-            // Render geometry to depth texture
-            draw_shadow_geometry(shadow_data.light_view_proj);
+            // The composite tiles are still right while the static tiles and every dynamic caster stayed the same
+            if (!static_layer_stale && shadow_data.dynamic_layer_valid &&
+                shadow_data.dynamic_caster_version == dynamic_caster_version_) {
+                shadow_stats_.lights_skipped++;
+                continue;
+            }
 
-            shadow_data.framebuffer->unbind();
+            // Dynamic casters go on top of a copy of the static tiles
+            for (int c = 0; c < shadow_data.cascade_count; c++) {
+                const ShadowAtlasTile &tile = shadow_data.tiles[c];
+                const auto size = static_cast<GLsizei>(tile.size);
+                glCopyImageSubData(shadow_atlas_->get_depth_attachment(), GL_TEXTURE_2D, 0,
+                                   static_cast<GLint>(tile.x), static_cast<GLint>(tile.y), 0,
+                                   shadow_composite_atlas_->get_depth_attachment(), GL_TEXTURE_2D, 0,
+                                   static_cast<GLint>(tile.x), static_cast<GLint>(tile.y), 0, size, size, 1);
+            }
+            render_shadow_layer(shadow_data, *shadow_composite_atlas_, ShadowCasterFilter::DYNAMIC, false);
+            shadow_data.dynamic_layer_valid = true;
+            shadow_data.dynamic_caster_version = dynamic_caster_version_;
+            shadow_stats_.dynamic_layers_rendered++;
         }
         // glDisable(GL_POLYGON_OFFSET_FILL);
-        glCullFace(GL_BACK);
-        glViewport(0, 0, framebuffer_width_, framebuffer_height_);            
+        GLStateCache::cull_face(GL_BACK);
+        GLStateCache::viewport(0, 0, framebuffer_width_, framebuffer_height_);
     }
 
-    void Renderer::draw_shadow_geometry(const glm::mat4 &light_view_proj) {
+    void Renderer::render_shadow_layer(const ShadowMapData &shadow_data, Framebuffer &target,
+                                       const ShadowCasterFilter filter, const bool clear) {
+        target.bind();
+
+        GLStateCache::enable(GL_DEPTH_TEST);
+        GLStateCache::depth_func(GL_LESS);
+        GLStateCache::depth_mask(true); // glClear honours the depth mask
+
+        GLStateCache::enable(GL_CULL_FACE);
+        GLStateCache::cull_face(GL_FRONT);
+
+        // glEnable(GL_POLYGON_OFFSET_FILL);
+        // glPolygonOffset(1.5f, 2.0f);
+
+        // Render geometry to depth texture, each cascade culls casters against its own box
+        for (int c = 0; c < shadow_data.cascade_count; c++) {
+            const ShadowAtlasTile &tile = shadow_data.tiles[c];
+            const auto x = static_cast<GLint>(tile.x);
+            const auto y = static_cast<GLint>(tile.y);
+            const auto size = static_cast<GLsizei>(tile.size);
+            GLStateCache::viewport(x, y, size, size);
+
+            if (clear) {
+                // Only this light's tile, the rest of the atlas belongs to other lights
+                GLStateCache::enable(GL_SCISSOR_TEST);
+                GLStateCache::scissor(x, y, size, size);
+                glClear(GL_DEPTH_BUFFER_BIT);
+                GLStateCache::disable(GL_SCISSOR_TEST);
+            }
+
+            draw_shadow_geometry(shadow_data.cascades[c].view_projection, filter);
+        }
+
+        target.unbind();
+    }
+
+    void Renderer::draw_shadow_geometry(const glm::mat4 &light_view_proj, const ShadowCasterFilter filter) {
+        const auto &uniforms = draw_uniform_ids();
         const Shader& shadow_shader = get_shader_for_material(shadow_material_);
         shadow_shader.use();
-        shadow_shader.set_mat4("uLightViewProjMatrix", light_view_proj);
+        shadow_shader.set_mat4(uniforms.light_view_proj, light_view_proj);
 
         shadow_material_->bind();
+        render_stats_.material_binds++;
 
-        for (const auto &cmd : opaque_objects_) {
-            const Entity *entity = scene_->get_entity(cmd.entity_id);
-            if (!entity) continue;
+        const Frustum light_frustum(light_view_proj);
 
-            const auto* transform = entity->get_component<TransformComponent>();
-            if (!transform) continue;
+        // Sorted by key, so draws sharing a mesh end up next to each other; arena meshes share one VAO
+        uint32_t bound_vertex_array = 0;
+        for (const RenderCommand &cmd: shadow_casters_) {
+            if (filter == ShadowCasterFilter::STATIC && !cmd.is_static_caster) continue;
+            if (filter == ShadowCasterFilter::DYNAMIC && cmd.is_static_caster) continue;
+
+            if (frustum_culling_enabled_) {
+                culling_stats_.shadow_casters_tested++;
+                if (!light_frustum.intersects(*cmd.world_bounds)) {
+                    culling_stats_.shadow_casters_culled++;
+                    continue;
+                }
+            }
+
+            if (cmd.mesh->get_vertex_array_id() != bound_vertex_array) {
+                cmd.mesh->bind();
+                bound_vertex_array = cmd.mesh->get_vertex_array_id();
+            }
 
             // Set model matrix for this object
-            shadow_shader.set_mat4("uModelMatrix", transform->get_world_matrix());
+            shadow_shader.set_mat4(uniforms.shadow_model, cmd.transform->get_world_matrix() *
+                                                          cmd.mesh->get_position_decode());
 
-            cmd.mesh->draw();
+            cmd.mesh->draw_elements(cmd.lod);
+            count_draw(cmd.mesh->get_lod_index_count(cmd.lod), 1, false);
+            render_stats_.shadow_draw_calls++;
         }
-
-        shadow_material_->unbind();
     }
 
-    glm::mat4 Renderer::calculate_light_view_proj(Entity *light_entity, LightComponent *light, const CameraComponent &camera) {
-        const glm::vec3 light_dir = glm::normalize(light->get_direction());
-
-        // Center shadow map on camera position
-        const glm::vec3 camera_pos = camera.get_owner().transform()->get_position();
-
-        const float ortho_size = 100.0f;
-        const float texel_size = (ortho_size * 2.0f) / 4096.0f;
-
-        glm::vec3 look_at;
-        look_at.x = floor(camera_pos.x / texel_size) * texel_size;
-        look_at.y = 0.0f;
-        look_at.z = float(camera_pos.z / texel_size) * texel_size;
-
-        const glm::vec3 light_pos = look_at - light_dir * 30.0f;
-
-        glm::vec3 up = glm::vec3(0.0f, 1.0f, 0.0f);
-        if (glm::abs(glm::dot(light_dir, up)) > 0.99f) {
-            up = glm::vec3(1.0f, 0.0f, 0.0f);
+    bool Renderer::calculate_shadow_cascades(const glm::vec3 &light_direction, const CameraComponent &camera,
+                                             ShadowMapData &shadow_data) const {
+        const float near_plane = camera.get_near_plane();
+        const float far_plane = camera.get_far_plane();
+        const float shadow_distance = std::min(far_plane, shadow_settings_.max_distance);
+
+        float splits[MAX_SHADOW_CASCADES];
+        ShadowCascades::compute_splits(near_plane, shadow_distance, shadow_data.cascade_count,
+                                       shadow_settings_.split_lambda, splits);
+
+        const glm::mat4 camera_view_projection = camera.get_projection_matrix() * camera.get_view_matrix();
+        const float atlas_size = static_cast<float>(shadow_atlas_allocator_.get_atlas_size());
+        // A cascade's matrix follows from the light, its snapped texel offset, radius and tile alone,
+        // so those are compared instead of the float matrices
+        bool changed = light_direction != shadow_data.light_direction ||
+                       shadow_settings_.caster_depth != shadow_data.caster_depth;
+        shadow_data.light_direction = light_direction;
+        shadow_data.caster_depth = shadow_settings_.caster_depth;
+        float split_near = near_plane;
+        for (int c = 0; c < shadow_data.cascade_count; c++) {
+            const ShadowAtlasTile &tile = shadow_data.tiles[c];
+            ShadowCascade cascade = ShadowCascades::fit(camera_view_projection, near_plane, far_plane, split_near,
+                                                        splits[c], light_direction, tile.size,
+                                                        shadow_settings_.caster_depth);
+            cascade.tile = glm::vec4(static_cast<float>(tile.x), static_cast<float>(tile.y),
+                                     static_cast<float>(tile.size), static_cast<float>(tile.size)) / atlas_size;
+            split_near = splits[c];
+
+            const ShadowCascade &previous = shadow_data.cascades[c];
+            changed |= cascade.texel_offset != previous.texel_offset || cascade.radius != previous.radius ||
+                       cascade.tile != previous.tile;
+            shadow_data.cascades[c] = cascade;
         }
-
-        const glm::mat4 light_projection = glm::ortho(
-            -ortho_size, ortho_size,
-            -ortho_size, ortho_size,
-            1.0f, 60.0f);
-
-        const glm::mat4 light_view = glm::lookAt(light_pos, look_at, up);
-        
-        return light_projection * light_view;
+        return changed;
     }
 
     void Renderer::execute_geometry_pass(const glm::mat4 &view, const glm::mat4 &proj) {
-        glEnable(GL_DEPTH_TEST);
-        glDepthMask(GL_TRUE);
-        glDepthFunc(GL_LESS);
-        glDisable(GL_BLEND);
-
-
-        glEnable(GL_CULL_FACE);
-        glCullFace(GL_BACK);
-        glFrontFace(GL_CCW);
+        HF_PROFILE_SCOPE("Renderer::execute_geometry_pass");
+        GLStateCache::enable(GL_DEPTH_TEST);
+        GLStateCache::depth_mask(true);
+        GLStateCache::depth_func(GL_LESS);
+        if (overdraw_view_enabled_) {
+            // Every shaded fragment adds one step of the heat ramp, object ids are written as usual
+            GLStateCache::set_enabled_indexed(GL_BLEND, 0, true);
+            GLStateCache::set_enabled_indexed(GL_BLEND, 1, false);
+            GLStateCache::blend_func(GL_ONE, GL_ONE);
+        } else {
+            GLStateCache::disable(GL_BLEND);
+        }
 
-        glEnable(GL_STENCIL_TEST);
-        glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+        GLStateCache::enable(GL_CULL_FACE);
+        GLStateCache::cull_face(GL_BACK);
+        GLStateCache::front_face(GL_CCW);
 
-        std::ranges::sort(opaque_objects_,
-                          [](const RenderCommand &a, const RenderCommand &b) {
-                              return a.distance_to_camera < b.distance_to_camera;
-                          });
+        GLStateCache::enable(GL_STENCIL_TEST);
+        GLStateCache::stencil_op(GL_KEEP, GL_KEEP, GL_REPLACE);
 
-        for (const auto &cmd: opaque_objects_) {
-            draw_render_command(cmd, view, proj);
+        sort_render_commands(opaque_objects_);
+        build_draw_batches(opaque_objects_);
+        if (depth_prepass_enabled_) {
+            execute_depth_prepass(opaque_objects_, view, proj);
         }
+        submit_sorted_commands(opaque_objects_, view, proj);
 
         for (const auto &cmd: opaque_instanced_objects_) {
             draw_instanced_command(cmd, view, proj);
@@ -479,50 +1379,126 @@ namespace hellfire {
     }
 
     void Renderer::execute_transparency_pass(const glm::mat4 &view, const glm::mat4 &proj) {
+        HF_PROFILE_SCOPE("Renderer::execute_transparency_pass");
         // Configure blending: enable for color input, disable for object ID output
-        glEnablei(GL_BLEND, 0); // Enable blending for fragColor (location 0)
-        glDisablei(GL_BLEND, 1); // Disable blending for objectID (location 1)
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        GLStateCache::set_enabled_indexed(GL_BLEND, 0, true); // Enable blending for fragColor (location 0)
+        GLStateCache::set_enabled_indexed(GL_BLEND, 1, false); // Disable blending for objectID (location 1)
+        if (overdraw_view_enabled_) {
+            GLStateCache::blend_func(GL_ONE, GL_ONE);
+        } else {
+            GLStateCache::blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        }
+
+        oit_drawn_.assign(transparent_objects_.size() + transparent_instanced_objects_.size(), 0);
+        if (oit_drawn_.empty()) return;
+
+        if (weighted_blended_oit_enabled_ && !overdraw_view_enabled_ && oit_composite_shader_) {
+            execute_weighted_blended_oit_pass(view, proj);
+            GLStateCache::set_enabled_indexed(GL_BLEND, 0, true);
+            GLStateCache::set_enabled_indexed(GL_BLEND, 1, false);
+            GLStateCache::blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            if (std::find(oit_drawn_.begin(), oit_drawn_.end(), 0) == oit_drawn_.end()) {
+                GLStateCache::depth_mask(true);
+                return;
+            }
+        }
 
         // Sort the transparent objects from back-to-front relative to camera
-        // This ensures proper blending order between different objects
-        std::ranges::sort(transparent_objects_,
-                          [](const RenderCommand &a, const RenderCommand &b) {
-                              return a.distance_to_camera > b.distance_to_camera;
-                          });
+        // This ensures proper blending order between different objects (depth leads the transparent key)
+        sort_render_commands(transparent_objects_);
 
         // Render non-instanced transparent objects with two-pass rendering
-        glDisable(GL_CULL_FACE);
-        for (const auto &cmd: transparent_objects_) {
+        GLStateCache::disable(GL_CULL_FACE);
+        for (const auto &entry: sort_entries_) {
+            if (oit_drawn_[entry.index]) continue;
+            const RenderCommand &cmd = transparent_objects_[entry.index];
             // Pass 1: Draw back faces, to depth buffer
-            glCullFace(GL_FRONT);
-            glDepthMask(GL_TRUE);
-            glEnable(GL_POLYGON_OFFSET_FILL);
-            glPolygonOffset(2.0f, 2.0f);
+            GLStateCache::cull_face(GL_FRONT);
+            GLStateCache::depth_mask(true);
+            GLStateCache::enable(GL_POLYGON_OFFSET_FILL);
+            GLStateCache::polygon_offset(2.0f, 2.0f);
             draw_render_command(cmd, view, proj);
-            glDisable(GL_POLYGON_OFFSET_FILL);
+            GLStateCache::disable(GL_POLYGON_OFFSET_FILL);
 
             // Pass 2: Draw front faces, don't write to depth buffer
-            glCullFace(GL_BACK);
-            glDepthMask(GL_FALSE);
+            GLStateCache::cull_face(GL_BACK);
+            GLStateCache::depth_mask(false);
             draw_render_command(cmd, view, proj);
         }
 
         // Render instanced transparent objects with two-pass rendering
-        for (const auto &cmd: transparent_instanced_objects_) {
+        for (size_t i = 0; i < transparent_instanced_objects_.size(); i++) {
+            if (oit_drawn_[transparent_objects_.size() + i]) continue;
+            const InstancedRenderCommand &cmd = transparent_instanced_objects_[i];
             // Pass 1: Draw back faces, to depth buffer
-            glCullFace(GL_FRONT);
-            glDepthMask(GL_TRUE);
+            GLStateCache::cull_face(GL_FRONT);
+            GLStateCache::depth_mask(true);
             draw_instanced_command(cmd, view, proj);
 
             // Pass 2: Draw front faces, don't write to depth buffer
-            glCullFace(GL_BACK);
-            glDepthMask(GL_FALSE);
+            GLStateCache::cull_face(GL_BACK);
+            GLStateCache::depth_mask(false);
             draw_instanced_command(cmd, view, proj);
         }
 
         // Restore depth writing
-        glDepthMask(GL_TRUE);
+        GLStateCache::depth_mask(true);
+    }
+
+    void Renderer::execute_weighted_blended_oit_pass(const glm::mat4 &view, const glm::mat4 &proj) {
+        Framebuffer &framebuffer = *scene_framebuffers_[current_fb_index_];
+        framebuffer.set_draw_buffers({
+            GL_NONE, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT0 + OIT_ACCUMULATION_ATTACHMENT,
+            GL_COLOR_ATTACHMENT0 + OIT_REVEALAGE_ATTACHMENT
+        });
+        constexpr float no_accumulation[] = {0.0f, 0.0f, 0.0f, 0.0f};
+        constexpr float full_revealage[] = {1.0f, 0.0f, 0.0f, 0.0f};
+        glClearBufferfv(GL_COLOR, OIT_ACCUMULATION_ATTACHMENT, no_accumulation);
+        glClearBufferfv(GL_COLOR, OIT_REVEALAGE_ATTACHMENT, full_revealage);
+
+        // Accumulation adds up, revealage multiplies by (1 - alpha); both are order independent,
+        // so the commands need no sorting and both faces are drawn in one go
+        GLStateCache::set_enabled_indexed(GL_BLEND, 1, false);
+        GLStateCache::set_enabled_indexed(GL_BLEND, OIT_ACCUMULATION_ATTACHMENT, true);
+        GLStateCache::set_enabled_indexed(GL_BLEND, OIT_REVEALAGE_ATTACHMENT, true);
+        GLStateCache::blend_func_indexed(OIT_ACCUMULATION_ATTACHMENT, GL_ONE, GL_ONE);
+        GLStateCache::blend_func_indexed(OIT_REVEALAGE_ATTACHMENT, GL_ZERO, GL_ONE_MINUS_SRC_COLOR);
+        GLStateCache::depth_mask(false);
+        GLStateCache::disable(GL_CULL_FACE);
+
+        for (size_t i = 0; i < transparent_objects_.size(); i++) {
+            const RenderCommand &cmd = transparent_objects_[i];
+            if (Shader *oit_shader = get_pass_shader(PassShader::OIT, *cmd.material, *cmd.shader, false)) {
+                draw_render_command(cmd, view, proj, oit_shader);
+                oit_drawn_[i] = 1;
+            }
+        }
+        for (size_t i = 0; i < transparent_instanced_objects_.size(); i++) {
+            const InstancedRenderCommand &cmd = transparent_instanced_objects_[i];
+            const Shader &shader = get_shader_for_material(cmd.material);
+            if (Shader *oit_shader = get_pass_shader(PassShader::OIT, *cmd.material, shader, false)) {
+                draw_instanced_command(cmd, view, proj, oit_shader);
+                oit_drawn_[transparent_objects_.size() + i] = 1;
+            }
+        }
+        GLStateCache::set_enabled_indexed(GL_BLEND, OIT_ACCUMULATION_ATTACHMENT, false);
+        GLStateCache::set_enabled_indexed(GL_BLEND, OIT_REVEALAGE_ATTACHMENT, false);
+
+        // Composite the average transparent color over the opaque image, object ids stay those of the opaque pass
+        framebuffer.set_draw_buffers({GL_COLOR_ATTACHMENT0});
+        GLStateCache::disable(GL_DEPTH_TEST);
+        GLStateCache::set_enabled_indexed(GL_BLEND, 0, true);
+        GLStateCache::blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        oit_composite_shader_->use();
+        GLStateCache::bind_texture_unit(0, GL_TEXTURE_2D, framebuffer.get_color_attachment(OIT_ACCUMULATION_ATTACHMENT));
+        GLStateCache::bind_texture_unit(1, GL_TEXTURE_2D, framebuffer.get_color_attachment(OIT_REVEALAGE_ATTACHMENT));
+        GLStateCache::bind_vertex_array(fullscreen_vao_);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        count_draw(3, 1, false);
+        state_change_stats_.draw_calls++;
+
+        GLStateCache::enable(GL_DEPTH_TEST);
+        framebuffer.set_draw_buffers({GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1});
     }
 
     void Renderer::create_main_framebuffer(uint32_t width, uint32_t height) {
@@ -539,6 +1515,9 @@ namespace hellfire {
         object_id_attachment_settings.format = GL_RED_INTEGER;
         object_id_attachment_settings.internal_format = GL_R32UI;
         object_id_attachment_settings.type = GL_UNSIGNED_INT;
+        // Integer textures can't be filtered, the upscale pass samples this one
+        object_id_attachment_settings.min_filter = GL_NEAREST;
+        object_id_attachment_settings.mag_filter = GL_NEAREST;
         scene_framebuffers_[SCREEN_TEXTURE_1] = std::make_unique<Framebuffer>();
         scene_framebuffers_[SCREEN_TEXTURE_1]->attach_color_texture(settings);
         scene_framebuffers_[SCREEN_TEXTURE_1]->attach_color_texture(object_id_attachment_settings);
@@ -548,21 +1527,107 @@ namespace hellfire {
         scene_framebuffers_[SCREEN_TEXTURE_2]->attach_color_texture(settings);
         scene_framebuffers_[SCREEN_TEXTURE_2]->attach_color_texture(object_id_attachment_settings);
         scene_framebuffers_[SCREEN_TEXTURE_2]->attach_depth_texture(settings);
+
+        // Weighted blended OIT targets, read texel for texel by the composite
+        FrameBufferAttachmentSettings accumulation_settings = settings;
+        accumulation_settings.internal_format = GL_RGBA16F;
+        accumulation_settings.type = GL_FLOAT;
+        accumulation_settings.min_filter = GL_NEAREST;
+        accumulation_settings.mag_filter = GL_NEAREST;
+        FrameBufferAttachmentSettings revealage_settings = accumulation_settings;
+        revealage_settings.internal_format = GL_R16F;
+        revealage_settings.format = GL_RED;
+        for (const auto &framebuffer: scene_framebuffers_) {
+            framebuffer->attach_color_texture(accumulation_settings);
+            framebuffer->attach_color_texture(revealage_settings);
+            // Only the regular passes' outputs are drawn to by default
+            framebuffer->set_draw_buffers({GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1});
+        }
     }
 
     void Renderer::resize_main_framebuffer(uint32_t width, uint32_t height) {
-        framebuffer_width_ = width;
-        framebuffer_height_ = height;
+        output_width_ = width;
+        output_height_ = height;
+        framebuffer_width_ = scale_render_size(width, render_scale_);
+        framebuffer_height_ = scale_render_size(height, render_scale_);
 
         // Resize only the current render buffer immediately.
         // The display buffer will be lazily resized on the next frame
         // to avoid showing cleared/incomplete frames during a window resize.
         if (scene_framebuffers_[0]) {
-            scene_framebuffers_[current_fb_index_]->resize(width, height);
+            scene_framebuffers_[current_fb_index_]->resize(framebuffer_width_, framebuffer_height_);
         }
     }
 
+    void Renderer::update_render_scale() {
+        float scale = std::clamp(render_scale_settings_.scale, RenderScaleController::MIN_SCALE,
+                                 RenderScaleController::MAX_SCALE);
+        if (render_scale_settings_.dynamic) {
+            if (!dynamic_render_scale_active_) {
+                render_scale_controller_.reset(render_scale_);
+                dynamic_render_scale_active_ = true;
+            }
+            // Each GPU frame time is fed once, skipping those still measured at an older scale
+            if (gpu_timer_.get_frames_collected() != render_scale_frames_collected_) {
+                render_scale_frames_collected_ = gpu_timer_.get_frames_collected();
+                if (render_scale_settle_frames_ > 0) {
+                    render_scale_settle_frames_--;
+                } else {
+                    render_scale_controller_.update(gpu_timer_.get_frame_history().get_latest(),
+                                                    render_scale_settings_);
+                }
+            }
+            scale = render_scale_controller_.get_scale();
+        } else {
+            dynamic_render_scale_active_ = false;
+        }
+
+        if (scale != render_scale_) {
+            render_scale_ = scale;
+            render_scale_settle_frames_ = GPUTimer::FRAME_LATENCY;
+        }
+        framebuffer_width_ = scale_render_size(output_width_, render_scale_);
+        framebuffer_height_ = scale_render_size(output_height_, render_scale_);
+    }
+
+    void Renderer::execute_upscale_pass() {
+        if (!output_framebuffer_ || output_framebuffer_->get_width() != output_width_ ||
+            output_framebuffer_->get_height() != output_height_) {
+            FrameBufferAttachmentSettings settings;
+            settings.width = output_width_;
+            settings.height = output_height_;
+            FrameBufferAttachmentSettings object_id_settings = settings;
+            object_id_settings.format = GL_RED_INTEGER;
+            object_id_settings.internal_format = GL_R32UI;
+            object_id_settings.type = GL_UNSIGNED_INT;
+            object_id_settings.min_filter = GL_NEAREST;
+            object_id_settings.mag_filter = GL_NEAREST;
+            output_framebuffer_ = std::make_unique<Framebuffer>();
+            output_framebuffer_->attach_color_texture(settings);
+            output_framebuffer_->attach_color_texture(object_id_settings);
+        }
+
+        const Framebuffer &source = *scene_framebuffers_[current_fb_index_];
+        output_framebuffer_->bind();
+        GLStateCache::disable(GL_DEPTH_TEST);
+        GLStateCache::disable(GL_BLEND);
+        upscale_shader_->use();
+        const float sharpness = render_scale_settings_.filter == UpscaleFilter::SHARPEN
+                                    ? std::clamp(render_scale_settings_.sharpness, 0.0f, 1.0f)
+                                    : 0.0f;
+        upscale_shader_->set_float(draw_uniform_ids().upscale_sharpness, sharpness);
+        GLStateCache::bind_texture_unit(0, GL_TEXTURE_2D, source.get_color_attachment(0));
+        GLStateCache::bind_texture_unit(1, GL_TEXTURE_2D, source.get_color_attachment(1));
+        GLStateCache::bind_vertex_array(fullscreen_vao_);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        count_draw(3, 1, false);
+
+        GLStateCache::enable(GL_DEPTH_TEST);
+        output_framebuffer_->unbind();
+    }
+
     uint32_t Renderer::get_main_output_texture() const {
+        if (upscaled_ && output_framebuffer_) return output_framebuffer_->get_color_attachment(0);
         const int display_index = 1 - current_fb_index_;
         if (scene_framebuffers_[display_index]) {
             return scene_framebuffers_[display_index]->get_color_attachment(0);
@@ -571,6 +1636,7 @@ namespace hellfire {
     }
 
     uint32_t Renderer::get_object_id_texture() const {
+        if (upscaled_ && output_framebuffer_) return output_framebuffer_->get_color_attachment(1);
         const int display_index = 1 - current_fb_index_;
         if (scene_framebuffers_[display_index]->get_color_attachment(1) != 0) {
             return scene_framebuffers_[display_index]->get_color_attachment(1);
@@ -579,19 +1645,32 @@ namespace hellfire {
     }
 
     void Renderer::render_frame(Scene &scene, CameraComponent &camera) {
+        HF_PROFILE_SCOPE("Renderer::render_frame");
+        // UI code draws with raw GL between frames, start from a clean slate
+        GLStateCache::invalidate();
+        GLStateCache::reset_stats();
+        get_shader_manager().reset_uniform_stats();
+        render_stats_ = {};
+        frame_index_++;
+        update_render_scale();
+
         if (!scene_framebuffers_[SCREEN_TEXTURE_1]) {
             create_main_framebuffer(framebuffer_width_, framebuffer_height_);
         }
 
-        // Check if the OTHER buffer (display buffer) needs resizing
-        const int display_index = 1 - current_fb_index_;
-        if (scene_framebuffers_[display_index] &&
-            (scene_framebuffers_[display_index]->get_width() != framebuffer_width_ ||
-             scene_framebuffers_[display_index]->get_height() != framebuffer_height_)) {
-            scene_framebuffers_[display_index]->resize(framebuffer_width_, framebuffer_height_);
+        // The display buffer is resized lazily after a window resize, and both after a render scale change
+        for (const auto &framebuffer: scene_framebuffers_) {
+            if (framebuffer->get_width() != framebuffer_width_ || framebuffer->get_height() != framebuffer_height_) {
+                framebuffer->resize(framebuffer_width_, framebuffer_height_);
+            }
         }
 
-        execute_shadow_passes(scene, camera);
+        // One walk over the scene for the camera's commands and the shadow casters both passes draw
+        collect_geometry_from_scene(scene, camera);
+        {
+            GPUTimer::Scope timer(gpu_timer_, "Shadows");
+            execute_shadow_passes(scene, camera);
+        }
 
         scene_framebuffers_[current_fb_index_]->bind();
         reset_framebuffer_data();
@@ -602,12 +1681,62 @@ namespace hellfire {
 
         execute_main_pass(scene, camera);
         scene_framebuffers_[current_fb_index_]->unbind();
+
+        upscaled_ = upscale_shader_ && (framebuffer_width_ != output_width_ || framebuffer_height_ != output_height_);
+        if (upscaled_) {
+            GPUTimer::Scope timer(gpu_timer_, "Upscale");
+            execute_upscale_pass();
+        }
         glFlush();
+        gl_state_stats_ = GLStateCache::get_stats();
+
+        render_stats_.program_binds = gl_state_stats_.program_binds;
+        render_stats_.vertex_array_binds = gl_state_stats_.vertex_array_binds;
+        render_stats_.texture_binds = gl_state_stats_.texture_binds;
+        render_stats_.buffer_bytes_uploaded = gl_state_stats_.buffer_bytes_uploaded;
+        render_stats_.uniform_uploads = get_shader_manager().get_uniform_upload_count();
+        render_stats_.objects_culled = culling_stats_.objects_culled + culling_stats_.occlusion_culled;
+        render_stats_.shadow_casters_culled = culling_stats_.shadow_casters_culled;
+        if (render_stats_csv_.is_open()) {
+            render_stats_.write_csv_row(render_stats_csv_, frame_index_);
+        }
 
         // Swap for next frame
         current_fb_index_ = 1 - current_fb_index_;
     }
 
+    bool Renderer::start_render_stats_csv(const std::filesystem::path &path) {
+        render_stats_csv_.close();
+        render_stats_csv_.open(path, std::ios::out | std::ios::trunc);
+        if (!render_stats_csv_) {
+            std::cerr << "Renderer: could not open " << path << " for writing render stats" << std::endl;
+            return false;
+        }
+        RenderStats::write_csv_header(render_stats_csv_);
+        return true;
+    }
+
+    void Renderer::stop_render_stats_csv() {
+        render_stats_csv_.close();
+    }
+
+    void Renderer::count_draw(const uint32_t index_count, const uint32_t instances, const bool instanced) {
+        render_stats_.draw_calls++;
+        if (instanced) render_stats_.instanced_draw_calls++;
+        render_stats_.triangles += static_cast<uint64_t>(index_count / 3) * instances;
+        render_stats_.instances += instances;
+    }
+
+    void Renderer::count_multi_draw(const uint32_t first_indirect_command, const uint32_t indirect_command_count) {
+        render_stats_.draw_calls++;
+        render_stats_.instanced_draw_calls++;
+        for (uint32_t i = first_indirect_command; i < first_indirect_command + indirect_command_count; i++) {
+            const DrawElementsIndirectCommand &command = indirect_commands_[i];
+            render_stats_.triangles += static_cast<uint64_t>(command.count / 3) * command.instance_count;
+            render_stats_.instances += command.instance_count;
+        }
+    }
+
     void Renderer::set_fallback_shader(Shader &fallback_shader) {
         fallback_shader_ = &fallback_shader;
 
@@ -616,7 +1745,7 @@ namespace hellfire {
         }
     }
 
-    Shader &Renderer::get_shader_for_material(const std::shared_ptr<Material> &material) {
+    Shader &Renderer::get_shader_for_material(Material *material) {
         if (!material) {
             return *fallback_shader_;
         }
@@ -632,7 +1761,7 @@ namespace hellfire {
         // Check if material needs compilation
         if (material->has_custom_shader()) {
             // Try to compile the material's shader
-            if (const uint32_t compiled_id = compile_material_shader(material); compiled_id != 0) {
+            if (const uint32_t compiled_id = compile_material_shader(*material); compiled_id != 0) {
                 material->set_compiled_shader_id(compiled_id);
                 const auto shader = shader_registry_.get_shader_from_id(compiled_id);
                 return *shader;
@@ -643,12 +1772,12 @@ namespace hellfire {
         return *fallback_shader_;
     }
 
-    uint32_t Renderer::compile_material_shader(std::shared_ptr<Material> material) {
-        if (!material || !material->has_custom_shader()) {
+    uint32_t Renderer::compile_material_shader(Material &material) {
+        if (!material.has_custom_shader()) {
             return 0;
         }
 
-        const Material::ShaderInfo *shader_info = material->get_shader_info();
+        const Material::ShaderInfo *shader_info = material.get_shader_info();
         if (!shader_info) {
             return 0;
         }
@@ -660,9 +1789,10 @@ namespace hellfire {
         variant.defines = shader_info->defines;
 
         // Add automatic defines based on material properties
-        shader_manager_.add_automatic_defines(*material, variant.defines);
+        ShaderManager &shader_manager = get_shader_manager();
+        shader_manager.add_automatic_defines(material, variant.defines);
 
         // Compile using shader manager
-        return shader_manager_.load_shader(variant);
+        return shader_manager.load_shader(variant);
     }
 }
@@ -1,68 +1,183 @@
 #pragma once
 #include <cstdint>
+#include <filesystem>
+#include <fstream>
 #include <vector>
 #include <memory>
 
+#include "FrameData.h"
+#include "LightClusters.h"
 #include "RendererContext.h"
+#include "RenderObjectRegistry.h"
+#include "RenderScale.h"
+#include "RenderSortKey.h"
+#include "RenderStats.h"
+#include "ShadowAtlasAllocator.h"
+#include "ShadowCascades.h"
 #include "hellfire/ecs/Entity.h"
 #include "hellfire/ecs/LightComponent.h"
 #include "hellfire/ecs/RenderableComponent.h"
 #include "hellfire/graphics/backends/opengl/Framebuffer.h"
+#include "hellfire/graphics/backends/opengl/GeometryArena.h"
+#include "hellfire/graphics/backends/opengl/GLStateCache.h"
+#include "hellfire/graphics/backends/opengl/GPUTimer.h"
+#include "hellfire/graphics/backends/opengl/ShaderBuffer.h"
+#include "hellfire/graphics/culling/Frustum.h"
+#include "hellfire/graphics/culling/OcclusionBuffer.h"
+#include "hellfire/graphics/geometry/MeshLod.h"
 #include "hellfire/graphics/renderer/SkyboxRenderer.h"
 #include "hellfire/graphics/shader/ShaderRegistry.h"
 
 namespace hellfire {
     class InstancedRenderableComponent;
+    class TransformComponent;
     class Scene;
     class Material;
     class Mesh;
 
     using EntityID = uint32_t;
 
+    /// Compact render packet. Handles are raw; the entity's components keep them alive for the frame.
     struct RenderCommand {
+        uint64_t sort_key; // See RenderSortKey
         EntityID entity_id; // The entity being rendered
-        std::shared_ptr<Mesh> mesh; // Direct reference to renderable component
-        std::shared_ptr<Material> material; // Material for sorting and rendering
+        Mesh *mesh;
+        Material *material;
+        Shader *shader; // Resolved once at collection time
+        const TransformComponent *transform;
+        const AABB *world_bounds; // Owned by the MeshComponent, used for per-light caster culling
         float distance_to_camera; // Distance for sorting
         bool is_transparent; // Transparency flag for render pass
-
-        bool operator<(const RenderCommand &other) const {
-            if (is_transparent && other.is_transparent) {
-                return distance_to_camera > other.distance_to_camera;
-            }
-            return !is_transparent && other.is_transparent;
-        }
+        bool casts_shadows;
+        bool is_static_caster; // Drawn into the cached static shadow layer instead of every frame
+        RenderableComponent::OccluderMode occluder_mode;
+        uint32_t lod; // Level of detail of mesh to draw
     };
 
     struct InstancedRenderCommand {
         EntityID entity_id;
         InstancedRenderableComponent *instanced_renderable;
-        std::shared_ptr<Material> material;
+        Material *material;
         float distance_to_camera;
         bool is_transparent;
+    };
 
-        bool operator<(const RenderCommand &other) const {
-            if (is_transparent && other.is_transparent) {
-                return distance_to_camera > other.distance_to_camera;
-            }
-            return !is_transparent && other.is_transparent;
-        }
+    /// Binds issued by the main pass, compared against binding shader, material and mesh for every draw
+    struct StateChangeStats {
+        uint32_t draw_calls = 0;
+        uint32_t shader_binds = 0;
+        uint32_t material_binds = 0;
+        uint32_t mesh_binds = 0;
+        uint32_t multi_draw_calls = 0; // glMultiDrawElementsIndirect calls issued for batched runs
+        uint32_t batched_objects = 0; // Objects drawn by those calls
+        uint32_t prepass_draw_calls = 0; // Depth-only draws of the depth pre-pass, not part of draw_calls
+
+        uint32_t get_state_changes() const { return shader_binds + material_binds + mesh_binds; }
+        uint32_t get_state_changes_saved() const { return draw_calls * 3 - get_state_changes(); }
+    };
+
+    /// Objects rejected by frustum culling, for the camera and summed over all shadow casting lights
+    struct CullingStats {
+        uint32_t objects_tested = 0;
+        uint32_t objects_culled = 0;
+        uint32_t shadow_casters_tested = 0;
+        uint32_t shadow_casters_culled = 0;
+        uint32_t occluders_rendered = 0; // Meshes rasterized into the occlusion buffer
+        uint32_t occluder_triangles = 0; // Their triangles after clipping
+        uint32_t occlusion_tested = 0;
+        uint32_t occlusion_culled = 0;
     };
 
+    /**
+     * Meshes draw the coarsest LOD whose simplification error stays under error_pixels once
+     * projected to the screen. Instanced meshes pick a LOD per instance.
+     */
+    struct LodSettings {
+        bool enabled = true;
+        float error_pixels = 1.0f;
+        float hysteresis = 0.25f; // Fraction of error_pixels a LOD's error has to pass to switch, stops popping
+    };
+
+    /// Triangles the main pass submitted against what drawing everything at LOD 0 would have cost
+    struct LodStats {
+        uint64_t triangles = 0;
+        uint64_t full_detail_triangles = 0;
+        uint32_t draws_per_lod[MAX_MESH_LODS] = {}; // Objects and instances drawn at each LOD
+    };
+
+    /**
+     * Shadow state of one directional light. Every cascade gets its own tile of the shared
+     * shadow atlas, cascade_count is 0 while the atlas has no room for the light.
+     *
+     * With caching on, the static atlas only holds the static casters and a light's tiles are
+     * re-rendered when its cascades or the static caster set change. Dynamic casters are drawn
+     * every frame into the composite atlas on top of a copy of those tiles.
+     */
     struct ShadowMapData {
-        std::unique_ptr<Framebuffer> framebuffer;
-        glm::mat4 light_view_proj;
+        ShadowAtlasTile tiles[MAX_SHADOW_CASCADES];
+        int cascade_count = 0;
+        ShadowCascade cascades[MAX_SHADOW_CASCADES];
+        uint64_t allocation_epoch = 0; // Atlas free epoch at the last allocation, newer frees allow an upgrade
+
+        uint64_t static_caster_version = 0; // Renderer::static_caster_version_ the static layer was drawn with
+        uint64_t dynamic_caster_version = 0; // Renderer::dynamic_caster_version_ the composite tiles were drawn with
+        glm::vec3 light_direction = glm::vec3(0.0f); // Cascades were fit to these, see calculate_shadow_cascades()
+        float caster_depth = 0.0f;
+        bool static_layer_valid = false;
+        bool dynamic_layer_valid = false;
+        bool is_active = false; // Still casting shadows this frame, inactive lights give their tiles back
+        std::string timer_label; // GPU timer pass, keyed by the light's id so lights sharing a name stay apart
+    };
+
+    /// Shadow work and atlas use of the last frame
+    struct ShadowStats {
+        uint32_t static_layers_rendered = 0;
+        uint32_t dynamic_layers_rendered = 0;
+        uint32_t lights_skipped = 0; // Neither layer had to be drawn
+        uint32_t lights_without_tiles = 0; // Didn't fit into the atlas, rendered without shadows
+        uint64_t atlas_texels_used = 0;
+        uint64_t atlas_texels = 0;
     };
 
     struct ShadowSettings {
         float bias = 0.005f;
+        int cascade_count = 4; // Clamped to [2, MAX_SHADOW_CASCADES]
+        uint32_t atlas_size = 4096; // Texels along one side of the shadow atlas, this bounds shadow memory
+        uint32_t cascade_resolution = 1024; // Preferred cascade tile size, less important lights get less when full
+        float split_lambda = 0.75f; // 0 = uniform splits, 1 = logarithmic
+        float max_distance = 150.0f; // Shadows end here or at the camera far plane, whichever is closer
+        float caster_depth = 50.0f; // How far towards the light casters outside a cascade are still caught
+        bool caching_enabled = true; // Keep static casters in a cached layer, only redraw moving ones
+        uint32_t static_caster_frames = 30; // Frames a caster has to stay put before it counts as static
+    };
+
+    /**
+     * Software occlusion culling of the main pass. Occluders are rasterized on the CPU into a small
+     * depth buffer and every other visible object's bounds are tested against it. AUTO occluders
+     * are picked by projected size, biggest first.
+     */
+    struct OcclusionCullingSettings {
+        bool enabled = false;
+        float auto_occluder_size = 0.2f; // Bounding radius over distance an AUTO occluder needs at least
+        uint32_t max_occluder_triangles = 2048; // AUTO occluders with more triangles are too costly to rasterize
+        uint32_t max_occluders = 32; // Per frame, ALWAYS occluders count towards this too
+        uint32_t worker_count = 4; // Threads rasterizing the buffer, including the render thread
+    };
+
+    /**
+     * Opaque draws sharing shader and material are merged into one multi-draw indirect call,
+     * draws that also share a mesh become instances of a single indirect command.
+     */
+    struct DrawBatchingSettings {
+        bool enabled = true;
+        uint32_t min_batch_size = 2; // Runs shorter than this are submitted as plain draws
     };
 
     class Renderer {
     public:
         Renderer();
 
-        ~Renderer() = default;
+        ~Renderer();
 
         void init();
 
@@ -91,19 +206,85 @@ namespace hellfire {
 
         uint32_t get_object_id_texture() const;
 
+        /// Output size, the scene itself is rendered at this size times the render scale
         void resize_main_framebuffer(uint32_t width, uint32_t height);
 
+        /// Applied at the next render_frame(); dynamic scaling needs the GPU timer enabled to get frame times
+        RenderScaleSettings &get_render_scale_settings() { return render_scale_settings_; }
+        /// Scale of the last frame, its scene resolution is get_render_width() x get_render_height()
+        float get_render_scale() const { return render_scale_; }
+        uint32_t get_render_width() const { return framebuffer_width_; }
+        uint32_t get_render_height() const { return framebuffer_height_; }
+
         void set_fallback_shader(Shader &fallback_shader);
 
-        Shader &get_shader_for_material(const std::shared_ptr<Material> &material);
+        Shader &get_shader_for_material(Material *material);
 
-        uint32_t compile_material_shader(std::shared_ptr<Material> material);
+        Shader &get_shader_for_material(const std::shared_ptr<Material> &material) {
+            return get_shader_for_material(material.get());
+        }
+
+        uint32_t compile_material_shader(Material &material);
 
-        ShaderManager &get_shader_manager() { return shader_manager_; }
+        ShaderManager &get_shader_manager() { return *shader_registry_.get_shader_manager(); }
         ShaderRegistry &get_shader_registry() { return shader_registry_; }
         ShadowSettings &get_shadow_settings() { return shadow_settings_; }
+        DrawBatchingSettings &get_draw_batching_settings() { return draw_batching_settings_; }
+        OcclusionCullingSettings &get_occlusion_culling_settings() { return occlusion_culling_settings_; }
+        LodSettings &get_lod_settings() { return lod_settings_; }
+        const LodStats &get_lod_stats() const { return lod_stats_; }
+        const StateChangeStats &get_state_change_stats() const { return state_change_stats_; }
+        const CullingStats &get_culling_stats() const { return culling_stats_; }
+        /// GL calls made by the last render_frame() vs. the ones the state cache dropped
+        const GLStateStats &get_gl_state_stats() const { return gl_state_stats_; }
+        const RenderObjectStats &get_render_object_stats() const { return render_objects_.get_stats(); }
+        const ShadowStats &get_shadow_stats() const { return shadow_stats_; }
+        const LightClusterStats &get_light_cluster_stats() const { return light_clusters_.get_stats(); }
+        /// GPU time per pass, a few frames behind; UI code can time its own passes on it too
+        GPUTimer &get_gpu_timer() { return gpu_timer_; }
+        /// Totals of the last render_frame()
+        const RenderStats &get_render_stats() const { return render_stats_; }
+
+        /// Append a RenderStats row to a CSV file after every frame until stop_render_stats_csv()
+        bool start_render_stats_csv(const std::filesystem::path &path);
+        void stop_render_stats_csv();
+        bool is_writing_render_stats_csv() const { return render_stats_csv_.is_open(); }
+
+        void set_frustum_culling(bool enable) { frustum_culling_enabled_ = enable; }
+        bool is_frustum_culling_enabled() const { return frustum_culling_enabled_; }
+
+        /// Draw opaque geometry depth-only first, the color pass then shades one fragment per pixel (GL_EQUAL)
+        void set_depth_prepass(bool enable) { depth_prepass_enabled_ = enable; }
+        bool is_depth_prepass_enabled() const { return depth_prepass_enabled_; }
+
+        /// Replace the lit image with a heat map of how many fragments each pixel shades
+        void set_overdraw_view(bool enable) { overdraw_view_enabled_ = enable; }
+        bool is_overdraw_view_enabled() const { return overdraw_view_enabled_; }
+
+        /**
+         * @brief Blend transparent surfaces with weighted blended OIT instead of sorting them back to front.
+         * Materials whose fragment shader has no OIT path keep the sorted path, drawn over the composite.
+         */
+        void set_weighted_blended_oit(bool enable) { weighted_blended_oit_enabled_ = enable; }
+        bool is_weighted_blended_oit_enabled() const { return weighted_blended_oit_enabled_; }
 
     private:
+        /// Run of sorted opaque commands with the same shader and material
+        struct DrawBatch {
+            uint32_t first_entry; // Index into sort_entries_
+            uint32_t count;
+            Shader *batched_shader; // INSTANCED variant, nullptr: draw the run one command at a time
+            uint32_t first_indirect_command;
+            uint32_t indirect_command_count;
+            bool depth_prepassed; // Depth already laid down, so the color pass tests GL_EQUAL without writing
+        };
+
+        enum class PassShader { DEPTH_ONLY, OVERDRAW, OIT };
+
+        // Scene framebuffer attachments written by the weighted blended transparency pass
+        static constexpr uint32_t OIT_ACCUMULATION_ATTACHMENT = 2;
+        static constexpr uint32_t OIT_REVEALAGE_ATTACHMENT = 3;
+
         enum RendererFboId : uint32_t {
             SCREEN_TEXTURE_1 = 0,
             SCREEN_TEXTURE_2 = 1,
@@ -122,43 +303,178 @@ namespace hellfire {
         int current_fb_index_ = 0;
 
         bool render_to_framebuffer_;
-        uint32_t framebuffer_width_;
+        uint32_t framebuffer_width_; // Scene resolution, the output size times render_scale_
         uint32_t framebuffer_height_;
+        uint32_t output_width_ = 800;
+        uint32_t output_height_ = 600;
+
+        // Dynamic resolution: the scene is filtered up into output_framebuffer_ when rendered below the output size
+        RenderScaleSettings render_scale_settings_;
+        RenderScaleController render_scale_controller_;
+        float render_scale_ = 1.0f;
+        bool dynamic_render_scale_active_ = false;
+        uint64_t render_scale_frames_collected_ = 0; // GPUTimer frames already fed to the controller
+        uint32_t render_scale_settle_frames_ = 0; // GPU frame times still measured at the previous scale
+        std::unique_ptr<Framebuffer> output_framebuffer_;
+        Shader *upscale_shader_ = nullptr;
+        bool upscaled_ = false; // Last frame's output is output_framebuffer_ rather than a scene framebuffer
 
         // Render command lists
         std::vector<RenderCommand> opaque_objects_;
         std::vector<RenderCommand> transparent_objects_;
         std::vector<InstancedRenderCommand> opaque_instanced_objects_;
         std::vector<InstancedRenderCommand> transparent_instanced_objects_;
-        std::unordered_map<Entity *, ShadowMapData> shadow_maps_;
+        // Every opaque shadow caster, in or out of view, by sort key. Rebuilt when the render objects change,
+        // otherwise collect_geometry_from_scene() only patches the static flag and LOD of each
+        std::vector<RenderCommand> shadow_casters_;
+        uint64_t shadow_casters_version_ = UINT64_MAX; // render_objects_ version shadow_casters_ was built from
+
+        // Sorted order of the command list being submitted, plus radix sort scratch space
+        std::vector<RenderSortEntry> sort_entries_;
+        std::vector<RenderSortEntry> sort_scratch_;
+        StateChangeStats state_change_stats_;
+        DrawBatchingSettings draw_batching_settings_;
+        std::vector<DrawBatch> draw_batches_;
+        std::vector<GPUInstanceData> instance_data_;
+        std::vector<DrawElementsIndirectCommand> indirect_commands_;
+        std::unordered_map<uint32_t, Shader *> instanced_shaders_; // Program id -> its INSTANCED variant, or nullptr
+        std::unordered_map<uint32_t, Shader *> depth_only_shaders_; // Program id -> its depth pre-pass variant, or nullptr
+        std::unordered_map<uint32_t, Shader *> overdraw_shaders_; // Program id -> its overdraw view variant, or nullptr
+        std::unordered_map<uint32_t, Shader *> oit_shaders_; // Program id -> its OIT variant, or nullptr
+        CullingStats culling_stats_;
+        GLStateStats gl_state_stats_;
+        RenderObjectRegistry render_objects_; // Retained renderables of the scene being drawn
+        bool frustum_culling_enabled_ = true;
+        OcclusionCullingSettings occlusion_culling_settings_;
+        OcclusionBuffer occlusion_buffer_;
+        std::vector<std::pair<float, uint32_t>> occluder_candidates_; // Projected size, opaque command index
+        std::vector<uint8_t> is_occluder_; // Per opaque command, scratch of cull_occluded_commands()
+        LodSettings lod_settings_;
+        LodStats lod_stats_;
+        bool depth_prepass_enabled_ = false;
+        bool overdraw_view_enabled_ = false;
+        bool weighted_blended_oit_enabled_ = false;
+        GPUTimer gpu_timer_;
+        RenderStats render_stats_;
+        std::ofstream render_stats_csv_;
+        Shader *oit_composite_shader_ = nullptr;
+        uint32_t fullscreen_vao_ = 0; // Empty, full screen triangles come from gl_VertexID
+        std::vector<uint8_t> oit_drawn_; // Per transparent command, scratch of execute_transparency_pass()
+        std::unordered_map<EntityID, ShadowMapData> shadow_maps_;
+        std::unique_ptr<Framebuffer> shadow_atlas_; // Static casters, or all of them with caching off
+        std::unique_ptr<Framebuffer> shadow_composite_atlas_; // Static tiles plus dynamic casters, made on demand
+        ShadowAtlasAllocator shadow_atlas_allocator_;
+        uint64_t shadow_atlas_free_epoch_ = 0;
+        bool sample_shadow_composite_ = false;
         ShadowSettings shadow_settings_;
+        ShadowStats shadow_stats_;
+        uint64_t frame_index_ = 0;
+        uint64_t static_caster_version_ = 1; // Bumped whenever the set of static shadow casters may have changed
+        uint64_t dynamic_caster_version_ = 1; // Bumped whenever a dynamic shadow caster moved, changed LOD or came and went
 
         SkyboxRenderer skybox_renderer_;
         std::shared_ptr<Material> shadow_material_;
 
-        void collect_render_commands_recursive(EntityID entity_id, const glm::vec3 &camera_pos);
+        // Per-frame uniform blocks (see FrameData.h)
+        std::unique_ptr<ShaderBuffer> frame_data_buffer_;
+        std::unique_ptr<ShaderBuffer> light_data_buffer_;
+        std::unique_ptr<ShaderBuffer> instance_buffer_; // Per-draw records of the batched draws, streamed every pass
+        std::unique_ptr<ShaderBuffer> indirect_buffer_;
+
+        // Clustered point lights: every light, the light list range of each cluster and the lists themselves
+        LightClusters light_clusters_;
+        std::vector<GPUPointLight> point_light_data_;
+        std::vector<LightClusters::Light> cluster_lights_;
+        std::unique_ptr<ShaderBuffer> point_light_buffer_;
+        std::unique_ptr<ShaderBuffer> light_cluster_buffer_;
+        std::unique_ptr<ShaderBuffer> light_index_buffer_;
+
+        /// Returns true when the object's mesh, material, shader or transparency changed
+        bool refresh_render_object(RenderObject &object);
+
+        void rebuild_shadow_casters();
+
+        void ensure_shadow_atlas();
+
+        /// Hand out atlas tiles to the lights, most important first, and reclaim those of inactive lights
+        void assign_shadow_tiles(const std::vector<EntityID> &lights_by_importance, int cascade_count);
 
-        void ensure_shadow_map(Entity *light_entity, const LightComponent &light);
+        /// Tries tile sizes from preferred_size down, returns false when not even the smallest fits
+        bool allocate_shadow_tiles(ShadowMapData &shadow_data, int cascade_count, uint32_t preferred_size);
+
+        void free_shadow_tiles(ShadowMapData &shadow_data);
 
         void store_lights_in_context(const std::vector<Entity *> &light_entities, CameraComponent &camera);
 
         void collect_lights_from_scene(Scene & scene, CameraComponent & camera);
-        void collect_geometry_from_scene(Scene &scene, const glm::vec3 camera_pos);
+        /// Once per frame: the commands inside the camera view with their LODs, and the shadow casters
+        void collect_geometry_from_scene(Scene &scene, const CameraComponent &camera);
+        void gather_lod_stats();
 
         void execute_main_pass(Scene& scene, CameraComponent& camera);
-        glm::mat4 calculate_light_view_proj(Entity *light_entity, LightComponent *light, const CameraComponent &camera);
-        void draw_shadow_geometry(const glm::mat4& light_view_proj);
+        /// Rasterize the occluders among the opaque commands, then drop the commands hidden behind them
+        void cull_occluded_commands(const glm::mat4 &view_projection, const glm::vec3 &camera_pos);
+        void upload_frame_data(const CameraComponent &camera, const glm::mat4 &view, const glm::mat4 &projection);
+        /// Assign the point lights to the froxel grid and stream the light lists
+        void upload_light_clusters(const CameraComponent &camera, const glm::mat4 &view, const glm::mat4 &projection,
+                                   LightData &light_data);
+        /// Returns true when the light turned or any cascade moved by a texel, resized or got another tile
+        bool calculate_shadow_cascades(const glm::vec3 &light_direction, const CameraComponent &camera,
+                                       ShadowMapData &shadow_data) const;
+
+        enum class ShadowCasterFilter { ALL, STATIC, DYNAMIC };
+
+        void render_shadow_layer(const ShadowMapData &shadow_data, Framebuffer &target, ShadowCasterFilter filter,
+                                 bool clear);
+        void draw_shadow_geometry(const glm::mat4& light_view_proj, ShadowCasterFilter filter);
 
         void execute_shadow_passes(Scene &scene, CameraComponent &camera);
         void execute_geometry_pass(const glm::mat4 &view, const glm::mat4 &proj);
         void execute_skybox_pass(Scene *scene, const glm::mat4 &view, const glm::mat4 &projection,
-                                CameraComponent *camera_comp) const;
+                                CameraComponent *camera_comp);
         void execute_transparency_pass(const glm::mat4 &view, const glm::mat4 &proj);
 
+        /// Pick this frame's render scale and size the scene framebuffers for it
+        void update_render_scale();
+
+        /// Filter the scene framebuffer just rendered up to the output size, object ids included
+        void execute_upscale_pass();
+
+        /// Draw the transparent commands that have an OIT variant into the OIT targets and composite them
+        /// over the opaque image, marks the commands it drew in oit_drawn_
+        void execute_weighted_blended_oit_pass(const glm::mat4 &view, const glm::mat4 &proj);
+
+        void sort_render_commands(const std::vector<RenderCommand> &commands);
+
+        void build_draw_batches(const std::vector<RenderCommand> &commands);
+
+        Shader *get_instanced_shader(const RenderCommand &cmd);
+
+        /// Pass variant of the program a draw is shaded with, nullptr when its vertex shader doesn't support the pass
+        Shader *get_pass_shader(PassShader pass, const Material &material, const Shader &shader, bool instanced);
+
+        /// Shader of a draw in the color passes, the overdraw variant while the overdraw view is on
+        Shader *get_color_pass_shader(const Material &material, Shader *shader, bool instanced);
+
+        /// Depth-only draw of the opaque batches built by build_draw_batches(), marks the ones it covered
+        void execute_depth_prepass(const std::vector<RenderCommand> &commands, const glm::mat4 &view,
+                                   const glm::mat4 &projection);
+
         // Draw methods
-        void draw_render_command(const RenderCommand &cmd, const glm::mat4 &view, const glm::mat4 &projection);
+        void submit_sorted_commands(const std::vector<RenderCommand> &commands, const glm::mat4 &view,
+                                    const glm::mat4 &projection);
+
+        /// Count a draw in render_stats_, index_count per instance
+        void count_draw(uint32_t index_count, uint32_t instances, bool instanced);
+
+        /// Count a glMultiDrawElementsIndirect call over a range of indirect_commands_
+        void count_multi_draw(uint32_t first_indirect_command, uint32_t indirect_command_count);
+
+        /// shader_override replaces the color pass shader, e.g. with a pass variant
+        void draw_render_command(const RenderCommand &cmd, const glm::mat4 &view, const glm::mat4 &projection,
+                                 Shader *shader_override = nullptr);
 
         void draw_instanced_command(const InstancedRenderCommand &cmd, const glm::mat4 &view,
-                                    const glm::mat4 &projection);
+                                    const glm::mat4 &projection, Shader *shader_override = nullptr);
     };
 }
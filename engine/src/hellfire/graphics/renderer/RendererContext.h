@@ -4,6 +4,9 @@
 #pragma once
 
 #include <cstdint>
+#include <vector>
+
+#include "FrameData.h"
 
 // Forward declarations
 namespace hellfire {
@@ -17,8 +20,8 @@ namespace hellfire {
         uint32_t shader_handle;
     
         // Entity pointers for lights
-        Entity* directional_light_entities[4];  // MAX_DIRECTIONAL_LIGHTS = 4
-        Entity* point_light_entities[8];        // MAX_POINT_LIGHTS = 8
+        Entity* directional_light_entities[MAX_DIRECTIONAL_LIGHTS];
+        std::vector<Entity*> point_light_entities; // Unbounded, the built-in shaders read them through light clusters
         int num_directional_lights = 0;
         int num_point_lights = 0;
     
@@ -26,8 +29,7 @@ namespace hellfire {
     
         // Constructor to initialize arrays
         OGLRendererContext() : shader_handle(0) {
-            for (int i = 0; i < 4; i++) directional_light_entities[i] = nullptr;
-            for (int i = 0; i < 8; i++) point_light_entities[i] = nullptr;
+            for (int i = 0; i < MAX_DIRECTIONAL_LIGHTS; i++) directional_light_entities[i] = nullptr;
         }
     };
 }
\ No newline at end of file
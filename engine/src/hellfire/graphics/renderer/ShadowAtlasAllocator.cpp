@@ -0,0 +1,110 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include "ShadowAtlasAllocator.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace hellfire {
+    ShadowAtlasAllocator::ShadowAtlasAllocator(const uint32_t atlas_size, const uint32_t min_tile_size)
+        : min_tile_size_(std::bit_ceil(std::max(min_tile_size, 1u))) {
+        reset(atlas_size);
+    }
+
+    void ShadowAtlasAllocator::reset(const uint32_t atlas_size) {
+        atlas_size_ = atlas_size;
+        used_texels_ = 0;
+        free_tiles_.clear();
+        if (atlas_size_ < min_tile_size_) return;
+
+        free_tiles_.resize(get_level(min_tile_size_) + 1);
+        free_tiles_[0].push_back({0, 0});
+    }
+
+    ShadowAtlasTile ShadowAtlasAllocator::allocate(const uint32_t size) {
+        if (size == 0 || size > atlas_size_ || free_tiles_.empty()) return {};
+
+        const uint32_t level = get_level(std::max(std::bit_ceil(size), min_tile_size_));
+
+        // Smallest free tile that is large enough
+        int source = static_cast<int>(level);
+        while (source >= 0 && free_tiles_[source].empty()) {
+            source--;
+        }
+        if (source < 0) return {};
+
+        Position position = free_tiles_[source].back();
+        free_tiles_[source].pop_back();
+
+        // Split down, keeping the top-left child and freeing the other three
+        for (uint32_t split = source + 1; split <= level; split++) {
+            const uint32_t child_size = get_level_size(split);
+            free_tiles_[split].push_back({position.x + child_size, position.y});
+            free_tiles_[split].push_back({position.x, position.y + child_size});
+            free_tiles_[split].push_back({position.x + child_size, position.y + child_size});
+        }
+
+        const uint32_t tile_size = get_level_size(level);
+        used_texels_ += static_cast<uint64_t>(tile_size) * tile_size;
+        return {position.x, position.y, tile_size};
+    }
+
+    void ShadowAtlasAllocator::free(const ShadowAtlasTile &tile) {
+        if (!tile.is_valid() || free_tiles_.empty()) return;
+
+        used_texels_ -= static_cast<uint64_t>(tile.size) * tile.size;
+
+        uint32_t level = get_level(tile.size);
+        Position position{tile.x, tile.y};
+
+        // Merge with the three siblings as long as all of them are free
+        while (level > 0) {
+            const uint32_t parent_size = get_level_size(level - 1);
+            const uint32_t child_size = get_level_size(level);
+            const uint32_t parent_x = position.x / parent_size * parent_size;
+            const uint32_t parent_y = position.y / parent_size * parent_size;
+
+            const Position siblings[4] = {
+                {parent_x, parent_y}, {parent_x + child_size, parent_y},
+                {parent_x, parent_y + child_size}, {parent_x + child_size, parent_y + child_size}
+            };
+
+            auto &free_list = free_tiles_[level];
+            bool all_free = true;
+            for (const Position &sibling: siblings) {
+                if (sibling.x == position.x && sibling.y == position.y) continue;
+                const bool is_free = std::ranges::any_of(free_list, [&](const Position &p) {
+                    return p.x == sibling.x && p.y == sibling.y;
+                });
+                if (!is_free) {
+                    all_free = false;
+                    break;
+                }
+            }
+            if (!all_free) break;
+
+            for (const Position &sibling: siblings) {
+                if (sibling.x != position.x || sibling.y != position.y) take_free(level, sibling.x, sibling.y);
+            }
+            position = {parent_x, parent_y};
+            level--;
+        }
+
+        free_tiles_[level].push_back(position);
+    }
+
+    uint32_t ShadowAtlasAllocator::get_level(const uint32_t size) const {
+        return static_cast<uint32_t>(std::countr_zero(atlas_size_) - std::countr_zero(size));
+    }
+
+    bool ShadowAtlasAllocator::take_free(const uint32_t level, const uint32_t x, const uint32_t y) {
+        auto &free_list = free_tiles_[level];
+        const auto it = std::ranges::find_if(free_list, [&](const Position &p) { return p.x == x && p.y == y; });
+        if (it == free_list.end()) return false;
+
+        *it = free_list.back();
+        free_list.pop_back();
+        return true;
+    }
+}
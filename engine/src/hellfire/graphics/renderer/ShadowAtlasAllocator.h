@@ -0,0 +1,58 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace hellfire {
+    /// Square region of the shadow atlas, in texels
+    struct ShadowAtlasTile {
+        uint32_t x = 0;
+        uint32_t y = 0;
+        uint32_t size = 0; // 0: no tile
+
+        bool is_valid() const { return size != 0; }
+    };
+
+    /**
+     * @brief Quadtree allocator for power of two tiles of a square shadow atlas.
+     *
+     * A tile is split into four children when a smaller one is needed, and the four are merged
+     * back once all of them are free, so tiles of different sizes can be recycled indefinitely.
+     * Only tracks positions, the caller owns the texture.
+     */
+    class ShadowAtlasAllocator {
+    public:
+        explicit ShadowAtlasAllocator(uint32_t atlas_size = 0, uint32_t min_tile_size = 128);
+
+        /// Drop every allocation and start over with the given size (a power of two)
+        void reset(uint32_t atlas_size);
+
+        /// @return A tile of size rounded up to a power of two, or an invalid tile when none is free
+        ShadowAtlasTile allocate(uint32_t size);
+
+        void free(const ShadowAtlasTile &tile);
+
+        uint32_t get_atlas_size() const { return atlas_size_; }
+        uint32_t get_min_tile_size() const { return min_tile_size_; }
+        uint64_t get_used_texels() const { return used_texels_; }
+
+    private:
+        struct Position {
+            uint32_t x;
+            uint32_t y;
+        };
+
+        uint32_t atlas_size_ = 0;
+        uint32_t min_tile_size_ = 0;
+        uint64_t used_texels_ = 0;
+        std::vector<std::vector<Position> > free_tiles_; // Per level, level 0 is the whole atlas
+
+        uint32_t get_level(uint32_t size) const;
+        uint32_t get_level_size(uint32_t level) const { return atlas_size_ >> level; }
+
+        bool take_free(uint32_t level, uint32_t x, uint32_t y);
+    };
+}
@@ -0,0 +1,88 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include "ShadowCascades.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace hellfire {
+    void ShadowCascades::compute_splits(const float near_plane, const float far_plane, const int cascade_count,
+                                        const float lambda, float *out_splits) {
+        const float ratio = far_plane / near_plane;
+        for (int i = 1; i <= cascade_count; i++) {
+            const float fraction = static_cast<float>(i) / static_cast<float>(cascade_count);
+            const float log_split = near_plane * std::pow(ratio, fraction);
+            const float uniform_split = near_plane + (far_plane - near_plane) * fraction;
+            out_splits[i - 1] = lambda * log_split + (1.0f - lambda) * uniform_split;
+        }
+        // Avoid a gap at the end from rounding
+        out_splits[cascade_count - 1] = far_plane;
+    }
+
+    ShadowCascade ShadowCascades::fit(const glm::mat4 &camera_view_projection, const float near_plane,
+                                      const float far_plane, const float split_near, const float split_far,
+                                      const glm::vec3 &light_direction, const uint32_t resolution,
+                                      const float caster_depth) {
+        // Frustum corners in world space, near plane first
+        const glm::mat4 inverse_view_projection = glm::inverse(camera_view_projection);
+        glm::vec3 corners[8];
+        for (int i = 0; i < 8; i++) {
+            const glm::vec4 ndc((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f, 1.0f);
+            const glm::vec4 world = inverse_view_projection * ndc;
+            corners[i] = glm::vec3(world) / world.w;
+        }
+
+        // Corner rays are linear in view depth, so the slice corners are a lerp along them
+        const float depth_range = far_plane - near_plane;
+        const float t_near = (split_near - near_plane) / depth_range;
+        const float t_far = (split_far - near_plane) / depth_range;
+
+        glm::vec3 slice[8];
+        glm::vec3 center(0.0f);
+        for (int i = 0; i < 4; i++) {
+            const glm::vec3 ray = corners[i + 4] - corners[i];
+            slice[i] = corners[i] + ray * t_near;
+            slice[i + 4] = corners[i] + ray * t_far;
+            center += slice[i] + slice[i + 4];
+        }
+        center /= 8.0f;
+
+        float radius = 0.0f;
+        for (const glm::vec3 &corner: slice) {
+            radius = std::max(radius, glm::length(corner - center));
+        }
+        // Quantize so float noise doesn't change the box size from frame to frame
+        radius = std::ceil(radius * 16.0f) / 16.0f;
+
+        const glm::vec3 light_dir = glm::normalize(light_direction);
+        glm::vec3 up(0.0f, 1.0f, 0.0f);
+        if (glm::abs(glm::dot(light_dir, up)) > 0.99f) {
+            up = glm::vec3(1.0f, 0.0f, 0.0f);
+        }
+
+        // The light view sits at the world origin, so it only depends on the light's direction. The
+        // center is snapped to whole texels in light space and the box is built around it: the matrix
+        // then only changes in texel steps while the camera moves, and the texel grid stays put
+        const glm::mat4 light_view = glm::lookAt(glm::vec3(0.0f), light_dir, up);
+        const float texel_size = 2.0f * radius / static_cast<float>(std::max(resolution, 1u));
+        const glm::vec3 light_center = glm::vec3(light_view * glm::vec4(center, 1.0f));
+        const glm::ivec3 texel_offset = glm::ivec3(glm::round(light_center / texel_size));
+        const glm::vec3 snapped = glm::vec3(texel_offset) * texel_size;
+
+        // Light space looks down -z, the casters in front of the slice are towards +z
+        const glm::mat4 light_projection = glm::ortho(snapped.x - radius, snapped.x + radius,
+                                                      snapped.y - radius, snapped.y + radius,
+                                                      -(snapped.z + radius + caster_depth), -(snapped.z - radius));
+
+        ShadowCascade cascade;
+        cascade.view_projection = light_projection * light_view;
+        cascade.texel_offset = texel_offset;
+        cascade.split_near = split_near;
+        cascade.split_far = split_far;
+        cascade.radius = radius;
+        return cascade;
+    }
+}
@@ -0,0 +1,51 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#pragma once
+
+#include <cstdint>
+
+#include "FrameData.h"
+#include "glm/glm.hpp"
+
+namespace hellfire {
+    /// One slice of a directional light's shadow, covering [split_near, split_far] of the camera view depth
+    struct ShadowCascade {
+        glm::mat4 view_projection = glm::mat4(1.0f); // Light space, snapped to whole texels
+        glm::vec4 tile = glm::vec4(0.0f); // UV rect (x, y, width, height) inside the shadow atlas
+        float split_near = 0.0f;
+        float split_far = 0.0f;
+        float radius = 0.0f; // Of the bounding sphere, half the width of the orthographic box
+        // Light space center of the box in whole texels. With the light direction, radius and resolution
+        // it fully determines view_projection, which stays the same as long as these do
+        glm::ivec3 texel_offset = glm::ivec3(0);
+    };
+
+    /**
+     * @brief Cascade fitting for directional light shadow maps.
+     *
+     * Splits use the practical split scheme, a blend of logarithmic and uniform distribution.
+     * Each cascade is fit to the bounding sphere of its frustum slice, so its size doesn't change
+     * when the camera rotates. The light view is anchored at the world origin and the box center is
+     * snapped to whole texels in light space, so shadow edges don't crawl when the camera moves.
+     */
+    class ShadowCascades {
+    public:
+        /**
+         * @brief Far distance of every cascade, the last one is far_plane
+         * @param lambda 0 gives uniform splits, 1 logarithmic ones
+         */
+        static void compute_splits(float near_plane, float far_plane, int cascade_count, float lambda,
+                                   float *out_splits);
+
+        /**
+         * @brief Fit a cascade to a slice of the camera frustum
+         * @param camera_view_projection Camera matrix whose near/far planes are near_plane and far_plane
+         * @param resolution Texels along one side of the cascade's tile
+         * @param caster_depth Extra distance towards the light, so casters outside the slice still shadow it
+         */
+        static ShadowCascade fit(const glm::mat4 &camera_view_projection, float near_plane, float far_plane,
+                                 float split_near, float split_far, const glm::vec3 &light_direction,
+                                 uint32_t resolution, float caster_depth);
+    };
+}
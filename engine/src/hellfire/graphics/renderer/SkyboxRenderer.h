@@ -6,6 +6,7 @@
 #include <cstdint>
 
 #include "hellfire/ecs/CameraComponent.h"
+#include "hellfire/graphics/shader/Shader.h"
 
 namespace hellfire {
     class Skybox;
@@ -25,7 +26,8 @@ namespace hellfire {
         void setup_skybox_geometry();
         void load_skybox_shader();
         
-        uint32_t skybox_shader_ = 0;
+        uint32_t skybox_program_ = 0;
+        Shader skybox_shader_; // Over the ShaderManager's uniform table of skybox_program_
         uint32_t skybox_vao_ = 0;
         uint32_t skybox_vbo_ = 0;
 
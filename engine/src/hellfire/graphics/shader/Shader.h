@@ -1,15 +1,27 @@
 #pragma once
+#include <array>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <GL/glew.h>
 #include <glm/gtc/type_ptr.hpp>
 
 #include "ShaderUniformBinder.h"
+#include "hellfire/graphics/backends/opengl/GLStateCache.h"
 #include "hellfire/graphics/managers/ShaderManager.h"
 
 class Shader {
 public:
+    // Standalone wrapper: reflects and owns its own uniform table
     explicit Shader(const uint32_t program_id) : program_id_(program_id) {
+        if (program_id_ != 0) {
+            owned_uniforms_ = std::make_unique<hellfire::UniformTable>(program_id_);
+            uniforms_ = owned_uniforms_.get();
+        }
+    }
+
+    // Wrapper over a table owned by the ShaderManager
+    Shader(const uint32_t program_id, hellfire::UniformTable *uniforms) : program_id_(program_id), uniforms_(uniforms) {
     }
 
     Shader() : program_id_(0) {
@@ -19,14 +31,19 @@ public:
     Shader(const Shader &) = delete;
     Shader &operator=(const Shader &) = delete;
 
-    Shader(Shader &&other) noexcept : program_id_(other.program_id_) {
+    Shader(Shader &&other) noexcept : program_id_(other.program_id_), uniforms_(other.uniforms_),
+                                      owned_uniforms_(std::move(other.owned_uniforms_)) {
         other.program_id_ = 0;
+        other.uniforms_ = nullptr;
     }
 
     Shader &operator=(Shader &&other) noexcept {
         if (this != &other) {
             program_id_ = other.program_id_;
+            uniforms_ = other.uniforms_;
+            owned_uniforms_ = std::move(other.owned_uniforms_);
             other.program_id_ = 0;
+            other.uniforms_ = nullptr;
         }
         return *this;
     }
@@ -38,135 +55,199 @@ public:
     // Core Methods
     void use() const {
         if (program_id_ != 0) {
-            glUseProgram(program_id_);
+            hellfire::GLStateCache::use_program(program_id_);
         }
     }
 
     uint32_t get_program_id() const { return program_id_; }
     bool is_valid() const { return program_id_ != 0; }
+    hellfire::UniformTable *get_uniform_table() const { return uniforms_; }
 
     // === UNIFORM SETTERS ===
-    void set_bool(const std::string &name, const bool value) const {
-        get_binder().set_bool(name, value);
+    // Every setter accepts either a uniform name or an interned hellfire::UniformID.
+    template<typename Key>
+    void set_bool(const Key &name, const bool value) const {
+        if (uniforms_) get_binder().set_bool(name, value);
     }
 
-    void set_int(const std::string &name, const int value) const {
-        get_binder().set_int(name, value);
+    template<typename Key>
+    void set_int(const Key &name, const int value) const {
+        if (uniforms_) get_binder().set_int(name, value);
     }
 
-    void set_uint(const std::string &name, const uint32_t value) const {
-        get_binder().set_uint(name, value);
+    template<typename Key>
+    void set_uint(const Key &name, const uint32_t value) const {
+        if (uniforms_) get_binder().set_uint(name, value);
     }
 
-    void set_float(const std::string &name, const float value) const {
-        get_binder().set_float(name, value);
+    template<typename Key>
+    void set_float(const Key &name, const float value) const {
+        if (uniforms_) get_binder().set_float(name, value);
     }
 
     // Vectors
-    void set_vec2(const std::string &name, const glm::vec2 &value) const {
-        get_binder().set_vec2(name, value);
+    template<typename Key>
+    void set_vec2(const Key &name, const glm::vec2 &value) const {
+        if (uniforms_) get_binder().set_vec2(name, value);
     }
 
-    void set_vec2(const std::string &name, const float x, const float y) const {
-        get_binder().set_vec2(name, glm::vec2(x, y));
+    template<typename Key>
+    void set_vec2(const Key &name, const float x, const float y) const {
+        set_vec2(name, glm::vec2(x, y));
     }
 
-    void set_vec3(const std::string &name, const glm::vec3 &value) const {
-        get_binder().set_vec3(name, value);
+    template<typename Key>
+    void set_vec3(const Key &name, const glm::vec3 &value) const {
+        if (uniforms_) get_binder().set_vec3(name, value);
     }
 
-    void set_vec3(const std::string &name, const float x, const float y, const float z) const {
-        get_binder().set_vec3(name, glm::vec3(x, y, z));
+    template<typename Key>
+    void set_vec3(const Key &name, const float x, const float y, const float z) const {
+        set_vec3(name, glm::vec3(x, y, z));
     }
 
-    void set_vec4(const std::string &name, const glm::vec4 &value) const {
-        get_binder().set_vec4(name, value);
+    template<typename Key>
+    void set_vec4(const Key &name, const glm::vec4 &value) const {
+        if (uniforms_) get_binder().set_vec4(name, value);
     }
 
-    void set_vec4(const std::string &name, float x, float y, float z, float w) const {
-        get_binder().set_vec4(name, glm::vec4(x, y, z, w));
+    template<typename Key>
+    void set_vec4(const Key &name, float x, float y, float z, float w) const {
+        set_vec4(name, glm::vec4(x, y, z, w));
     }
 
     // Matrices
-    void set_mat2(const std::string &name, const glm::mat2 &value) const {
-        get_binder().set_mat2(name, value);
+    template<typename Key>
+    void set_mat2(const Key &name, const glm::mat2 &value) const {
+        if (uniforms_) get_binder().set_mat2(name, value);
     }
 
-    void set_mat3(const std::string &name, const glm::mat3 &value) const {
-        get_binder().set_mat3(name, value);
+    template<typename Key>
+    void set_mat3(const Key &name, const glm::mat3 &value) const {
+        if (uniforms_) get_binder().set_mat3(name, value);
     }
 
-    void set_mat4(const std::string &name, const glm::mat4 &value) const {
-        get_binder().set_mat4(name, value);
+    template<typename Key>
+    void set_mat4(const Key &name, const glm::mat4 &value) const {
+        if (uniforms_) get_binder().set_mat4(name, value);
     }
 
     // CONVENIENCE METHODS FOR COMMON GRAPHICS UNIFORMS 
     void set_transform_matrices(const glm::mat4 &model, const glm::mat4 &view, const glm::mat4 &projection) const {
+        static const hellfire::UniformID model_id = hellfire::UniformTable::intern("model");
+        static const hellfire::UniformID view_id = hellfire::UniformTable::intern("view");
+        static const hellfire::UniformID projection_id = hellfire::UniformTable::intern("projection");
+        static const hellfire::UniformID mvp_id = hellfire::UniformTable::intern("MVP");
+        static const hellfire::UniformID normal_matrix_id = hellfire::UniformTable::intern("normalMatrix");
+        if (!uniforms_) return;
+
         const auto binder = get_binder();
-        binder.set_mat4("model", model);
-        binder.set_mat4("view", view);
-        binder.set_mat4("projection", projection);
-        binder.set_mat4("MVP", projection * view * model);
+        binder.set_mat4(model_id, model);
+        binder.set_mat4(view_id, view);
+        binder.set_mat4(projection_id, projection);
+        if (binder.has_uniform(mvp_id)) {
+            binder.set_mat4(mvp_id, projection * view * model);
+        }
 
-        // Calculate and set normal matrix
-        glm::mat3 normal_matrix = glm::transpose(glm::inverse(glm::mat3(model)));
-        binder.set_mat3("normalMatrix", normal_matrix);
+        // Calculate and set normal matrix, only if the program actually uses it
+        if (binder.has_uniform(normal_matrix_id)) {
+            glm::mat3 normal_matrix = glm::transpose(glm::inverse(glm::mat3(model)));
+            binder.set_mat3(normal_matrix_id, normal_matrix);
+        }
     }
 
     void set_view_projection(const glm::mat4 &view, const glm::mat4 &projection) const {
+        static const hellfire::UniformID view_id = hellfire::UniformTable::intern("view");
+        static const hellfire::UniformID projection_id = hellfire::UniformTable::intern("projection");
+        if (!uniforms_) return;
+
         const auto binder = get_binder();
-        binder.set_mat4("view", view);
-        binder.set_mat4("projection", projection);
+        binder.set_mat4(view_id, view);
+        binder.set_mat4(projection_id, projection);
     }
 
     void set_camera_position(const glm::vec3 &position) const {
-        get_binder().set_vec3("viewPos", position);
+        static const hellfire::UniformID view_pos_id = hellfire::UniformTable::intern("viewPos");
+        set_vec3(view_pos_id, position);
     }
 
     void set_time(const float time) const {
-        get_binder().set_float("time", time);
+        static const hellfire::UniformID time_id = hellfire::UniformTable::intern("time");
+        set_float(time_id, time);
     }
 
     void set_light_counts(const int directional_lights, const int point_lights) const {
+        static const hellfire::UniformID directional_count_id = hellfire::UniformTable::intern("numDirectionalLights");
+        static const hellfire::UniformID point_count_id = hellfire::UniformTable::intern("numPointLights");
+        if (!uniforms_) return;
+
         const auto binder = get_binder();
-        binder.set_int("numDirectionalLights", directional_lights);
-        binder.set_int("numPointLights", point_lights);
+        binder.set_int(directional_count_id, directional_lights);
+        binder.set_int(point_count_id, point_lights);
     }
 
     // Array setters for lights
     void set_directional_light(const int index, const glm::vec3 &direction, const glm::vec3 &color, const float intensity = 1.0f) const {
-        std::string base = "directionalLights[" + std::to_string(index) + "]";
+        if (!uniforms_ || index < 0 || index >= MAX_LIGHT_UNIFORMS) return;
+        static const auto ids = make_light_ids("directionalLights");
+
         const auto binder = get_binder();
-        binder.set_vec3(base + ".direction", direction);
-        binder.set_vec3(base + ".color", color);
-        binder.set_float(base + ".intensity", intensity);
+        binder.set_vec3(ids[index].direction, direction);
+        binder.set_vec3(ids[index].color, color);
+        binder.set_float(ids[index].intensity, intensity);
     }
 
     void set_point_light(const int index, const glm::vec3 &position, const glm::vec3 &color,
                          const float constant = 1.0f, const float linear = 0.09f, const float quadratic = 0.032f) const {
-        std::string base = "pointLights[" + std::to_string(index) + "]";
+        if (!uniforms_ || index < 0 || index >= MAX_LIGHT_UNIFORMS) return;
+        static const auto ids = make_light_ids("pointLights");
+
         const auto binder = get_binder();
-        binder.set_vec3(base + ".position", position);
-        binder.set_vec3(base + ".color", color);
-        binder.set_float(base + ".intensity", constant);
-        binder.set_float(base + ".range", linear);
-        binder.set_float(base + ".attenuation", quadratic);
+        binder.set_vec3(ids[index].position, position);
+        binder.set_vec3(ids[index].color, color);
+        binder.set_float(ids[index].intensity, constant);
+        binder.set_float(ids[index].range, linear);
+        binder.set_float(ids[index].attenuation, quadratic);
     }
 
     // Texture binding
-    void set_texture(const std::string &name, const int texture_unit) const {
-        get_binder().set_int(name, texture_unit);
+    template<typename Key>
+    void set_texture(const Key &name, const int texture_unit) const {
+        set_int(name, texture_unit);
     }
 
     // Check if uniform exists
-    bool has_uniform(const std::string &name) const {
-        return get_binder().has_uniform(name);
+    template<typename Key>
+    bool has_uniform(const Key &name) const {
+        return uniforms_ && get_binder().has_uniform(name);
     }
 
 private:
+    static constexpr int MAX_LIGHT_UNIFORMS = 8;
+
+    struct LightUniformIds {
+        hellfire::UniformID direction, position, color, intensity, range, attenuation;
+    };
+
     uint32_t program_id_;
+    hellfire::UniformTable *uniforms_ = nullptr;
+    std::unique_ptr<hellfire::UniformTable> owned_uniforms_;
 
     hellfire::ShaderUniformBinder get_binder() const {
-        return hellfire::ShaderUniformBinder(program_id_);
+        return hellfire::ShaderUniformBinder(*uniforms_);
+    }
+
+    static std::array<LightUniformIds, MAX_LIGHT_UNIFORMS> make_light_ids(const std::string &array_name) {
+        std::array<LightUniformIds, MAX_LIGHT_UNIFORMS> ids{};
+        for (int i = 0; i < MAX_LIGHT_UNIFORMS; i++) {
+            const std::string base = array_name + "[" + std::to_string(i) + "]";
+            ids[i].direction = hellfire::UniformTable::intern(base + ".direction");
+            ids[i].position = hellfire::UniformTable::intern(base + ".position");
+            ids[i].color = hellfire::UniformTable::intern(base + ".color");
+            ids[i].intensity = hellfire::UniformTable::intern(base + ".intensity");
+            ids[i].range = hellfire::UniformTable::intern(base + ".range");
+            ids[i].attenuation = hellfire::UniformTable::intern(base + ".attenuation");
+        }
+        return ids;
     }
 };
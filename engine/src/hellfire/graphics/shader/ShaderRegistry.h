@@ -26,7 +26,7 @@ namespace hellfire {
             }
 
             // Create wrapper and cache it
-            auto shader_wrapper = std::make_unique<Shader>(program_id);
+            auto shader_wrapper = std::make_unique<Shader>(program_id, shader_manager_->get_uniform_table(program_id));
             Shader* ptr = shader_wrapper.get();
             shader_wrappers_[name] = std::move(shader_wrapper);
             return ptr;
@@ -42,7 +42,7 @@ namespace hellfire {
             }
 
             // Create a new wrapper for this ID
-            auto shader_wrapper = std::make_unique<Shader>(program_id);
+            auto shader_wrapper = std::make_unique<Shader>(program_id, shader_manager_->get_uniform_table(program_id));
             Shader* ptr = shader_wrapper.get();
         
             // Cache it with a generated key (since we don't know the original name)
@@ -62,7 +62,7 @@ namespace hellfire {
                 return nullptr;
             }
 
-            auto shader_wrapper = std::make_unique<Shader>(program_id);
+            auto shader_wrapper = std::make_unique<Shader>(program_id, shader_manager_->get_uniform_table(program_id));
             Shader* ptr = shader_wrapper.get();
             shader_wrappers_[key] = std::move(shader_wrapper);
             return ptr;
@@ -78,8 +78,11 @@ namespace hellfire {
 
         void clear() {
             shader_wrappers_.clear();
+            id_to_shader_map_.clear();
         }
 
+        ShaderManager* get_shader_manager() const { return shader_manager_; }
+
         
     private:
         ShaderManager* shader_manager_;
@@ -4,116 +4,123 @@
 
 #pragma once
 #include <cstdint>
-#include <string>
-#include <unordered_map>
+#include <string_view>
 
 #include "GL/glew.h"
 #include "glm/detail/type_vec.hpp"
 #include "glm/gtc/type_ptr.hpp"
+#include "UniformTable.h"
 
 namespace hellfire {
     /**
      * Abstraction layer for shader uniform binding
-     * Hides OpenGL implementation details and provides uniform caching
+     * Hides OpenGL implementation details and routes every upload through the program's
+     * persistent UniformTable, so locations are never queried and unchanged values are skipped.
+     * Binders are cheap views and can be created per call.
      */
     class ShaderUniformBinder {
     public:
-        explicit ShaderUniformBinder(const uint32_t shader_program) 
-            : shader_program_(shader_program) {}
+        explicit ShaderUniformBinder(UniformTable &table)
+            : table_(table) {}
 
         // Scalar Types 
-        void set_bool(const std::string& name, const bool value) const {
-            if (const GLint location = get_uniform_location(name); location != -1) {
-                glUniform1i(location, value ? 1 : 0);
-            }
+        template<typename Key>
+        void set_bool(const Key& name, const bool value) const {
+            set_int(name, value ? 1 : 0);
         }
 
-        void set_int(const std::string& name, const int value) const {
-            if (const GLint location = get_uniform_location(name); location != -1) {
+        template<typename Key>
+        void set_int(const Key& name, const int value) const {
+            if (const GLint location = get_uniform_location(name); location != -1 && table_.should_upload(location, value)) {
                 glUniform1i(location, value);
             }
         }
 
-        void set_uint(const std::string& name, const uint32_t value) const {
-            if (const GLint location = get_uniform_location(name); location != -1) {
+        template<typename Key>
+        void set_uint(const Key& name, const uint32_t value) const {
+            if (const GLint location = get_uniform_location(name); location != -1 && table_.should_upload(location, value)) {
                 glUniform1ui(location, value);
             }
         }
 
-        void set_float(const std::string& name, const float value) const {
-            if (const GLint location = get_uniform_location(name); location != -1) {
+        template<typename Key>
+        void set_float(const Key& name, const float value) const {
+            if (const GLint location = get_uniform_location(name); location != -1 && table_.should_upload(location, value)) {
                 glUniform1f(location, value);
             }
         }
 
         // Vector Types 
-        void set_vec2(const std::string& name, const glm::vec2& value) const {
-            if (const GLint location = get_uniform_location(name); location != -1) {
+        template<typename Key>
+        void set_vec2(const Key& name, const glm::vec2& value) const {
+            if (const GLint location = get_uniform_location(name); location != -1 && table_.should_upload(location, value)) {
                 glUniform2fv(location, 1, glm::value_ptr(value));
             }
         }
 
-        void set_vec3(const std::string& name, const glm::vec3& value) const {
-            if (const GLint location = get_uniform_location(name); location != -1) {
+        template<typename Key>
+        void set_vec3(const Key& name, const glm::vec3& value) const {
+            if (const GLint location = get_uniform_location(name); location != -1 && table_.should_upload(location, value)) {
                 glUniform3fv(location, 1, glm::value_ptr(value));
             }
         }
 
-        void set_vec4(const std::string& name, const glm::vec4& value) const {
-            if (const GLint location = get_uniform_location(name); location != -1) {
+        template<typename Key>
+        void set_vec4(const Key& name, const glm::vec4& value) const {
+            if (const GLint location = get_uniform_location(name); location != -1 && table_.should_upload(location, value)) {
                 glUniform4fv(location, 1, glm::value_ptr(value));
             }
         }
 
         // Matrix Types
-        void set_mat2(const std::string& name, const glm::mat2& value) const {
-            if (const GLint location = get_uniform_location(name); location != -1) {
+        template<typename Key>
+        void set_mat2(const Key& name, const glm::mat2& value) const {
+            if (const GLint location = get_uniform_location(name); location != -1 && table_.should_upload(location, value)) {
                 glUniformMatrix2fv(location, 1, GL_FALSE, glm::value_ptr(value));
             }
         }
         
-        void set_mat3(const std::string& name, const glm::mat3& value) const {
-            if (const GLint location = get_uniform_location(name); location != -1) {
+        template<typename Key>
+        void set_mat3(const Key& name, const glm::mat3& value) const {
+            if (const GLint location = get_uniform_location(name); location != -1 && table_.should_upload(location, value)) {
                 glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(value));
             }
         }
 
-        void set_mat4(const std::string& name, const glm::mat4& value) const {
-            if (const GLint location = get_uniform_location(name); location != -1) {
+        template<typename Key>
+        void set_mat4(const Key& name, const glm::mat4& value) const {
+            if (const GLint location = get_uniform_location(name); location != -1 && table_.should_upload(location, value)) {
                 glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
             }
         }
 
         // Utility Methods 
-        bool has_uniform(const std::string& name) const {
+        template<typename Key>
+        bool has_uniform(const Key& name) const {
             return get_uniform_location(name) != -1;
         }
 
         void clear_cache() {
-            uniform_cache_.clear();
+            table_.invalidate_values();
         }
 
         uint32_t get_shader_program() const {
-            return shader_program_;
+            return table_.get_program_id();
         }
 
-    private:
-        uint32_t shader_program_;
-        mutable std::unordered_map<std::string, GLint> uniform_cache_;
+        UniformTable &get_table() const {
+            return table_;
+        }
 
-        GLint get_uniform_location(const std::string& name) const {
-            if (shader_program_ == 0) return -1;
+    private:
+        UniformTable &table_;
 
-            // Check cache first
-            if (const auto it = uniform_cache_.find(name); it != uniform_cache_.end()) {
-                return it->second;
-            }
+        GLint get_uniform_location(const UniformID id) const {
+            return table_.get_location(id);
+        }
 
-            // Get location and cache it
-            const GLint location = glGetUniformLocation(shader_program_, name.c_str());
-            uniform_cache_[name] = location;
-            
-            return location;
+        GLint get_uniform_location(const std::string_view name) const {
+            return table_.get_location(name);
         }
     };
 }
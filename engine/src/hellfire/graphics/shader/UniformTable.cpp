@@ -0,0 +1,132 @@
+//
+// Created by denzel on 17/10/2026.
+//
+
+#include "hellfire/graphics/shader/UniformTable.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace hellfire {
+    namespace {
+        struct UniformNameRegistry {
+            std::mutex mutex;
+            std::unordered_map<std::string, UniformID> ids;
+            std::vector<std::string> names;
+        };
+
+        UniformNameRegistry &name_registry() {
+            static UniformNameRegistry registry;
+            return registry;
+        }
+    }
+
+    UniformTable::UniformTable(const uint32_t program_id) : program_id_(program_id) {
+        reflect();
+    }
+
+    UniformID UniformTable::intern(const std::string_view name) {
+        auto &registry = name_registry();
+        std::lock_guard lock(registry.mutex);
+
+        std::string key(name);
+        if (const auto it = registry.ids.find(key); it != registry.ids.end()) {
+            return it->second;
+        }
+
+        const auto id = static_cast<UniformID>(registry.names.size());
+        registry.names.push_back(key);
+        registry.ids.emplace(std::move(key), id);
+        return id;
+    }
+
+    const std::string &UniformTable::get_name(const UniformID id) {
+        auto &registry = name_registry();
+        std::lock_guard lock(registry.mutex);
+
+        static const std::string empty;
+        return id < registry.names.size() ? registry.names[id] : empty;
+    }
+
+    void UniformTable::reflect() {
+        slots_.clear();
+        name_to_location_.clear();
+        location_to_slot_.clear();
+        id_to_location_.clear();
+
+        if (program_id_ == 0) return;
+
+        GLint uniform_count = 0;
+        GLint max_name_length = 0;
+        glGetProgramInterfaceiv(program_id_, GL_UNIFORM, GL_ACTIVE_RESOURCES, &uniform_count);
+        glGetProgramInterfaceiv(program_id_, GL_UNIFORM, GL_MAX_NAME_LENGTH, &max_name_length);
+
+        constexpr GLenum properties[] = {GL_LOCATION, GL_TYPE, GL_ARRAY_SIZE, GL_BLOCK_INDEX};
+        std::string name_buffer(std::max(max_name_length, 1), '\0');
+
+        for (GLint i = 0; i < uniform_count; i++) {
+            GLint values[4] = {};
+            glGetProgramResourceiv(program_id_, GL_UNIFORM, i, 4, properties, 4, nullptr, values);
+
+            const GLint location = values[0];
+            const auto type = static_cast<GLenum>(values[1]);
+            const GLint array_size = values[2];
+
+            // Members of uniform blocks have no location and are not set through glUniform*
+            if (values[3] != -1 || location < 0) continue;
+
+            GLsizei length = 0;
+            glGetProgramResourceName(program_id_, GL_UNIFORM, i, max_name_length, &length, name_buffer.data());
+            std::string name(name_buffer.data(), length);
+
+            // Arrays of basic types are reported once as "name[0]", expand every element
+            if (const size_t bracket = name.rfind("[0]");
+                bracket != std::string::npos && bracket + 3 == name.size()) {
+                const std::string base = name.substr(0, bracket);
+                name_to_location_.emplace(base, location);
+                for (GLint element = 0; element < array_size; element++) {
+                    add_uniform(base + "[" + std::to_string(element) + "]", location + element, type);
+                }
+            } else {
+                add_uniform(name, location, type);
+            }
+        }
+    }
+
+    void UniformTable::invalidate_values() {
+        for (auto &slot: slots_) {
+            slot.has_value = false;
+        }
+    }
+
+    GLint UniformTable::get_location(const UniformID id) {
+        if (id >= id_to_location_.size()) {
+            id_to_location_.resize(id + 1, UNRESOLVED);
+        }
+
+        int32_t &location = id_to_location_[id];
+        if (location == UNRESOLVED) {
+            location = get_location(get_name(id));
+        }
+        return location;
+    }
+
+    GLint UniformTable::get_location(const std::string_view name) const {
+        const auto it = name_to_location_.find(name);
+        return it != name_to_location_.end() ? it->second : INVALID_LOCATION;
+    }
+
+    void UniformTable::add_uniform(const std::string &name, const GLint location, const GLenum type) {
+        if (location >= static_cast<GLint>(location_to_slot_.size())) {
+            location_to_slot_.resize(location + 1, -1);
+        }
+
+        location_to_slot_[location] = static_cast<int32_t>(slots_.size());
+        name_to_location_[name] = location;
+
+        Slot slot;
+        slot.location = location;
+        slot.type = type;
+        slots_.push_back(slot);
+    }
+}
@@ -0,0 +1,128 @@
+//
+// Created by denzel on 17/10/2026.
+//
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "GL/glew.h"
+
+namespace hellfire {
+    /// Interned uniform name. Resolve once with UniformTable::intern() and reuse on the hot path.
+    using UniformID = uint32_t;
+
+    /**
+     * @brief Per-program uniform location table.
+     *
+     * Filled once by reflection right after the program is linked and kept alive for the
+     * lifetime of the program, so lookups never hit glGetUniformLocation. The table also
+     * remembers the last value uploaded to every location, which lets the setters skip
+     * glUniform* calls that would not change program state.
+     */
+    class UniformTable {
+    public:
+        static constexpr GLint INVALID_LOCATION = -1;
+
+        explicit UniformTable(uint32_t program_id);
+
+        /// Intern a uniform name. The same name always yields the same id, for every program.
+        static UniformID intern(std::string_view name);
+
+        static const std::string &get_name(UniformID id);
+
+        /// Re-run reflection and forget all tracked values (e.g. after a relink).
+        void reflect();
+
+        /// Forget tracked values, forcing the next upload of every uniform.
+        void invalidate_values();
+
+        GLint get_location(UniformID id);
+
+        GLint get_location(std::string_view name) const;
+
+        bool has_uniform(UniformID id) { return get_location(id) != INVALID_LOCATION; }
+        bool has_uniform(std::string_view name) const { return get_location(name) != INVALID_LOCATION; }
+
+        uint32_t get_program_id() const { return program_id_; }
+        size_t get_uniform_count() const { return slots_.size(); }
+
+        // Upload statistics, reset with reset_stats()
+        uint32_t get_uploaded_count() const { return uploaded_count_; }
+        uint32_t get_skipped_count() const { return skipped_count_; }
+
+        void reset_stats() {
+            uploaded_count_ = 0;
+            skipped_count_ = 0;
+        }
+
+        /**
+         * @brief Record value for the uniform at location.
+         * @return true when the value differs from the last uploaded one and must be sent to GL
+         */
+        template<typename T>
+        bool should_upload(const GLint location, const T &value) {
+            static_assert(sizeof(T) <= sizeof(Slot::value), "Uniform value too large for the table");
+
+            if (location < 0 || location >= static_cast<GLint>(location_to_slot_.size()) ||
+                location_to_slot_[location] < 0) {
+                ++uploaded_count_;
+                return true;
+            }
+
+            Slot &slot = slots_[location_to_slot_[location]];
+            if (slot.has_value && slot.value_size == sizeof(T) &&
+                std::memcmp(slot.value.data(), &value, sizeof(T)) == 0) {
+                ++skipped_count_;
+                return false;
+            }
+
+            std::memcpy(slot.value.data(), &value, sizeof(T));
+            slot.value_size = static_cast<uint8_t>(sizeof(T));
+            slot.has_value = true;
+            ++uploaded_count_;
+            return true;
+        }
+
+    private:
+        static constexpr int32_t UNRESOLVED = -2;
+
+        // Transparent hash so string_view lookups don't allocate
+        struct NameHash {
+            using is_transparent = void;
+
+            size_t operator()(const std::string_view name) const {
+                return std::hash<std::string_view>{}(name);
+            }
+        };
+
+        struct Slot {
+            GLint location = INVALID_LOCATION;
+            GLenum type = 0;
+            alignas(16) std::array<std::byte, 64> value{};
+            uint8_t value_size = 0;
+            bool has_value = false;
+        };
+
+        uint32_t program_id_;
+        std::vector<Slot> slots_;
+        std::unordered_map<std::string, GLint, NameHash, std::equal_to<>> name_to_location_;
+        // Uniform locations are small and dense, so index slots by location directly
+        std::vector<int32_t> location_to_slot_;
+
+        // Indexed by UniformID, lazily resolved to a location (or INVALID_LOCATION)
+        std::vector<int32_t> id_to_location_;
+
+        uint32_t uploaded_count_ = 0;
+        uint32_t skipped_count_ = 0;
+
+        void add_uniform(const std::string &name, GLint location, GLenum type);
+    };
+}
@@ -7,6 +7,7 @@
 #include <iostream>
 #include <stb/stb_image.h>
 
+#include "hellfire/graphics/backends/opengl/GLStateCache.h"
 #include "hellfire/graphics/material/Material.h"
 
 namespace hellfire {
@@ -57,7 +58,7 @@ namespace hellfire {
         if (this != &other) {
             // Clean up current texture
             if (texture_id_ != 0) {
-                glDeleteTextures(1, &texture_id_);
+                GLStateCache::delete_textures(1, &texture_id_);
             }
 
             // Transfer ownership
@@ -76,7 +77,7 @@ namespace hellfire {
 
     Texture::~Texture() {
         if (texture_id_ != 0) {
-            glDeleteTextures(1, &texture_id_);
+            GLStateCache::delete_textures(1, &texture_id_);
         }
     }
 
@@ -130,7 +131,7 @@ namespace hellfire {
             return;
         }
 
-        glBindTexture(GL_TEXTURE_2D, texture_id_);
+        GLStateCache::bind_texture(GL_TEXTURE_2D, texture_id_);
         glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
         // Determine formats
@@ -151,7 +152,7 @@ namespace hellfire {
             default:
                 std::cerr << "Unsupported channel count: " << nr_channels << std::endl;
                 stbi_image_free(data);
-                glDeleteTextures(1, &texture_id_);
+                GLStateCache::delete_textures(1, &texture_id_);
                 texture_id_ = 0;
                 return;
         }
@@ -172,7 +173,7 @@ namespace hellfire {
         if (gl_error != GL_NO_ERROR) {
             std::cerr << "OpenGL error uploading texture: " << gl_error << std::endl;
             stbi_image_free(data);
-            glDeleteTextures(1, &texture_id_);
+            GLStateCache::delete_textures(1, &texture_id_);
             texture_id_ = 0;
             return;
         }
@@ -200,12 +201,11 @@ namespace hellfire {
     }
 
     void Texture::bind(unsigned int slot) const {
-        glActiveTexture(GL_TEXTURE0 + slot);
-        glBindTexture(GL_TEXTURE_2D, texture_id_);
+        GLStateCache::bind_texture_unit(slot, GL_TEXTURE_2D, texture_id_);
     }
 
     void Texture::unbind() const {
-        glBindTexture(GL_TEXTURE_2D, 0);
+        GLStateCache::bind_texture(GL_TEXTURE_2D, 0);
     }
 
     std::string Texture::type_to_string(TextureType type) {
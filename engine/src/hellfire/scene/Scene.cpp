@@ -23,6 +23,12 @@ namespace hellfire {
     }
 
     Scene::~Scene() {
+        // Copy, observers usually unregister themselves in the callback
+        for (SceneObserver *observer: std::vector(observers_)) {
+            observer->on_scene_destroyed(*this);
+        }
+        observers_.clear();
+
         entities_.clear();
     }
 
@@ -32,6 +38,7 @@ namespace hellfire {
         EntityID id = next_id_++;
         auto entity = std::make_unique<Entity>(id, unique_name);
 
+        entity->set_observer(this);
         entity->add_component<TransformComponent>();
 
         entities_[id] = std::move(entity);
@@ -74,6 +81,10 @@ namespace hellfire {
         // Remove children mapping
         children_map_.erase(id);
 
+        for (SceneObserver *observer: observers_) {
+            observer->on_entity_destroyed(*it->second);
+        }
+
         // Delete the entity
         entities_.erase(it);
     }
@@ -244,6 +255,34 @@ namespace hellfire {
     void Scene::save() {
     }
 
+    void Scene::add_observer(SceneObserver *observer) {
+        if (observer && std::ranges::find(observers_, observer) == observers_.end()) {
+            observers_.push_back(observer);
+        }
+    }
+
+    void Scene::remove_observer(SceneObserver *observer) {
+        std::erase(observers_, observer);
+    }
+
+    void Scene::on_component_added(Entity &entity, Component &component) {
+        for (SceneObserver *observer: observers_) {
+            observer->on_component_added(entity, component);
+        }
+    }
+
+    void Scene::on_component_removed(Entity &entity, Component &component) {
+        for (SceneObserver *observer: observers_) {
+            observer->on_component_removed(entity, component);
+        }
+    }
+
+    void Scene::on_component_changed(Entity &entity, Component &component) {
+        for (SceneObserver *observer: observers_) {
+            observer->on_component_changed(entity, component);
+        }
+    }
+
     void Scene::update_hierarchy(EntityID entity_id, float delta_time) {
         Entity *entity = get_entity(entity_id);
         if (!entity) return;
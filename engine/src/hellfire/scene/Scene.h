@@ -14,6 +14,31 @@ namespace hellfire {
 
     using EntityID = uint32_t;
 
+    class Scene;
+
+    /**
+     * @brief Listens to the entities of a scene, see Scene::add_observer()
+     *
+     * Lets systems such as the renderer keep retained data in sync without walking the scene every frame.
+     */
+    class SceneObserver {
+    public:
+        virtual ~SceneObserver() = default;
+
+        virtual void on_component_added(Entity &entity, Component &component) {}
+
+        /// Called while the component is still attached
+        virtual void on_component_removed(Entity &entity, Component &component) {}
+
+        virtual void on_component_changed(Entity &entity, Component &component) {}
+
+        /// Called before the entity and its components are destroyed
+        virtual void on_entity_destroyed(Entity &entity) {}
+
+        /// Called from the scene destructor, the observer must not touch the scene afterwards
+        virtual void on_scene_destroyed(Scene &scene) {}
+    };
+
     /**
      * @brief Manages a collection of entities and their hierarchical relationships
      *
@@ -21,7 +46,7 @@ namespace hellfire {
      * their parent-child relationships, cameras, and environmental settings.
      * It handles entity lifecycle, hierarchy management, and scene updates.
      */
-    class Scene {
+    class Scene : public EntityObserver {
     public:
         /**
          * @brief Constructs a new Scene with an optional name
@@ -32,7 +57,7 @@ namespace hellfire {
         /**
          * @brief Destructor
          */
-        virtual ~Scene();
+        ~Scene() override;
 
         /**
          * @brief Creates a new entity in the scene
@@ -182,6 +207,26 @@ namespace hellfire {
 
         std::unordered_map<EntityID, std::unique_ptr<Entity>>& get_all_entities() { return entities_; }
 
+        // Observers
+
+        /**
+         * @brief Registers an observer for component and entity changes
+         * @param observer The observer, it must remove itself before it is destroyed
+         */
+        void add_observer(SceneObserver *observer);
+
+        /**
+         * @brief Unregisters an observer
+         * @param observer The observer to remove
+         */
+        void remove_observer(SceneObserver *observer);
+
+        void on_component_added(Entity &entity, Component &component) override;
+
+        void on_component_removed(Entity &entity, Component &component) override;
+
+        void on_component_changed(Entity &entity, Component &component) override;
+
     private:
         // All entities owned by scene
         std::unordered_map<EntityID, std::unique_ptr<Entity> > entities_;
@@ -201,6 +246,8 @@ namespace hellfire {
 
         std::unique_ptr<SceneEnvironment> environment_;
 
+        std::vector<SceneObserver *> observers_;
+
         // Helper methods
         void update_hierarchy(EntityID entity_id, float delta_time);
 
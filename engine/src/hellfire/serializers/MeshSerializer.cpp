@@ -10,7 +10,32 @@
 #include "hellfire/utilities/SerializerUtils.h"
 
 namespace hellfire {
-    bool MeshSerializer::save(const std::filesystem::path &filepath, const Mesh &mesh) {
+    namespace {
+        void write_indices(std::ostream &out, const std::vector<unsigned int> &indices, const IndexType type) {
+            if (type == IndexType::UINT16) {
+                write_binary_vector(out, std::vector<uint16_t>(indices.begin(), indices.end()));
+            } else {
+                write_binary_vector(out, indices);
+            }
+        }
+
+        bool read_indices(std::istream &in, std::vector<unsigned int> &indices, const IndexType type) {
+            if (type == IndexType::UINT32) return read_binary_vector(in, indices);
+
+            std::vector<uint16_t> narrow;
+            if (!read_binary_vector(in, narrow)) return false;
+            indices.assign(narrow.begin(), narrow.end());
+            return true;
+        }
+    }
+
+    bool MeshSerializer::save(const std::filesystem::path &filepath, const Mesh &mesh,
+                              MeshOptimizationStats *optimization_stats) {
+        if (!mesh.has_cpu_data()) {
+            std::cerr << "MeshSerializer: Mesh data was released after upload: " << filepath << std::endl;
+            return false;
+        }
+
         std::ofstream file(filepath, std::ios::binary);
         if (!file) {
             std::cerr << "MeshSerializer: Cannot open file for writing: " << filepath << std::endl;
@@ -22,19 +47,61 @@ namespace hellfire {
             return false;
         }
 
+        // Every written mesh goes out in GPU friendly order, whatever order its source had
+        std::vector<Vertex> vertices = mesh.vertices;
+        std::vector<unsigned int> indices = mesh.indices;
+        std::vector<MeshLod> lods = mesh.lods;
+        const MeshOptimizationStats stats = MeshOptimizer::optimize(vertices, indices, lods);
+        if (optimization_stats) *optimization_stats = stats;
+
         // Mesh flags
         write_binary(file, mesh.is_wireframe);
 
         // Vertex data
-        write_vertex_vector(file, mesh.vertices);
+        write_vertex_vector(file, vertices);
+
+        // Index data, 16 bit whenever the vertex count allows it
+        const IndexType index_type = select_index_type(vertices.size());
+        write_binary(file, index_type);
+        write_indices(file, indices, index_type);
 
-        // Index data
-        write_binary_vector(file, mesh.indices);
+        // Bounds, so loading doesn't have to walk every vertex
+        const MeshBounds bounds = mesh.get_bounds().is_valid()
+                                      ? mesh.get_bounds()
+                                      : MeshBounds::from_vertices(vertices);
+        write_binary(file, bounds.aabb.min);
+        write_binary(file, bounds.aabb.max);
+        write_binary(file, bounds.sphere.center);
+        write_binary(file, bounds.sphere.radius);
+
+        // LOD chain, sharing the vertex data above
+        write_binary(file, static_cast<uint32_t>(lods.size()));
+        for (const MeshLod &lod: lods) {
+            write_binary(file, lod.error);
+            write_indices(file, lod.indices, index_type);
+        }
+
+        // GPU layout, the data above stays full precision so it can be changed without reimporting
+        write_binary(file, mesh.vertex_layout.attributes);
 
         return file.good();
     }
 
-    std::shared_ptr<Mesh> MeshSerializer::load(const std::filesystem::path &filepath) {
+    std::shared_ptr<Mesh> MeshSerializer::load(const std::filesystem::path &filepath,
+                                               const Mesh::CpuResidency residency) {
+        auto mesh = load_cpu_data(filepath);
+        if (!mesh) {
+            return nullptr;
+        }
+
+        // Lets build() drop the CPU copy, the file is where it comes back from
+        mesh->set_source_path(filepath);
+        mesh->cpu_residency = residency;
+        mesh->build();
+        return mesh;
+    }
+
+    std::shared_ptr<Mesh> MeshSerializer::load_cpu_data(const std::filesystem::path &filepath) {
         std::ifstream file(filepath, std::ios::binary);
         if (!file) {
             std::cerr << "MeshSerializer: Cannot open file: " << filepath << std::endl;
@@ -60,16 +127,52 @@ namespace hellfire {
             return nullptr;
         }
 
-        // Index data
-        if (!read_binary_vector(file, mesh->indices)) {
+        // Index data, always 32 bit before version 5
+        IndexType index_type = IndexType::UINT32;
+        if (version >= 5 && (!read_binary(file, index_type) || index_type > IndexType::UINT16)) {
+            return nullptr;
+        }
+        if (!read_indices(file, mesh->indices, index_type)) {
+            return nullptr;
+        }
+
+        // Version 1 files have no bounds, build() computes them from the vertices
+        if (version >= 2) {
+            MeshBounds bounds;
+            if (!read_binary(file, bounds.aabb.min) || !read_binary(file, bounds.aabb.max) ||
+                !read_binary(file, bounds.sphere.center) || !read_binary(file, bounds.sphere.radius)) {
+                return nullptr;
+            }
+            mesh->set_bounds(bounds);
+        }
+
+        // Older files have no LODs and are drawn at full detail
+        if (version >= 3) {
+            uint32_t lod_count;
+            if (!read_binary(file, lod_count) || lod_count >= MAX_MESH_LODS) {
+                return nullptr;
+            }
+            mesh->lods.resize(lod_count);
+            for (MeshLod &lod: mesh->lods) {
+                if (!read_binary(file, lod.error) || !read_indices(file, lod.indices, index_type)) {
+                    return nullptr;
+                }
+            }
+        }
+
+        if (version >= 4 && !read_binary(file, mesh->vertex_layout.attributes)) {
             return nullptr;
         }
 
-        mesh->build();
         return mesh;
     }
 
     bool MeshSerializer::save_json(const std::filesystem::path &filepath, const Mesh &mesh) {
+        if (!mesh.has_cpu_data()) {
+            std::cerr << "MeshSerializer: Mesh data was released after upload: " << filepath << std::endl;
+            return false;
+        }
+
         nlohmann::json j;
         j["version"] = VERSION;
         j["is_wireframe"] = mesh.is_wireframe;
@@ -89,6 +192,24 @@ namespace hellfire {
 
         j["indices"] = mesh.indices;
 
+        j["vertex_layout"] = mesh.vertex_layout.attributes;
+
+        auto &lods = j["lods"];
+        lods = nlohmann::json::array();
+        for (const MeshLod &lod: mesh.lods) {
+            lods.push_back({{"error", lod.error}, {"indices", lod.indices}});
+        }
+
+        const MeshBounds bounds = mesh.get_bounds().is_valid()
+                                      ? mesh.get_bounds()
+                                      : MeshBounds::from_vertices(mesh.vertices);
+        j["bounds"] = {
+            {"min", vec3_to_json(bounds.aabb.min)},
+            {"max", vec3_to_json(bounds.aabb.max)},
+            {"sphere_center", vec3_to_json(bounds.sphere.center)},
+            {"sphere_radius", bounds.sphere.radius}
+        };
+
         std::ofstream file(filepath);
         if (!file) return false;
 
@@ -122,6 +243,24 @@ namespace hellfire {
 
             mesh->indices = j["indices"].get<std::vector<unsigned int> >();
 
+            mesh->vertex_layout.attributes = j.value("vertex_layout", 0u);
+
+            if (j.contains("lods")) {
+                for (const auto &lod: j["lods"]) {
+                    mesh->lods.push_back({lod["indices"].get<std::vector<unsigned int> >(), lod.value("error", 0.0f)});
+                }
+            }
+
+            if (j.contains("bounds")) {
+                const auto &b = j["bounds"];
+                MeshBounds bounds;
+                if (auto min = json_get_vec3(b, "min")) bounds.aabb.min = *min;
+                if (auto max = json_get_vec3(b, "max")) bounds.aabb.max = *max;
+                if (auto center = json_get_vec3(b, "sphere_center")) bounds.sphere.center = *center;
+                bounds.sphere.radius = b.value("sphere_radius", -1.0f);
+                mesh->set_bounds(bounds);
+            }
+
             return mesh;
         } catch (const std::exception &e) {
             std::cerr << "MeshSerializer: JSON parse error: " << e.what() << std::endl;
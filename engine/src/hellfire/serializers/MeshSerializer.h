@@ -13,10 +13,19 @@ namespace hellfire {
     class MeshSerializer {
     public:
         static constexpr uint32_t MAGIC = 0x4853454D; // MESH
-        static constexpr uint32_t VERSION = 1;
+        // v2: local bounds (AABB + sphere) stored after the index data
+        // v3: LOD chain (count, then error and indices per LOD) after the bounds
+        // v4: VertexLayout attributes the mesh is uploaded with, after the LOD chain
+        // v5: IndexType ahead of the index data, mesh and LOD indices are stored at that width
+        static constexpr uint32_t VERSION = 5;
 
-        static bool save(const std::filesystem::path& filepath, const Mesh& mesh);
-        static std::shared_ptr<Mesh> load(const std::filesystem::path& filepath);
+        /// Writes an optimized copy of the mesh data (see MeshOptimizer), optionally reporting what that gained
+        static bool save(const std::filesystem::path& filepath, const Mesh& mesh,
+                         MeshOptimizationStats* optimization_stats = nullptr);
+        static std::shared_ptr<Mesh> load(const std::filesystem::path& filepath,
+                                          Mesh::CpuResidency residency = Mesh::CpuResidency::RELEASE_AFTER_UPLOAD);
+        /// Read the mesh data only, the returned mesh isn't built
+        static std::shared_ptr<Mesh> load_cpu_data(const std::filesystem::path& filepath);
 
         // JSON format for debugging/tools
         static bool save_json(const std::filesystem::path& filepath, const Mesh& mesh);
@@ -101,7 +101,8 @@ namespace hellfire {
                 {"cast_shadows", obj->cast_shadows},
                 {"receive_shadows", obj->receive_shadows},
                 {"visible", obj->visible},
-                {"render_layer", obj->render_layer}
+                {"render_layer", obj->render_layer},
+                {"occluder_mode", static_cast<int>(obj->occluder_mode)}
             };
 
             output << j.dump(4);
@@ -120,6 +121,7 @@ namespace hellfire {
                 obj->receive_shadows = j.value("receive_shadows", true);
                 obj->visible = j.value("visible", true);
                 obj->render_layer = j.value("render_layer", 0u);
+                obj->occluder_mode = static_cast<RenderableComponent::OccluderMode>(j.value("occluder_mode", 0));
 
                 return true;
             } catch (...) {
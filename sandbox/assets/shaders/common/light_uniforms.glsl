@@ -1,5 +1,5 @@
 #define MAX_DIRECTIONAL_LIGHTS 4
-#define MAX_POINT_LIGHTS 8
+#define MAX_SHADOW_CASCADES 4
 
 struct DirectionalLight {
     vec3 direction;
@@ -15,8 +15,46 @@ struct PointLight {
     float attenuation;
 };
 
-uniform int numDirectionalLights;
-uniform int numPointLights;
-uniform DirectionalLight directionalLights[MAX_DIRECTIONAL_LIGHTS];
-uniform PointLight pointLights[MAX_POINT_LIGHTS];
+// Per-frame light data, uploaded once per frame by the renderer (LightData in FrameData.h)
+layout(std140, binding = 1) uniform LightData {
+    DirectionalLight directionalLights[MAX_DIRECTIONAL_LIGHTS];
+    mat4 uShadowMatrices[MAX_DIRECTIONAL_LIGHTS * MAX_SHADOW_CASCADES]; // [light * MAX_SHADOW_CASCADES + cascade]
+    vec4 uShadowTiles[MAX_DIRECTIONAL_LIGHTS * MAX_SHADOW_CASCADES]; // UV rect of each cascade in the atlas, empty without shadows
+    vec4 uCascadeSplits; // View depth where each cascade ends
+    vec4 uClusterScale; // Pixels to tiles (xy), log view depth to slice (z * log(depth) + w)
+    ivec4 uClusterGrid; // Tiles along x and y, depth slices along z
+    int numDirectionalLights;
+    int numPointLights;
+    float uShadowBias;
+    int uNumCascades;
+};
+
+// Every point light, with no upper limit (GPUPointLight in FrameData.h)
+layout(std430, binding = 3) readonly buffer PointLightBuffer {
+    PointLight pointLights[];
+};
+
+// Clustered forward lighting: the view frustum is split into a froxel grid and each
+// cluster lists the point lights that reach into it (see LightClusters.h)
+struct LightCluster {
+    uint offset; // First entry in lightIndices
+    uint count;
+};
+
+layout(std430, binding = 4) readonly buffer LightClusterBuffer {
+    LightCluster lightClusters[];
+};
+
+layout(std430, binding = 5) readonly buffer LightIndexBuffer {
+    uint lightIndices[];
+};
+
+// Cluster containing a fragment, fragCoord is gl_FragCoord.xy and viewDepth its distance along the view axis
+LightCluster getLightCluster(vec2 fragCoord, float viewDepth) {
+    ivec3 cell = ivec3(vec3(fragCoord * uClusterScale.xy, log(max(viewDepth, 1e-4)) * uClusterScale.z + uClusterScale.w));
+    cell = clamp(cell, ivec3(0), uClusterGrid.xyz - 1);
+    return lightClusters[cell.x + uClusterGrid.x * (cell.y + uClusterGrid.y * cell.z)];
+}
 
+// All shadow cascades live in tiles of one atlas, bound once per frame to texture unit 10
+layout(binding = 10) uniform sampler2D uShadowAtlas;
@@ -21,11 +21,7 @@ uniform vec3 uDiffuseColor;
 uniform vec3 uSpecularColor; 
 uniform float uShininess;
 
-// Lighting uniforms
-uniform vec3 uAmbientLight;
-
-// Camera position for specular calculations
-uniform vec3 viewPos;
+// uAmbientLight and viewPos are part of the FrameData block (common/frame_data.glsl)
 
 // UV controls
 uniform vec2 uvTiling;
@@ -0,0 +1,13 @@
+// Weighted blended order-independent transparency (McGuire and Bavoil 2013), written by the OIT
+// variant of a fragment shader in place of its color output. The accumulation target is blended
+// additively, revealage is multiplied by (1 - alpha); oit_composite.frag resolves both.
+layout(location=2) out vec4 oitAccumulation;
+layout(location=3) out float oitRevealage;
+
+void writeOITOutput(vec3 color, float alpha) {
+    // Favours near and opaque surfaces, clamped to stay in half float range
+    float depth_weight = pow(1.0 - gl_FragCoord.z * 0.9, 3.0);
+    float weight = clamp(pow(min(1.0, alpha * 10.0) + 0.01, 3.0) * 1e8 * depth_weight, 1e-2, 3e3);
+    oitAccumulation = vec4(color * alpha, alpha) * weight;
+    oitRevealage = alpha;
+}
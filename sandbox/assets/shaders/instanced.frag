@@ -10,30 +10,11 @@ in vec3 vFragPos;
 // Output
 out vec4 fragColor;
 
-// Maximum number of lights
-#define MAX_DIRECTIONAL_LIGHTS 4
-#define MAX_POINT_LIGHTS 8
-
-// Light structures
-struct DirectionalLight {
-    vec3 direction;
-    vec3 color;
-    float intensity;
-};
-
-struct PointLight {
-    vec3 position;
-    vec3 color;
-    float intensity;
-    float range;
-    float attenuation;
-};
-
-// Light uniforms
-uniform int numDirectionalLights;
-uniform int numPointLights;
-uniform DirectionalLight directionalLights[MAX_DIRECTIONAL_LIGHTS];
-uniform PointLight pointLights[MAX_POINT_LIGHTS];
+// View matrix for the light cluster lookup
+#include "common/frame_data.glsl"
+
+// Light structures, the LightData block and the light clusters
+#include "common/light_uniforms.glsl"
 
 // Material uniforms
 uniform sampler2D uDiffuseTexture;
@@ -192,8 +173,10 @@ void main() {
         result += calcDirectionalLightWithSpecular(directionalLights[i], normal, vFragPos, viewDir, finalBaseColor.rgb);
     }
 
-    for (int i = 0; i < numPointLights; i++) {
-        result += calcPointLight(pointLights[i], normal, vFragPos, finalBaseColor.rgb);
+    // Only the point lights that reach this fragment's cluster
+    LightCluster cluster = getLightCluster(gl_FragCoord.xy, -(view * vec4(vFragPos, 1.0)).z);
+    for (uint i = 0u; i < cluster.count; i++) {
+        result += calcPointLight(pointLights[lightIndices[cluster.offset + i]], normal, vFragPos, finalBaseColor.rgb);
     }
 
     // Calculate final alpha
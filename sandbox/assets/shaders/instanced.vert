@@ -1,9 +1,7 @@
 #version 430 core
 
-// Uniform inputs
-uniform mat4 view;       // View matrix
-uniform mat4 projection; // Projection matrix
-uniform float time;      // Time for animations
+// View, projection and time come from the FrameData block
+#include "common/frame_data.glsl"
 
 // Per-vertex inputs
 layout(location = 0) in vec3 position;
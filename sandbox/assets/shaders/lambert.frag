@@ -1,5 +1,6 @@
 #version 430 core
 
+#include "common/frame_data.glsl"
 #include "common/vertex_inputs.glsl"
 #include "common/material_uniforms.glsl"
 #include "common/light_uniforms.glsl"
@@ -61,9 +61,11 @@ vec3 calculateBlinnPhongLighting(vec3 normal, vec3 baseColor, vec3 fragPos) {
         result += calcDirectionalLight(directionalLights[i], normal, fragPos, materialDiffuse, uSpecularColor);
     }
 
-    // Add point lights
-    for (int i = 0; i < min(numPointLights, MAX_POINT_LIGHTS); i++) {
-        result += calcPointLight(pointLights[i], normal, fragPos, materialDiffuse, uSpecularColor);
+    // Add the point lights that reach this fragment's cluster
+    LightCluster cluster = getLightCluster(gl_FragCoord.xy, -(view * vec4(fragPos, 1.0)).z);
+    for (uint i = 0u; i < cluster.count; i++) {
+        PointLight light = pointLights[lightIndices[cluster.offset + i]];
+        result += calcPointLight(light, normal, fragPos, materialDiffuse, uSpecularColor);
     }
 
     return result;
@@ -0,0 +1,21 @@
+#version 430 core
+
+// Overdraw visualization: drawn with additive blending, every shaded fragment adds one step
+// of the heat ramp, so pixels go from dark red over orange and yellow to white
+layout(location=0) out vec4 fragColor;
+layout(location=1) out uint objectID;
+
+#ifdef INSTANCED
+flat in uint vObjectID;
+#else
+uniform uint uObjectID;
+#endif
+
+void main() {
+    fragColor = vec4(0.25, 0.1, 0.04, 1.0);
+#ifdef INSTANCED
+    objectID = vObjectID;
+#else
+    objectID = uObjectID;
+#endif
+}
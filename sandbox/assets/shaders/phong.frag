@@ -1,15 +1,24 @@
 #version 430 core
 
+#include "common/frame_data.glsl"
 #include "common/vertex_inputs.glsl"
 #include "common/material_uniforms.glsl"
 #include "common/light_uniforms.glsl"
 #include "common/texture_utils.glsl"
 #include "lighting/blinn_phong.glsl"
 
+#ifdef OIT
+#include "common/oit_output.glsl"
+#else
 layout(location=0) out vec4 fragColor;
+#endif
 layout(location=1) out uint objectID;
 
+#ifdef INSTANCED
+flat in uint vObjectID; // Written per instance by standard.vert
+#else
 uniform uint uObjectID;
+#endif
 
 void main() {
     // Sample base textures
@@ -21,6 +30,14 @@ void main() {
     // Calculate lighting
     vec3 result = calculateBlinnPhongLighting(normal, baseColor.rgb, fs_in.FragPos);
 
+#ifdef OIT
+    writeOITOutput(result, uOpacity);
+#else
     fragColor = vec4(result, uOpacity);
+#endif
+#ifdef INSTANCED
+    objectID = vObjectID;
+#else
     objectID = uObjectID;
+#endif
 }
\ No newline at end of file
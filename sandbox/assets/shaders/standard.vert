@@ -1,15 +1,21 @@
     #version 430 core
 
+#include "common/frame_data.glsl"
+
+#ifdef INSTANCED
+#include "common/instance_data.glsl"
+flat out uint vObjectID;
+#else
 // Uniform inputs
-uniform mat4 MVP;       // Combined model-view-projection matrix
-uniform mat4 model;     // Model matrix only - needed for world space calculations
+uniform mat4 model;     // Model matrix only - view/projection come from the FrameData block
+#endif
 
 // Per-vertex inputs
 layout(location = 0) in vec3 aPosition;
 layout(location = 1) in vec3 aNormal;
 layout(location = 2) in vec3 aColor;
 layout(location = 3) in vec2 aTexCoords;
-layout(location = 4) in vec3 aTangent;
+layout(location = 4) in vec4 aTangent; // w: bitangent sign, 1 for float tangents
 layout(location = 5) in vec3 aBitangent;
 
 // Outputs
@@ -21,15 +27,24 @@ layout(location = 5) in vec3 aBitangent;
         mat3 TBN;
     } vs_out;
 
+// Same depth in every program built from this shader, the depth pre-pass relies on GL_EQUAL
+invariant gl_Position;
+
 void main()
 {
+#ifdef INSTANCED
+    InstanceRecord instance = instances[aInstanceIndex];
+    mat4 model = instance.model;
+    vObjectID = instance.objectID;
+#endif
+
     vs_out.Color = aColor;
     vs_out.TexCoords = aTexCoords;
 
     mat3 normalMatrix = transpose(inverse(mat3(model)));
     vec3 N = normalize(normalMatrix * aNormal);
-    vec3 T = normalize(normalMatrix * aTangent);
-    vec3 B = normalize(cross(N, T));
+    vec3 T = normalize(normalMatrix * aTangent.xyz);
+    vec3 B = normalize(cross(N, T)) * (aTangent.w < 0.0 ? -1.0 : 1.0);
     
     // (Tangent, Bitangent, Normal)
     vs_out.TBN = mat3(T, B, N);
@@ -39,5 +54,5 @@ void main()
     // Transform vertex position to world space for lighting calculations
     vs_out.FragPos = vec3(model * vec4(aPosition, 1.0));
 
-    gl_Position = MVP * vec4(aPosition, 1.0);
+    gl_Position = viewProjection * vec4(vs_out.FragPos, 1.0);
 }
@@ -0,0 +1,39 @@
+#version 430 core
+
+// Scales the scene rendered at a reduced resolution up to the output size. Color is filtered
+// bilinearly, then optionally sharpened with a contrast adaptive filter: flat areas get the full
+// uSharpness, edges that already have contrast get less so they don't ring. Object ids are point
+// sampled, picking reads the output at the same coordinates as the color.
+layout(binding=0) uniform sampler2D uSource;
+layout(binding=1) uniform usampler2D uObjectIds;
+uniform float uSharpness; // [0, 1], 0 is plain bilinear
+
+in vec2 vUV;
+
+layout(location=0) out vec4 fragColor;
+layout(location=1) out uint objectID;
+
+void main() {
+    ivec2 source_size = textureSize(uSource, 0);
+    objectID = texelFetch(uObjectIds, clamp(ivec2(vUV * vec2(source_size)), ivec2(0), source_size - 1), 0).r;
+
+    vec4 center = texture(uSource, vUV);
+    if (uSharpness <= 0.0) {
+        fragColor = center;
+        return;
+    }
+
+    // Neighbours one source texel away
+    vec2 texel = 1.0 / vec2(source_size);
+    vec3 north = texture(uSource, vUV + vec2(0.0, texel.y)).rgb;
+    vec3 south = texture(uSource, vUV - vec2(0.0, texel.y)).rgb;
+    vec3 east = texture(uSource, vUV + vec2(texel.x, 0.0)).rgb;
+    vec3 west = texture(uSource, vUV - vec2(texel.x, 0.0)).rgb;
+
+    vec3 minimum = min(center.rgb, min(min(north, south), min(east, west)));
+    vec3 maximum = max(center.rgb, max(max(north, south), max(east, west)));
+    vec3 amount = sqrt(clamp(min(minimum, 1.0 - maximum) / max(maximum, vec3(1e-5)), 0.0, 1.0)) * uSharpness;
+
+    vec3 sharpened = center.rgb + (4.0 * center.rgb - north - south - east - west) * amount * 0.25;
+    fragColor = vec4(clamp(sharpened, minimum, maximum), center.a);
+}
@@ -0,0 +1,120 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <thread>
+
+#include "hellfire/core/Profiler.h"
+
+using namespace hellfire;
+
+namespace {
+    const ProfileEvent *find_event(const ProfileCapture &capture, const char *name) {
+        const auto it = std::find_if(capture.events.begin(), capture.events.end(), [&](const ProfileEvent &event) {
+            return std::strcmp(event.name, name) == 0;
+        });
+        return it != capture.events.end() ? &*it : nullptr;
+    }
+}
+
+TEST_CASE("Profiler records nested scopes with their depth", "[profiler]") {
+    Profiler::clear();
+    {
+        ProfileScope outer("outer");
+        ProfileScope inner("inner");
+    }
+
+    const ProfileCapture capture = Profiler::capture();
+    const ProfileEvent *outer = find_event(capture, "outer");
+    const ProfileEvent *inner = find_event(capture, "inner");
+    REQUIRE(outer);
+    REQUIRE(inner);
+    REQUIRE(outer->depth == 0);
+    REQUIRE(inner->depth == 1);
+    REQUIRE(outer->start_ns <= inner->start_ns);
+    REQUIRE(inner->end_ns <= outer->end_ns);
+    // Captures list each thread's scopes by start, parents before children
+    REQUIRE(outer < inner);
+}
+
+TEST_CASE("Profiler keeps worker threads apart and skips scopes while disabled", "[profiler]") {
+    Profiler::clear();
+    {
+        ProfileScope main_scope("main_scope");
+    }
+    std::thread worker([] {
+        Profiler::set_thread_name("Worker");
+        ProfileScope worker_scope("worker_scope");
+    });
+    worker.join();
+
+    Profiler::set_enabled(false);
+    {
+        ProfileScope skipped("skipped");
+    }
+    Profiler::set_enabled(true);
+
+    const ProfileCapture capture = Profiler::capture();
+    const ProfileEvent *main_event = find_event(capture, "main_scope");
+    const ProfileEvent *worker_event = find_event(capture, "worker_scope");
+    REQUIRE(main_event);
+    REQUIRE(worker_event);
+    REQUIRE(main_event->thread != worker_event->thread);
+    REQUIRE(capture.thread_names[worker_event->thread] == "Worker");
+    REQUIRE(find_event(capture, "skipped") == nullptr);
+}
+
+TEST_CASE("Profiler keeps only the newest events of a thread", "[profiler]") {
+    Profiler::clear();
+    for (uint32_t i = 0; i < Profiler::EVENTS_PER_THREAD + 10; i++) {
+        ProfileScope scope(i == 0 ? "oldest" : "newer");
+    }
+
+    const ProfileCapture capture = Profiler::capture();
+    REQUIRE(capture.events.size() == Profiler::EVENTS_PER_THREAD - 1);
+    REQUIRE(find_event(capture, "oldest") == nullptr);
+}
+
+TEST_CASE("Profiler captures export as Chrome trace events", "[profiler]") {
+    Profiler::clear();
+    Profiler::mark_frame();
+    {
+        ProfileScope scope("say \"hi\"");
+    }
+    Profiler::mark_frame();
+
+    const ProfileCapture capture = Profiler::capture();
+    REQUIRE(capture.frames.size() == 1);
+
+    std::ostringstream trace;
+    capture.write_chrome_trace(trace);
+    const std::string json = trace.str();
+    REQUIRE(json.starts_with("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    REQUIRE(json.find("\"name\":\"say \\\"hi\\\"\",\"cat\":\"cpu\",\"ph\":\"X\"") != std::string::npos);
+    REQUIRE(json.find("\"name\":\"Frame 0\",\"cat\":\"frame\"") != std::string::npos);
+    REQUIRE(json.find("\"ph\":\"M\"") != std::string::npos);
+}
+
+TEST_CASE("Profiler hands the slots of finished threads to new ones", "[profiler]") {
+    Profiler::clear();
+    const auto run_worker = [](const char *scope_name) {
+        std::thread worker([scope_name] {
+            ProfileScope scope(scope_name);
+        });
+        worker.join();
+    };
+
+    run_worker("first_worker");
+    const size_t thread_count = Profiler::capture().thread_names.size();
+    for (int i = 0; i < 8; i++) run_worker("later_worker");
+
+    const ProfileCapture capture = Profiler::capture();
+    REQUIRE(capture.thread_names.size() == thread_count);
+    // The reused slot only shows its current thread's events
+    REQUIRE(find_event(capture, "first_worker") == nullptr);
+    REQUIRE(find_event(capture, "later_worker"));
+}
@@ -0,0 +1,40 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include <catch2/catch_test_macros.hpp>
+
+#include "hellfire/core/TimingHistory.h"
+
+using namespace hellfire;
+
+TEST_CASE("Timing history keeps a rolling window", "[timing]") {
+    TimingHistory history(4);
+    REQUIRE(history.get_average() == 0.0f);
+
+    for (const float sample: {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}) {
+        history.add(sample);
+    }
+
+    // 1 and 2 were pushed out, the ring starts at the oldest remaining sample
+    REQUIRE(history.get_count() == 4);
+    REQUIRE(history.get_latest() == 6.0f);
+    REQUIRE(history.get_min() == 3.0f);
+    REQUIRE(history.get_average() == 4.5f);
+    REQUIRE(history.get_samples()[history.get_offset()] == 3.0f);
+}
+
+TEST_CASE("Timing history percentiles use the nearest rank", "[timing]") {
+    TimingHistory history(100);
+    for (int i = 1; i <= 100; i++) {
+        history.add(static_cast<float>(i));
+    }
+    REQUIRE(history.get_percentile(0.99f) == 99.0f);
+    REQUIRE(history.get_percentile(0.5f) == 50.0f);
+    REQUIRE(history.get_percentile(1.0f) == 100.0f);
+
+    // One spike in a short window is its p99
+    TimingHistory short_history(10);
+    for (int i = 0; i < 9; i++) short_history.add(1.0f);
+    short_history.add(20.0f);
+    REQUIRE(short_history.get_percentile(0.99f) == 20.0f);
+}
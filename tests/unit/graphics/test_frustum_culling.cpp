@@ -0,0 +1,108 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include <catch2/catch_test_macros.hpp>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "hellfire/graphics/culling/Frustum.h"
+
+using namespace hellfire;
+
+namespace {
+    struct TestVertex {
+        glm::vec3 position;
+    };
+
+    AABB make_box(const glm::vec3 &center, const float half_size) {
+        return {center - glm::vec3(half_size), center + glm::vec3(half_size)};
+    }
+
+    Frustum make_camera_frustum() {
+        // Camera at the origin looking down -Z
+        const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 1.0f, 0.1f, 100.0f);
+        const glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        return Frustum(projection * view);
+    }
+}
+
+TEST_CASE("Mesh bounds enclose every vertex", "[culling]") {
+    const std::vector<TestVertex> vertices = {
+        {{-1.0f, 0.0f, 2.0f}}, {{3.0f, -2.0f, 0.0f}}, {{0.0f, 4.0f, -1.0f}}
+    };
+
+    const MeshBounds bounds = MeshBounds::from_vertices(vertices);
+
+    REQUIRE(bounds.is_valid());
+    REQUIRE(bounds.aabb.min == glm::vec3(-1.0f, -2.0f, -1.0f));
+    REQUIRE(bounds.aabb.max == glm::vec3(3.0f, 4.0f, 2.0f));
+    for (const auto &vertex: vertices) {
+        REQUIRE(glm::length(vertex.position - bounds.sphere.center) <= bounds.sphere.radius + 1e-5f);
+    }
+
+    REQUIRE_FALSE(MeshBounds::from_vertices(std::vector<TestVertex>{}).is_valid());
+}
+
+TEST_CASE("Transformed AABB contains the transformed corners", "[culling]") {
+    const AABB local = {glm::vec3(-1.0f, -2.0f, -3.0f), glm::vec3(1.0f, 2.0f, 3.0f)};
+    glm::mat4 matrix = glm::translate(glm::mat4(1.0f), glm::vec3(10.0f, 0.0f, -5.0f));
+    matrix = glm::rotate(matrix, glm::radians(45.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    matrix = glm::scale(matrix, glm::vec3(2.0f));
+
+    const AABB world = local.transformed(matrix);
+
+    for (int corner = 0; corner < 8; corner++) {
+        const glm::vec3 point((corner & 1) ? local.max.x : local.min.x,
+                              (corner & 2) ? local.max.y : local.min.y,
+                              (corner & 4) ? local.max.z : local.min.z);
+        const glm::vec3 transformed = glm::vec3(matrix * glm::vec4(point, 1.0f));
+        for (int axis = 0; axis < 3; axis++) {
+            REQUIRE(transformed[axis] >= world.min[axis] - 1e-4f);
+            REQUIRE(transformed[axis] <= world.max[axis] + 1e-4f);
+        }
+    }
+}
+
+TEST_CASE("Frustum keeps visible boxes and rejects boxes outside", "[culling]") {
+    const Frustum frustum = make_camera_frustum();
+
+    SECTION("In front of the camera") {
+        REQUIRE(frustum.intersects(make_box(glm::vec3(0.0f, 0.0f, -10.0f), 1.0f)));
+    }
+
+    SECTION("Straddling a plane") {
+        REQUIRE(frustum.intersects(make_box(glm::vec3(0.0f, 0.0f, -100.0f), 1.0f)));
+    }
+
+    SECTION("Behind the camera") {
+        REQUIRE_FALSE(frustum.intersects(make_box(glm::vec3(0.0f, 0.0f, 10.0f), 1.0f)));
+    }
+
+    SECTION("Beyond the far plane") {
+        REQUIRE_FALSE(frustum.intersects(make_box(glm::vec3(0.0f, 0.0f, -150.0f), 1.0f)));
+    }
+
+    SECTION("Off to the side") {
+        REQUIRE_FALSE(frustum.intersects(make_box(glm::vec3(50.0f, 0.0f, -10.0f), 1.0f)));
+        REQUIRE_FALSE(frustum.intersects(make_box(glm::vec3(0.0f, -50.0f, -10.0f), 1.0f)));
+    }
+
+    SECTION("Invalid bounds are never culled") {
+        REQUIRE(frustum.intersects(AABB{}));
+    }
+}
+
+TEST_CASE("Frustum sphere test matches the box test", "[culling]") {
+    const Frustum frustum = make_camera_frustum();
+
+    REQUIRE(frustum.intersects(BoundingSphere{glm::vec3(0.0f, 0.0f, -10.0f), 1.0f}));
+    REQUIRE(frustum.intersects(BoundingSphere{glm::vec3(0.0f, 0.0f, 0.5f), 1.0f}));
+    REQUIRE_FALSE(frustum.intersects(BoundingSphere{glm::vec3(0.0f, 0.0f, 10.0f), 1.0f}));
+    REQUIRE_FALSE(frustum.intersects(BoundingSphere{glm::vec3(50.0f, 0.0f, -10.0f), 1.0f}));
+}
+
+TEST_CASE("Default frustum contains everything", "[culling]") {
+    const Frustum frustum;
+    REQUIRE(frustum.intersects(make_box(glm::vec3(1e6f), 1.0f)));
+    REQUIRE(frustum.intersects(BoundingSphere{glm::vec3(-1e6f), 0.0f}));
+}
@@ -0,0 +1,32 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+
+#include "hellfire/graphics/IndexType.h"
+
+using namespace hellfire;
+
+TEST_CASE("16 bit indices are picked while every vertex can be addressed", "[index_type]") {
+    REQUIRE(select_index_type(3) == IndexType::UINT16);
+    REQUIRE(select_index_type(65536) == IndexType::UINT16);
+    REQUIRE(select_index_type(65537) == IndexType::UINT32);
+}
+
+TEST_CASE("Packed indices keep their values at either width", "[index_type]") {
+    const std::vector<unsigned int> indices = {0, 1, 2, 65535, 300, 7};
+
+    const std::vector<uint8_t> narrow = pack_indices(indices, IndexType::UINT16);
+    REQUIRE(narrow.size() == indices.size() * sizeof(uint16_t));
+    for (size_t i = 0; i < indices.size(); i++) {
+        uint16_t value;
+        std::memcpy(&value, narrow.data() + i * sizeof(uint16_t), sizeof(uint16_t));
+        REQUIRE(value == indices[i]);
+    }
+
+    const std::vector<uint8_t> wide = pack_indices(indices, IndexType::UINT32);
+    REQUIRE(wide.size() == indices.size() * sizeof(uint32_t));
+    REQUIRE(std::memcmp(wide.data(), indices.data(), wide.size()) == 0);
+}
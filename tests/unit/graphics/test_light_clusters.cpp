@@ -0,0 +1,109 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "hellfire/graphics/renderer/LightClusters.h"
+
+using namespace hellfire;
+
+namespace {
+    constexpr float NEAR_PLANE = 0.1f;
+    constexpr float FAR_PLANE = 200.0f;
+
+    LightClusters make_clusters() {
+        LightClusters clusters;
+        clusters.set_projection(glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, NEAR_PLANE, FAR_PLANE),
+                                NEAR_PLANE, FAR_PLANE);
+        return clusters;
+    }
+
+    bool cluster_has_light(const LightClusters &clusters, const uint32_t cluster, const uint32_t light) {
+        const GPULightCluster &list = clusters.get_clusters()[cluster];
+        const auto &indices = clusters.get_light_indices();
+        return std::find(indices.begin() + list.offset, indices.begin() + list.offset + list.count, light) !=
+               indices.begin() + list.offset + list.count;
+    }
+}
+
+TEST_CASE("A point light is only listed in the clusters around it", "[lighting]") {
+    LightClusters clusters = make_clusters();
+
+    // Camera at the origin looking down -z, the light sits in the middle of the screen 20 units away
+    const std::vector<LightClusters::Light> lights = {{glm::vec3(0.0f, 0.0f, -20.0f), 2.0f}};
+    clusters.assign(glm::mat4(1.0f), lights);
+
+    REQUIRE(clusters.get_stats().visible_lights == 1);
+    REQUIRE(cluster_has_light(clusters, clusters.get_cluster_index(glm::vec2(0.5f), 20.0f), 0));
+    REQUIRE(cluster_has_light(clusters, clusters.get_cluster_index(glm::vec2(0.5f), 18.5f), 0));
+
+    // Same tile but far behind the light, and the screen corner at the light's depth
+    REQUIRE_FALSE(cluster_has_light(clusters, clusters.get_cluster_index(glm::vec2(0.5f), 60.0f), 0));
+    REQUIRE_FALSE(cluster_has_light(clusters, clusters.get_cluster_index(glm::vec2(0.02f), 20.0f), 0));
+    REQUIRE(clusters.get_stats().occupied_clusters < LIGHT_CLUSTER_COUNT / 10);
+}
+
+TEST_CASE("Lights outside the view frustum get no clusters", "[lighting]") {
+    LightClusters clusters = make_clusters();
+
+    const std::vector<LightClusters::Light> lights = {
+        {glm::vec3(0.0f, 0.0f, 10.0f), 2.0f}, // Behind the camera
+        {glm::vec3(500.0f, 0.0f, -20.0f), 5.0f}, // Far off to the side
+        {glm::vec3(0.0f, 0.0f, -400.0f), 5.0f}, // Past the far plane
+        {glm::vec3(0.0f, 0.0f, -20.0f), 0.0f}, // No range
+    };
+    clusters.assign(glm::mat4(1.0f), lights);
+
+    REQUIRE(clusters.get_stats().visible_lights == 0);
+    REQUIRE(clusters.get_light_indices().empty());
+}
+
+TEST_CASE("Light lists scale past the old per-frame light cap", "[lighting]") {
+    LightClusters clusters = make_clusters();
+
+    // A grid of 400 small lights in front of the camera
+    std::vector<LightClusters::Light> lights;
+    for (int x = 0; x < 20; x++) {
+        for (int z = 0; z < 20; z++) {
+            lights.push_back({glm::vec3(-10.0f + static_cast<float>(x), -2.0f, -15.0f - 2.0f * static_cast<float>(z)), 1.5f});
+        }
+    }
+    clusters.assign(glm::mat4(1.0f), lights);
+
+    const LightClusterStats &stats = clusters.get_stats();
+    REQUIRE(stats.lights == 400);
+    REQUIRE(stats.visible_lights == 400);
+    REQUIRE(stats.max_lights_per_cluster < 400);
+
+    // Every list is in light order and the lists tile the index buffer without gaps
+    uint32_t expected_offset = 0;
+    for (const GPULightCluster &cluster: clusters.get_clusters()) {
+        REQUIRE(cluster.offset == expected_offset);
+        expected_offset += cluster.count;
+        const auto begin = clusters.get_light_indices().begin() + cluster.offset;
+        REQUIRE(std::is_sorted(begin, begin + cluster.count));
+    }
+    REQUIRE(expected_offset == stats.light_indices);
+
+    // Any point a light reaches finds that light in its cluster
+    const float tan_half_fov = std::tan(glm::radians(30.0f));
+    for (int sample = 0; sample < 2000; sample++) {
+        const glm::vec2 uv((static_cast<float>(sample % 40) + 0.5f) / 40.0f, 0.2f + 0.1f * static_cast<float>(sample % 7));
+        const float depth = 14.0f + 0.0271f * static_cast<float>(sample);
+        const glm::vec3 point((uv.x * 2.0f - 1.0f) * depth * tan_half_fov * 16.0f / 9.0f,
+                              (uv.y * 2.0f - 1.0f) * depth * tan_half_fov, -depth);
+
+        const uint32_t cluster = clusters.get_cluster_index(uv, depth);
+        for (uint32_t i = 0; i < lights.size(); i++) {
+            if (glm::distance(point, lights[i].position) < lights[i].range) {
+                REQUIRE(cluster_has_light(clusters, cluster, i));
+            }
+        }
+    }
+}
@@ -0,0 +1,100 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+#include "hellfire/graphics/geometry/MeshOptimizer.h"
+
+using namespace hellfire;
+
+namespace {
+    /// Grid in the xz plane with its triangles shuffled, the worst case for the vertex cache
+    void make_shuffled_grid(const int cells, std::vector<Vertex> &vertices, std::vector<unsigned int> &indices) {
+        for (int z = 0; z <= cells; z++) {
+            for (int x = 0; x <= cells; x++) {
+                Vertex vertex{};
+                vertex.position = glm::vec3(static_cast<float>(x), 0.0f, static_cast<float>(z));
+                vertex.normal = glm::vec3(0.0f, 1.0f, 0.0f);
+                vertices.push_back(vertex);
+            }
+        }
+        std::vector<std::array<unsigned int, 3> > triangles;
+        for (int z = 0; z < cells; z++) {
+            for (int x = 0; x < cells; x++) {
+                const unsigned int corner = z * (cells + 1) + x;
+                triangles.push_back({corner, corner + cells + 1, corner + 1});
+                triangles.push_back({corner + 1, corner + cells + 1, corner + cells + 2});
+            }
+        }
+        std::shuffle(triangles.begin(), triangles.end(), std::mt19937(7));
+        for (const auto &triangle: triangles) {
+            indices.insert(indices.end(), triangle.begin(), triangle.end());
+        }
+    }
+
+    /// Triangles as position triples, rotated to start at the smallest corner so winding is kept
+    std::vector<std::array<float, 9> > triangle_set(const std::vector<Vertex> &vertices,
+                                                   const std::vector<unsigned int> &indices) {
+        std::vector<std::array<float, 9> > triangles;
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            std::array<glm::vec3, 3> corners = {
+                vertices[indices[i]].position, vertices[indices[i + 1]].position, vertices[indices[i + 2]].position
+            };
+            const auto less = [](const glm::vec3 &a, const glm::vec3 &b) {
+                return std::tie(a.x, a.y, a.z) < std::tie(b.x, b.y, b.z);
+            };
+            std::rotate(corners.begin(), std::min_element(corners.begin(), corners.end(), less), corners.end());
+            triangles.push_back({
+                corners[0].x, corners[0].y, corners[0].z, corners[1].x, corners[1].y, corners[1].z,
+                corners[2].x, corners[2].y, corners[2].z
+            });
+        }
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+}
+
+TEST_CASE("ACMR counts FIFO cache misses per triangle", "[mesh_optimizer]") {
+    // Two triangles sharing an edge: 4 misses
+    REQUIRE(MeshOptimizer::calculate_acmr({0, 1, 2, 2, 1, 3}, 4) == 2.0f);
+
+    // With a single entry cache only the directly repeated vertex hits
+    REQUIRE(MeshOptimizer::calculate_acmr({0, 1, 2, 2, 1, 3}, 4, 1) == 2.5f);
+}
+
+TEST_CASE("Optimizing a mesh improves ACMR and keeps every triangle", "[mesh_optimizer]") {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    make_shuffled_grid(32, vertices, indices);
+    const auto original_triangles = triangle_set(vertices, indices);
+
+    const MeshOptimizationStats stats = MeshOptimizer::optimize(vertices, indices);
+
+    REQUIRE(stats.acmr_before > 2.0f);
+    REQUIRE(stats.acmr_after < 0.8f);
+    REQUIRE(stats.acmr_after == MeshOptimizer::calculate_acmr(indices, vertices.size()));
+    REQUIRE(triangle_set(vertices, indices) == original_triangles);
+}
+
+TEST_CASE("Vertex fetch order follows first use and remaps the LODs too", "[mesh_optimizer]") {
+    std::vector<Vertex> vertices(5);
+    for (size_t i = 0; i < vertices.size(); i++) {
+        vertices[i].position = glm::vec3(static_cast<float>(i), 0.0f, 0.0f);
+    }
+    std::vector<unsigned int> indices = {3, 1, 4, 4, 1, 0};
+    std::vector<unsigned int> lod_indices = {3, 0, 4};
+
+    MeshOptimizer::optimize_vertex_fetch(vertices, {&indices, &lod_indices});
+
+    // Vertex 2 is unused and dropped, the others are numbered as they are first read
+    REQUIRE(vertices.size() == 4);
+    REQUIRE(indices == std::vector<unsigned int>{0, 1, 2, 2, 1, 3});
+    REQUIRE(lod_indices == std::vector<unsigned int>{0, 3, 2});
+    REQUIRE(vertices[0].position.x == 3.0f);
+    REQUIRE(vertices[3].position.x == 0.0f);
+}
@@ -0,0 +1,171 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include "hellfire/graphics/geometry/MeshSimplifier.h"
+
+using namespace hellfire;
+
+namespace {
+    /// Flat grid in the xz plane with cells x cells quads
+    void make_grid(const int cells, std::vector<Vertex> &vertices, std::vector<unsigned int> &indices) {
+        for (int z = 0; z <= cells; z++) {
+            for (int x = 0; x <= cells; x++) {
+                Vertex vertex{};
+                vertex.position = glm::vec3(static_cast<float>(x), 0.0f, static_cast<float>(z));
+                vertex.normal = glm::vec3(0.0f, 1.0f, 0.0f);
+                vertex.texCoords = glm::vec2(static_cast<float>(x), static_cast<float>(z)) / static_cast<float>(cells);
+                vertices.push_back(vertex);
+            }
+        }
+        for (int z = 0; z < cells; z++) {
+            for (int x = 0; x < cells; x++) {
+                const unsigned int corner = z * (cells + 1) + x;
+                indices.insert(indices.end(), {corner, corner + cells + 1, corner + 1});
+                indices.insert(indices.end(), {corner + 1, corner + cells + 1, corner + cells + 2});
+            }
+        }
+    }
+
+    /// Unit UV sphere; the first and last column share positions, a UV seam like imported meshes have
+    void make_sphere(const int rings, const int segments, std::vector<Vertex> &vertices,
+                     std::vector<unsigned int> &indices) {
+        constexpr float pi = 3.14159265f;
+        for (int ring = 0; ring <= rings; ring++) {
+            const float theta = pi * static_cast<float>(ring) / static_cast<float>(rings);
+            for (int segment = 0; segment <= segments; segment++) {
+                const float phi = 2.0f * pi * static_cast<float>(segment % segments) / static_cast<float>(segments);
+                Vertex vertex{};
+                vertex.position = glm::vec3(std::sin(theta) * std::cos(phi), std::cos(theta),
+                                            std::sin(theta) * std::sin(phi));
+                if (ring == 0 || ring == rings) vertex.position = glm::vec3(0.0f, ring == 0 ? 1.0f : -1.0f, 0.0f);
+                vertex.normal = vertex.position;
+                vertex.texCoords = glm::vec2(static_cast<float>(segment) / static_cast<float>(segments),
+                                             static_cast<float>(ring) / static_cast<float>(rings));
+                vertices.push_back(vertex);
+            }
+        }
+        for (int ring = 0; ring < rings; ring++) {
+            for (int segment = 0; segment < segments; segment++) {
+                const unsigned int corner = ring * (segments + 1) + segment;
+                const unsigned int below = corner + segments + 1;
+                if (ring > 0) indices.insert(indices.end(), {corner, corner + 1, below});
+                if (ring < rings - 1) indices.insert(indices.end(), {corner + 1, below + 1, below});
+            }
+        }
+    }
+
+    bool has_degenerate_triangles(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices) {
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            const glm::vec3 &a = vertices[indices[i]].position;
+            const glm::vec3 &b = vertices[indices[i + 1]].position;
+            const glm::vec3 &c = vertices[indices[i + 2]].position;
+            if (a == b || b == c || c == a) return true;
+        }
+        return false;
+    }
+}
+
+TEST_CASE("A flat grid simplifies without error and keeps its outline", "[lod]") {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    make_grid(16, vertices, indices);
+
+    const MeshLod lod = MeshSimplifier::simplify(vertices, indices, indices.size() / 8);
+
+    REQUIRE(lod.indices.size() <= indices.size() / 8);
+    REQUIRE(lod.indices.size() % 3 == 0);
+    REQUIRE(lod.error < 1e-3f);
+    REQUIRE_FALSE(has_degenerate_triangles(vertices, lod.indices));
+
+    // Total area is unchanged, so no triangle folded over or left the plane
+    float area = 0.0f;
+    glm::vec3 min(1e9f), max(-1e9f);
+    for (size_t i = 0; i < lod.indices.size(); i += 3) {
+        const glm::vec3 &a = vertices[lod.indices[i]].position;
+        const glm::vec3 &b = vertices[lod.indices[i + 1]].position;
+        const glm::vec3 &c = vertices[lod.indices[i + 2]].position;
+        const glm::vec3 normal = glm::cross(b - a, c - a);
+        REQUIRE(normal.y > 0.0f); // Same winding as the input
+        area += glm::length(normal) * 0.5f;
+        for (const glm::vec3 &p: {a, b, c}) {
+            min = glm::min(min, p);
+            max = glm::max(max, p);
+        }
+    }
+    REQUIRE(std::abs(area - 256.0f) < 1e-2f);
+    REQUIRE(min == glm::vec3(0.0f));
+    REQUIRE(max == glm::vec3(16.0f, 0.0f, 16.0f));
+}
+
+TEST_CASE("A sphere simplifies close to its surface and keeps its seam closed", "[lod]") {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    make_sphere(24, 48, vertices, indices);
+
+    const MeshLod lod = MeshSimplifier::simplify(vertices, indices, indices.size() / 4);
+
+    REQUIRE(lod.indices.size() <= indices.size() / 4);
+    REQUIRE(lod.indices.size() > indices.size() / 8);
+    REQUIRE(lod.error > 0.0f);
+    REQUIRE(lod.error < 0.1f);
+    REQUIRE_FALSE(has_degenerate_triangles(vertices, lod.indices));
+
+    // Closed surface: every edge is shared by exactly two triangles, compared by position
+    std::vector<std::pair<glm::vec3, glm::vec3> > edges;
+    for (size_t i = 0; i < lod.indices.size(); i += 3) {
+        for (int e = 0; e < 3; e++) {
+            edges.emplace_back(vertices[lod.indices[i + e]].position, vertices[lod.indices[i + (e + 1) % 3]].position);
+        }
+    }
+    for (const auto &[a, b]: edges) {
+        int reverse_count = 0;
+        for (const auto &[c, d]: edges) {
+            if (c == b && d == a) reverse_count++;
+        }
+        REQUIRE(reverse_count == 1);
+    }
+}
+
+TEST_CASE("LOD chains get coarser with growing error", "[lod]") {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    make_sphere(16, 32, vertices, indices);
+
+    const std::vector<MeshLod> lods = MeshSimplifier::build_lod_chain(vertices, indices, {0.5f, 0.25f, 0.125f});
+
+    REQUIRE(lods.size() == 3);
+    size_t previous_count = indices.size();
+    float previous_error = 0.0f;
+    for (const MeshLod &lod: lods) {
+        REQUIRE(lod.indices.size() < previous_count);
+        REQUIRE(lod.error >= previous_error);
+        previous_count = lod.indices.size();
+        previous_error = lod.error;
+    }
+}
+
+TEST_CASE("LOD selection follows screen space error with hysteresis", "[lod]") {
+    const std::vector<MeshLod> lods = {{{}, 0.01f}, {{}, 0.04f}, {{}, 0.16f}};
+    constexpr float error_pixels = 1.0f;
+    constexpr float hysteresis = 0.25f;
+
+    // Close up everything is too coarse, far away the coarsest is fine
+    REQUIRE(select_mesh_lod(lods, 1000.0f, 0, error_pixels, hysteresis) == 0);
+    REQUIRE(select_mesh_lod(lods, 1.0f, 0, error_pixels, hysteresis) == 3);
+
+    // LOD 1 projects to 1 pixel here: right at the threshold, so whatever is current stays
+    REQUIRE(select_mesh_lod(lods, 100.0f, 0, error_pixels, hysteresis) == 0);
+    REQUIRE(select_mesh_lod(lods, 100.0f, 1, error_pixels, hysteresis) == 1);
+
+    // Clearly past the band either way
+    REQUIRE(select_mesh_lod(lods, 70.0f, 0, error_pixels, hysteresis) == 1);
+    REQUIRE(select_mesh_lod(lods, 130.0f, 1, error_pixels, hysteresis) == 0);
+
+    // No LODs to pick from
+    REQUIRE(select_mesh_lod({}, 1.0f, 2, error_pixels, hysteresis) == 0);
+}
@@ -0,0 +1,101 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "hellfire/graphics/culling/OcclusionBuffer.h"
+
+using namespace hellfire;
+
+namespace {
+    struct TestVertex {
+        glm::vec3 position;
+    };
+
+    glm::mat4 make_view_projection() {
+        // Camera at the origin looking down -z
+        return glm::perspective(glm::radians(60.0f), 2.0f, 0.1f, 100.0f);
+    }
+
+    /// 20x20 wall facing the camera at z = -10
+    void add_wall(OcclusionBuffer &buffer) {
+        const std::vector<TestVertex> vertices = {
+            {{-10.0f, -10.0f, -10.0f}}, {{10.0f, -10.0f, -10.0f}}, {{10.0f, 10.0f, -10.0f}}, {{-10.0f, 10.0f, -10.0f}},
+        };
+        const std::vector<unsigned int> indices = {0, 1, 2, 2, 3, 0};
+        buffer.add_occluder(glm::mat4(1.0f), vertices, indices);
+    }
+
+    AABB make_box(const glm::vec3 &center, const float half_size) {
+        return {center - glm::vec3(half_size), center + glm::vec3(half_size)};
+    }
+}
+
+TEST_CASE("A wall hides the boxes behind it", "[culling]") {
+    OcclusionBuffer buffer;
+    buffer.begin(make_view_projection());
+    add_wall(buffer);
+    buffer.render(4);
+
+    REQUIRE(buffer.get_triangle_count() == 2);
+    REQUIRE(buffer.get_depth(buffer.get_width() / 2, buffer.get_height() / 2) < 1.0f);
+
+    REQUIRE_FALSE(buffer.is_visible(make_box({0.0f, 0.0f, -20.0f}, 1.0f)));
+    REQUIRE_FALSE(buffer.is_visible(make_box({2.0f, 1.0f, -50.0f}, 5.0f)));
+
+    // In front of the wall, poking through it, and beside it
+    REQUIRE(buffer.is_visible(make_box({0.0f, 0.0f, -5.0f}, 1.0f)));
+    REQUIRE(buffer.is_visible(make_box({0.0f, 0.0f, -10.0f}, 1.0f)));
+    REQUIRE(buffer.is_visible(make_box({25.0f, 0.0f, -20.0f}, 1.0f)));
+}
+
+TEST_CASE("Without occluders nothing is culled", "[culling]") {
+    OcclusionBuffer buffer;
+    buffer.begin(make_view_projection());
+    buffer.render();
+
+    REQUIRE(buffer.is_visible(make_box({0.0f, 0.0f, -20.0f}, 1.0f)));
+    REQUIRE(buffer.is_visible(make_box({0.0f, 0.0f, -90.0f}, 0.1f)));
+}
+
+TEST_CASE("Occluders crossing the near plane are clipped, not dropped", "[culling]") {
+    OcclusionBuffer buffer;
+    buffer.begin(make_view_projection());
+
+    // Floor running from behind the camera into the distance
+    const std::vector<TestVertex> vertices = {
+        {{-50.0f, -1.0f, 10.0f}}, {{50.0f, -1.0f, 10.0f}}, {{50.0f, -1.0f, -90.0f}}, {{-50.0f, -1.0f, -90.0f}},
+    };
+    const std::vector<unsigned int> indices = {0, 1, 2, 2, 3, 0};
+    buffer.add_occluder(glm::mat4(1.0f), vertices, indices);
+    buffer.render(3);
+
+    REQUIRE(buffer.get_triangle_count() > 2);
+    REQUIRE(buffer.get_depth(buffer.get_width() / 2, 2) < 1.0f);
+
+    // Below the floor is hidden, above it is not; boxes around the camera are never culled
+    REQUIRE_FALSE(buffer.is_visible(make_box({0.0f, -4.0f, -20.0f}, 1.0f)));
+    REQUIRE(buffer.is_visible(make_box({0.0f, 2.0f, -20.0f}, 1.0f)));
+    REQUIRE(buffer.is_visible(make_box({0.0f, -4.0f, 0.0f}, 5.0f)));
+}
+
+TEST_CASE("Banded rendering matches a single thread", "[culling]") {
+    OcclusionBuffer single;
+    OcclusionBuffer banded;
+    single.begin(make_view_projection());
+    banded.begin(make_view_projection());
+    add_wall(single);
+    add_wall(banded);
+    single.render(1);
+    banded.render(7);
+
+    for (uint32_t y = 0; y < single.get_height(); y++) {
+        for (uint32_t x = 0; x < single.get_width(); x++) {
+            REQUIRE(single.get_depth(x, y) == banded.get_depth(x, y));
+        }
+    }
+}
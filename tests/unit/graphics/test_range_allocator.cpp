@@ -0,0 +1,57 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include <catch2/catch_test_macros.hpp>
+
+#include "hellfire/graphics/geometry/RangeAllocator.h"
+
+using namespace hellfire;
+
+TEST_CASE("Range allocator hands out disjoint ranges", "[geometry][arena]") {
+    RangeAllocator allocator(100);
+
+    const uint32_t a = allocator.allocate(30);
+    const uint32_t b = allocator.allocate(30);
+    const uint32_t c = allocator.allocate(40);
+
+    REQUIRE(a == 0);
+    REQUIRE(b == 30);
+    REQUIRE(c == 60);
+    REQUIRE(allocator.get_used() == 100);
+    REQUIRE(allocator.allocate(1) == RangeAllocator::INVALID_OFFSET);
+    REQUIRE(allocator.allocate(0) == RangeAllocator::INVALID_OFFSET);
+}
+
+TEST_CASE("Range allocator reuses and merges freed ranges", "[geometry][arena]") {
+    RangeAllocator allocator(100);
+    const uint32_t a = allocator.allocate(25);
+    const uint32_t b = allocator.allocate(25);
+    const uint32_t c = allocator.allocate(25);
+    allocator.allocate(25);
+
+    allocator.free(a, 25);
+    allocator.free(c, 25);
+    REQUIRE(allocator.get_free_block_count() == 2);
+
+    // Neither hole fits 50 until b is freed and all three merge
+    REQUIRE(allocator.allocate(50) == RangeAllocator::INVALID_OFFSET);
+    allocator.free(b, 25);
+    REQUIRE(allocator.get_free_block_count() == 1);
+    REQUIRE(allocator.allocate(75) == 0);
+    REQUIRE(allocator.get_used() == 100);
+}
+
+TEST_CASE("Growing a range allocator appends free space", "[geometry][arena]") {
+    RangeAllocator allocator(10);
+    const uint32_t a = allocator.allocate(6);
+    REQUIRE(allocator.allocate(10) == RangeAllocator::INVALID_OFFSET);
+
+    allocator.grow(20);
+    REQUIRE(allocator.get_capacity() == 20);
+    REQUIRE(allocator.get_free_block_count() == 1); // Old tail merged with the new space
+    REQUIRE(allocator.allocate(14) == 6);
+
+    allocator.free(a, 6);
+    REQUIRE(allocator.get_used() == 14);
+    REQUIRE(allocator.allocate(6) == 0);
+}
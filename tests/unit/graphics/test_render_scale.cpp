@@ -0,0 +1,82 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+
+#include "hellfire/graphics/renderer/RenderScale.h"
+
+using namespace hellfire;
+
+namespace {
+    /// Feed one adjustment interval of the same frame time
+    float run_interval(RenderScaleController &controller, const float gpu_frame_ms,
+                       const RenderScaleSettings &settings) {
+        float scale = controller.get_scale();
+        for (uint32_t i = 0; i < RenderScaleController::ADJUST_INTERVAL; i++) {
+            scale = controller.update(gpu_frame_ms, settings);
+        }
+        return scale;
+    }
+
+    bool is_whole_step(const float scale) {
+        const float steps = scale / RenderScaleController::SCALE_STEP;
+        return std::abs(steps - std::round(steps)) < 1e-3f;
+    }
+}
+
+TEST_CASE("Render scale only changes once per adjustment interval", "[render_scale]") {
+    RenderScaleSettings settings;
+    RenderScaleController controller;
+
+    for (uint32_t i = 0; i + 1 < RenderScaleController::ADJUST_INTERVAL; i++) {
+        REQUIRE(controller.update(40.0f, settings) == 1.0f);
+    }
+    REQUIRE(controller.update(40.0f, settings) < 1.0f);
+}
+
+TEST_CASE("Render scale drops under load and recovers when the GPU has time to spare", "[render_scale]") {
+    RenderScaleSettings settings;
+    settings.target_frame_ms = 16.0f;
+    RenderScaleController controller;
+
+    const float lowered = run_interval(controller, 32.0f, settings);
+    REQUIRE(lowered < 1.0f);
+    REQUIRE(lowered >= settings.min_scale);
+    REQUIRE(is_whole_step(lowered));
+
+    // Inside the band between the headroom and the target nothing moves
+    REQUIRE(run_interval(controller, 15.0f, settings) == lowered);
+
+    REQUIRE(run_interval(controller, 4.0f, settings) > lowered);
+    for (int i = 0; i < 10; i++) run_interval(controller, 4.0f, settings);
+    REQUIRE(std::abs(controller.get_scale() - settings.max_scale) < 1e-6f);
+}
+
+TEST_CASE("Render scale stays within the configured range", "[render_scale]") {
+    RenderScaleSettings settings;
+    settings.min_scale = 0.6f;
+    settings.max_scale = 0.9f;
+    RenderScaleController controller;
+
+    REQUIRE(controller.update(1.0f, settings) == 0.9f);
+    for (int i = 0; i < 10; i++) run_interval(controller, 500.0f, settings);
+    REQUIRE(std::abs(controller.get_scale() - 0.6f) < 1e-6f);
+}
+
+TEST_CASE("Render scale settles under the target frame time", "[render_scale]") {
+    RenderScaleSettings settings;
+    settings.target_frame_ms = 16.6f;
+    RenderScaleController controller;
+
+    // Cost proportional to the pixel count, 40 ms at full resolution
+    const auto frame_ms = [](const float scale) { return 40.0f * scale * scale; };
+    for (int i = 0; i < 20; i++) run_interval(controller, frame_ms(controller.get_scale()), settings);
+    const float settled = controller.get_scale();
+
+    REQUIRE(frame_ms(settled) <= settings.target_frame_ms);
+    REQUIRE(frame_ms(settled) >= settings.target_frame_ms * (1.0f - RenderScaleController::HEADROOM));
+    for (int i = 0; i < 20; i++) run_interval(controller, frame_ms(controller.get_scale()), settings);
+    REQUIRE(controller.get_scale() == settled);
+}
@@ -0,0 +1,68 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <random>
+
+#include "hellfire/graphics/renderer/RenderSortKey.h"
+
+using namespace hellfire;
+
+TEST_CASE("Radix sort orders render sort entries by key", "[renderer][sorting]") {
+    std::mt19937_64 rng(1234);
+    std::vector<RenderSortEntry> entries;
+    for (uint32_t i = 0; i < 1000; i++) {
+        entries.push_back({rng(), i});
+    }
+
+    auto expected = entries;
+    std::ranges::stable_sort(expected, {}, &RenderSortEntry::key);
+
+    std::vector<RenderSortEntry> scratch;
+    radix_sort(entries, scratch);
+
+    REQUIRE(entries.size() == expected.size());
+    for (size_t i = 0; i < entries.size(); i++) {
+        REQUIRE(entries[i].key == expected[i].key);
+        REQUIRE(entries[i].index == expected[i].index);
+    }
+}
+
+TEST_CASE("Radix sort is stable for equal keys", "[renderer][sorting]") {
+    std::vector<RenderSortEntry> entries = {{5, 0}, {1, 1}, {5, 2}, {1, 3}};
+    std::vector<RenderSortEntry> scratch;
+    radix_sort(entries, scratch);
+
+    REQUIRE(entries[0].index == 1);
+    REQUIRE(entries[1].index == 3);
+    REQUIRE(entries[2].index == 0);
+    REQUIRE(entries[3].index == 2);
+}
+
+TEST_CASE("Opaque keys group by state before depth", "[renderer][sorting]") {
+    const uint64_t near_other_shader = RenderSortKey::make_opaque(2, 1, 1, 1.0f);
+    const uint64_t far_same_shader = RenderSortKey::make_opaque(1, 1, 1, 500.0f);
+    const uint64_t near_same_shader = RenderSortKey::make_opaque(1, 1, 1, 2.0f);
+
+    REQUIRE(far_same_shader < near_other_shader);
+    REQUIRE(near_same_shader < far_same_shader);
+    REQUIRE(RenderSortKey::get_pass(near_same_shader) == RenderSortKey::PASS_OPAQUE);
+}
+
+TEST_CASE("Transparent keys sort back to front after all opaque keys", "[renderer][sorting]") {
+    const uint64_t opaque = RenderSortKey::make_opaque(RenderSortKey::SHADER_MASK, 0xFFFF, 0xFFFF, 1e30f);
+    const uint64_t far = RenderSortKey::make_transparent(1, 1, 1, 100.0f);
+    const uint64_t near = RenderSortKey::make_transparent(1, 1, 1, 10.0f);
+
+    REQUIRE(opaque < far);
+    REQUIRE(far < near);
+    REQUIRE(RenderSortKey::get_pass(far) == RenderSortKey::PASS_TRANSPARENT);
+}
+
+TEST_CASE("Depth quantization is monotonic", "[renderer][sorting]") {
+    REQUIRE(RenderSortKey::quantize_depth(-5.0f) == RenderSortKey::quantize_depth(0.0f));
+    REQUIRE(RenderSortKey::quantize_depth(1.0f) < RenderSortKey::quantize_depth(2.0f));
+    REQUIRE(RenderSortKey::quantize_depth(10.0f) < RenderSortKey::quantize_depth(1000.0f));
+}
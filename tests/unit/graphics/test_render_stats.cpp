@@ -0,0 +1,33 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+#include "hellfire/graphics/renderer/RenderStats.h"
+
+using namespace hellfire;
+
+TEST_CASE("Render stats CSV rows line up with the header", "[render_stats]") {
+    RenderStats stats;
+    stats.draw_calls = 12;
+    stats.instanced_draw_calls = 3;
+    stats.triangles = 5000000000ull;
+    stats.buffer_bytes_uploaded = 4096;
+
+    std::ostringstream header_stream;
+    RenderStats::write_csv_header(header_stream);
+    std::ostringstream row_stream;
+    stats.write_csv_row(row_stream, 42);
+    const std::string header = header_stream.str();
+    const std::string row = row_stream.str();
+
+    REQUIRE(header.rfind("frame,draw_calls,instanced_draw_calls,triangles,", 0) == 0);
+    REQUIRE(header.back() == '\n');
+    REQUIRE(row.rfind("42,12,3,5000000000,", 0) == 0);
+    REQUIRE(row.substr(row.size() - 6) == ",4096\n");
+    REQUIRE(std::count(header.begin(), header.end(), ',') == std::count(row.begin(), row.end(), ','));
+}
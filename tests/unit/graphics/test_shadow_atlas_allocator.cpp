@@ -0,0 +1,67 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include "hellfire/graphics/renderer/ShadowAtlasAllocator.h"
+
+using namespace hellfire;
+
+namespace {
+    bool overlaps(const ShadowAtlasTile &a, const ShadowAtlasTile &b) {
+        return a.x < b.x + b.size && b.x < a.x + a.size && a.y < b.y + b.size && b.y < a.y + a.size;
+    }
+}
+
+TEST_CASE("Shadow atlas hands out disjoint tiles until it is full", "[shadows]") {
+    ShadowAtlasAllocator allocator(1024, 128);
+
+    std::vector<ShadowAtlasTile> tiles;
+    tiles.push_back(allocator.allocate(512));
+    for (int i = 0; i < 4; i++) tiles.push_back(allocator.allocate(256));
+    for (int i = 0; i < 10; i++) tiles.push_back(allocator.allocate(200)); // Rounded up to 256
+
+    // 512² + 4 * 256² fill half of the atlas, the other half holds 8 more 256² tiles
+    REQUIRE(tiles[0].size == 512);
+    for (size_t i = 0; i < 13; i++) {
+        REQUIRE(tiles[i].is_valid());
+    }
+    for (size_t i = 13; i < tiles.size(); i++) {
+        REQUIRE_FALSE(tiles[i].is_valid());
+    }
+    REQUIRE(allocator.get_used_texels() == 1024u * 1024u);
+
+    for (size_t i = 0; i < 13; i++) {
+        REQUIRE(tiles[i].x + tiles[i].size <= 1024);
+        REQUIRE(tiles[i].y + tiles[i].size <= 1024);
+        for (size_t j = i + 1; j < 13; j++) {
+            REQUIRE_FALSE(overlaps(tiles[i], tiles[j]));
+        }
+    }
+}
+
+TEST_CASE("Freed shadow atlas tiles merge back into larger ones", "[shadows]") {
+    ShadowAtlasAllocator allocator(1024, 128);
+
+    std::vector<ShadowAtlasTile> small_tiles;
+    for (int i = 0; i < 16; i++) small_tiles.push_back(allocator.allocate(256));
+    REQUIRE_FALSE(allocator.allocate(128).is_valid());
+
+    for (const ShadowAtlasTile &tile: small_tiles) allocator.free(tile);
+    REQUIRE(allocator.get_used_texels() == 0);
+
+    const ShadowAtlasTile whole = allocator.allocate(1024);
+    REQUIRE(whole.is_valid());
+    REQUIRE(whole.x == 0);
+    REQUIRE(whole.y == 0);
+}
+
+TEST_CASE("Shadow atlas rejects tiles it can never hold", "[shadows]") {
+    ShadowAtlasAllocator allocator(512, 128);
+
+    REQUIRE_FALSE(allocator.allocate(0).is_valid());
+    REQUIRE_FALSE(allocator.allocate(1024).is_valid());
+    REQUIRE(allocator.allocate(1).size == 128);
+}
@@ -0,0 +1,97 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "hellfire/graphics/renderer/ShadowCascades.h"
+
+using namespace hellfire;
+
+namespace {
+    constexpr float NEAR_PLANE = 0.1f;
+    constexpr float FAR_PLANE = 100.0f;
+    constexpr uint32_t RESOLUTION = 1024;
+
+    glm::mat4 make_camera(const glm::vec3 &position, const glm::vec3 &forward) {
+        const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, NEAR_PLANE, FAR_PLANE);
+        return projection * glm::lookAt(position, position + forward, glm::vec3(0.0f, 1.0f, 0.0f));
+    }
+
+    ShadowCascade fit_middle_cascade(const glm::mat4 &camera) {
+        return ShadowCascades::fit(camera, NEAR_PLANE, FAR_PLANE, 10.0f, 30.0f,
+                                   glm::vec3(-0.3f, -1.0f, -0.2f), RESOLUTION, 20.0f);
+    }
+}
+
+TEST_CASE("Cascade splits grow towards the far plane", "[shadows]") {
+    float splits[4];
+
+    SECTION("practical splits") {
+        ShadowCascades::compute_splits(NEAR_PLANE, FAR_PLANE, 4, 0.75f, splits);
+        for (int i = 1; i < 4; i++) {
+            REQUIRE(splits[i] > splits[i - 1]);
+        }
+        REQUIRE(splits[3] == FAR_PLANE);
+    }
+    SECTION("lambda 0 gives uniform splits") {
+        ShadowCascades::compute_splits(1.0f, 101.0f, 4, 0.0f, splits);
+        REQUIRE(std::abs(splits[0] - 26.0f) < 1e-3f);
+        REQUIRE(std::abs(splits[1] - 51.0f) < 1e-3f);
+    }
+}
+
+TEST_CASE("A cascade contains its whole frustum slice", "[shadows]") {
+    const glm::mat4 camera = make_camera(glm::vec3(3.0f, 2.0f, 5.0f), glm::vec3(0.4f, -0.1f, -1.0f));
+    const ShadowCascade cascade = fit_middle_cascade(camera);
+
+    const glm::mat4 inverse_camera = glm::inverse(camera);
+    for (int i = 0; i < 8; i++) {
+        // Corners of the camera frustum between the split distances, found by walking the corner rays
+        const glm::vec4 near_ndc((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, -1.0f, 1.0f);
+        const glm::vec4 far_ndc(near_ndc.x, near_ndc.y, 1.0f, 1.0f);
+        const glm::vec4 near_world = inverse_camera * near_ndc;
+        const glm::vec4 far_world = inverse_camera * far_ndc;
+        const glm::vec3 ray_start = glm::vec3(near_world) / near_world.w;
+        const glm::vec3 ray_end = glm::vec3(far_world) / far_world.w;
+        const float depth = (i & 4) ? 30.0f : 10.0f;
+        const glm::vec3 corner = ray_start + (ray_end - ray_start) * ((depth - NEAR_PLANE) / (FAR_PLANE - NEAR_PLANE));
+
+        const glm::vec4 light_clip = cascade.view_projection * glm::vec4(corner, 1.0f);
+        REQUIRE(std::abs(light_clip.x) <= 1.0f);
+        REQUIRE(std::abs(light_clip.y) <= 1.0f);
+        REQUIRE(light_clip.z >= -1.0f);
+        REQUIRE(light_clip.z <= 1.0f);
+    }
+}
+
+TEST_CASE("Moving the camera shifts a cascade by whole texels", "[shadows]") {
+    const glm::vec3 forward(0.0f, -0.2f, -1.0f);
+    const ShadowCascade before = fit_middle_cascade(make_camera(glm::vec3(0.0f, 2.0f, 0.0f), forward));
+    const ShadowCascade after = fit_middle_cascade(make_camera(glm::vec3(0.37f, 2.0f, -1.13f), forward));
+
+    REQUIRE(before.radius == after.radius);
+
+    // The same world point has to land at the same sub-texel position in both maps
+    const glm::vec4 point(4.2f, 0.5f, -17.0f, 1.0f);
+    const glm::vec2 texels_before = glm::vec2(before.view_projection * point) * (RESOLUTION * 0.5f);
+    const glm::vec2 texels_after = glm::vec2(after.view_projection * point) * (RESOLUTION * 0.5f);
+    const glm::vec2 shift = texels_after - texels_before;
+    REQUIRE(std::abs(shift.x - std::round(shift.x)) < 1e-2f);
+    REQUIRE(std::abs(shift.y - std::round(shift.y)) < 1e-2f);
+}
+
+TEST_CASE("A cascade only changes once the camera crosses a whole texel", "[shadows]") {
+    const glm::vec3 forward(0.0f, -0.2f, -1.0f);
+    const ShadowCascade before = fit_middle_cascade(make_camera(glm::vec3(0.0f, 2.0f, 0.0f), forward));
+    // Texels of the middle cascade are several centimeters wide
+    const ShadowCascade nudged = fit_middle_cascade(make_camera(glm::vec3(0.001f, 2.0f, 0.0f), forward));
+    const ShadowCascade moved = fit_middle_cascade(make_camera(glm::vec3(3.0f, 2.0f, -2.0f), forward));
+
+    REQUIRE(nudged.texel_offset == before.texel_offset);
+    REQUIRE(nudged.view_projection == before.view_projection);
+    REQUIRE(moved.texel_offset != before.texel_offset);
+}
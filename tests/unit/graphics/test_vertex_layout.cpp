@@ -0,0 +1,113 @@
+//
+// Created by denzel on 17/10/2026.
+//
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstring>
+
+#include <glm/gtc/packing.hpp>
+
+#include "hellfire/graphics/VertexLayout.h"
+
+using namespace hellfire;
+
+namespace {
+    template<typename T>
+    T read(const std::vector<uint8_t> &data, const size_t offset) {
+        T value;
+        std::memcpy(&value, data.data() + offset, sizeof(T));
+        return value;
+    }
+
+    /// Same conversion the vertex fetch does for a normalized GL_INT_2_10_10_10_REV attribute
+    glm::vec4 unpack_snorm_10_10_10_2(const uint32_t packed) {
+        const auto field = [&](const int shift, const int bits) {
+            const int32_t value = static_cast<int32_t>(packed << (32 - shift - bits)) >> (32 - bits);
+            return std::max(static_cast<float>(value) / static_cast<float>((1 << (bits - 1)) - 1), -1.0f);
+        };
+        return {field(0, 10), field(10, 10), field(20, 10), field(30, 2)};
+    }
+
+    Vertex make_vertex(const glm::vec3 &position) {
+        Vertex vertex{};
+        vertex.position = position;
+        vertex.normal = glm::normalize(glm::vec3(0.3f, 0.8f, -0.5f));
+        vertex.color = glm::vec3(0.25f, 0.5f, 1.0f);
+        vertex.texCoords = glm::vec2(0.125f, 3.5f);
+        vertex.tangent = glm::normalize(glm::cross(vertex.normal, glm::vec3(0.0f, 0.0f, 1.0f)));
+        // Mirrored UVs: bitangent opposite to cross(normal, tangent)
+        vertex.bitangent = -glm::cross(vertex.normal, vertex.tangent);
+        return vertex;
+    }
+}
+
+TEST_CASE("Vertex layouts have the expected strides", "[vertex_layout]") {
+    REQUIRE(VertexLayout::full().get_stride() == sizeof(Vertex));
+    REQUIRE(VertexLayout::compact().get_stride() == 24);
+    REQUIRE(VertexLayout::compact(false).get_stride() == 20);
+
+    // Every attribute is 4 byte aligned and fits the stride
+    for (const VertexLayout layout: {VertexLayout::full(), VertexLayout::compact(), VertexLayout::compact(false)}) {
+        VertexAttributeFormat formats[VertexLayout::MAX_ATTRIBUTES];
+        const uint32_t count = layout.get_attributes(formats);
+        for (uint32_t i = 0; i < count; i++) {
+            REQUIRE(formats[i].offset % 4 == 0);
+            REQUIRE(formats[i].offset < layout.get_stride());
+        }
+    }
+}
+
+TEST_CASE("The full layout is a plain copy of the vertices", "[vertex_layout]") {
+    const std::vector<Vertex> vertices = {make_vertex(glm::vec3(1.0f, 2.0f, 3.0f))};
+    const std::vector<uint8_t> data = VertexLayout::full().encode(vertices, AABB{});
+
+    REQUIRE(data.size() == sizeof(Vertex));
+    REQUIRE(std::memcmp(data.data(), vertices.data(), sizeof(Vertex)) == 0);
+    REQUIRE(VertexLayout::full().get_position_decode(AABB{}) == glm::mat4(1.0f));
+}
+
+TEST_CASE("Compact vertices decode close to the originals", "[vertex_layout]") {
+    const std::vector<Vertex> vertices = {
+        make_vertex(glm::vec3(-2.0f, 0.0f, 1.0f)), make_vertex(glm::vec3(6.0f, 1.5f, 3.0f)),
+        make_vertex(glm::vec3(0.7f, 0.3f, 2.2f))
+    };
+    AABB bounds;
+    for (const Vertex &vertex: vertices) bounds.expand(vertex.position);
+
+    const VertexLayout layout = VertexLayout::compact();
+    const std::vector<uint8_t> data = layout.encode(vertices, bounds);
+    REQUIRE(data.size() == vertices.size() * layout.get_stride());
+
+    VertexAttributeFormat formats[VertexLayout::MAX_ATTRIBUTES];
+    const uint32_t count = layout.get_attributes(formats);
+    REQUIRE(count == 5);
+    const glm::mat4 decode = layout.get_position_decode(bounds);
+
+    for (size_t i = 0; i < vertices.size(); i++) {
+        const size_t base = i * layout.get_stride();
+        const Vertex &vertex = vertices[i];
+
+        // Position: unorm16 in [0, 1], the decode matrix maps it back
+        glm::vec3 unit;
+        for (int axis = 0; axis < 3; axis++) {
+            unit[axis] = static_cast<float>(read<uint16_t>(data, base + formats[0].offset + axis * 2)) / 65535.0f;
+        }
+        const glm::vec3 position = glm::vec3(decode * glm::vec4(unit, 1.0f));
+        REQUIRE(glm::length(position - vertex.position) < 1e-3f);
+
+        const glm::vec4 normal = unpack_snorm_10_10_10_2(read<uint32_t>(data, base + formats[1].offset));
+        REQUIRE(glm::dot(glm::normalize(glm::vec3(normal)), vertex.normal) > 0.9999f);
+
+        REQUIRE(read<uint8_t>(data, base + formats[2].offset) == 64);
+        REQUIRE(read<uint8_t>(data, base + formats[2].offset + 2) == 255);
+
+        REQUIRE(glm::unpackHalf1x16(read<uint16_t>(data, base + formats[3].offset)) == 0.125f);
+        REQUIRE(glm::unpackHalf1x16(read<uint16_t>(data, base + formats[3].offset + 2)) == 3.5f);
+
+        // Tangent keeps its direction, w carries the mirrored bitangent
+        const glm::vec4 tangent = unpack_snorm_10_10_10_2(read<uint32_t>(data, base + formats[4].offset));
+        REQUIRE(glm::dot(glm::normalize(glm::vec3(tangent)), vertex.tangent) > 0.9999f);
+        REQUIRE(tangent.w == -1.0f);
+    }
+}
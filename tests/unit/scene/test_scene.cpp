@@ -61,3 +61,39 @@ TEST_CASE("Scene updates world matrices correctly") {
 
 TEST_CASE("Scene can have complex hierarchies") {
 }
+
+namespace {
+    struct TagComponent : hellfire::Component {};
+
+    struct CountingObserver : hellfire::SceneObserver {
+        int added = 0;
+        int removed = 0;
+        int destroyed = 0;
+
+        void on_component_added(hellfire::Entity &, hellfire::Component &) override { added++; }
+        void on_component_removed(hellfire::Entity &, hellfire::Component &) override { removed++; }
+        void on_entity_destroyed(hellfire::Entity &) override { destroyed++; }
+    };
+}
+
+TEST_CASE("Scene observers are notified of component and entity changes") {
+    hellfire::Scene test_scene("Test Scene");
+    CountingObserver observer;
+    test_scene.add_observer(&observer);
+
+    const hellfire::EntityID entity_id = test_scene.create_entity("Observed");
+    REQUIRE(observer.added == 1); // The transform every entity gets
+
+    test_scene.get_entity(entity_id)->add_component<TagComponent>();
+    REQUIRE(observer.added == 2);
+
+    test_scene.get_entity(entity_id)->remove_component<TagComponent>();
+    REQUIRE(observer.removed == 1);
+
+    test_scene.destroy_entity(entity_id);
+    REQUIRE(observer.destroyed == 1);
+
+    test_scene.remove_observer(&observer);
+    test_scene.create_entity("Unobserved");
+    REQUIRE(observer.added == 2);
+}